@@ -2,6 +2,8 @@
 #include <facter/logging/logging.hpp>
 #include <facter/facts/collection.hpp>
 #include <facter/ruby/ruby.hpp>
+#include <facter/util/snapshot.hpp>
+#include <facter/util/timeline.hpp>
 #include <hocon/program_options.hpp>
 #include <leatherman/util/environment.hpp>
 #include <leatherman/util/scope_exit.hpp>
@@ -21,6 +23,7 @@
 #pragma GCC diagnostic pop
 
 #include <iostream>
+#include <iomanip>
 #include <set>
 #include <algorithm>
 #include <iterator>
@@ -103,6 +106,44 @@ void log_queries(set<string> const& queries)
     log(level::info, "requested queries: %1%.", output.str());
 }
 
+void write_memory_report(ostream& stream, collection const& facts)
+{
+    // List the facts using the most memory first
+    auto usage = facts.measure();
+    vector<pair<string, memory_usage>> sorted(usage.begin(), usage.end());
+    sort(sorted.begin(), sorted.end(), [](pair<string, memory_usage> const& first, pair<string, memory_usage> const& second) {
+        return first.second.total() > second.second.total();
+    });
+
+    memory_usage total;
+    stream << "Memory report\n"
+              "=============\n\n";
+    stream << left << setw(40) << "fact" << right << setw(12) << "bytes" << setw(10) << "nodes"
+           << setw(12) << "values" << setw(12) << "strings" << setw(12) << "containers" << "\n";
+    for (auto const& kvp : sorted) {
+        auto const& fact = kvp.second;
+        stream << left << setw(40) << kvp.first << right << setw(12) << fact.total() << setw(10) << fact.nodes
+               << setw(12) << fact.node_bytes << setw(12) << fact.string_bytes << setw(12) << fact.container_bytes << "\n";
+        total += fact;
+    }
+    stream << left << setw(40) << "(total)" << right << setw(12) << total.total() << setw(10) << total.nodes
+           << setw(12) << total.node_bytes << setw(12) << total.string_bytes << setw(12) << total.container_bytes << "\n";
+
+    auto allocations = facts.resolver_allocations();
+    if (allocations.empty()) {
+        stream << "\nHeap allocations by resolver are not available on this platform.\n";
+        return;
+    }
+    vector<pair<string, int64_t>> resolvers(allocations.begin(), allocations.end());
+    sort(resolvers.begin(), resolvers.end(), [](pair<string, int64_t> const& first, pair<string, int64_t> const& second) {
+        return first.second > second.second;
+    });
+    stream << "\n" << left << setw(40) << "resolver" << right << setw(12) << "allocated" << "\n";
+    for (auto const& kvp : resolvers) {
+        stream << left << setw(40) << kvp.first << right << setw(12) << kvp.second << "\n";
+    }
+}
+
 int main(int argc, char **argv)
 {
     try
@@ -131,11 +172,13 @@ int main(int argc, char **argv)
             ("json,j", "Output in JSON format.")
             ("show-legacy", "Show legacy facts when querying all facts.")
             ("log-level,l", po::value<level>()->default_value(level::warning, "warn"), "Set logging level.\nSupported levels are: none, trace, debug, info, warn, error, and fatal.")
+            ("memory-report", "Write a report of the memory used by each fact and resolver to stderr.")
             ("no-color", "Disables color output.")
             ("no-custom-facts", po::bool_switch()->default_value(false), "Disables custom facts.")
             ("no-external-facts", po::bool_switch()->default_value(false), "Disables external facts.")
             ("no-ruby", po::bool_switch()->default_value(false), "Disables loading Ruby, facts requiring Ruby, and custom facts.")
             ("puppet,p", "(Deprecated: use `puppet facts` instead) Load the Puppet libraries, thus allowing Facter to load Puppet-specific facts.")
+            ("timeline", po::value<string>(), "Write a timeline of fact resolution to a file in Chrome trace event format.")
             ("trace", po::bool_switch()->default_value(false), "Enable backtraces for custom facts.")
             ("verbose", po::bool_switch()->default_value(false), "Enable verbose (info) output.")
             ("version,v", "Print the version and exit.")
@@ -145,7 +188,9 @@ int main(int argc, char **argv)
         // Build a list of "hidden" options that are not visible on the command line
         po::options_description hidden_options("");
         hidden_options.add_options()
-            ("query", po::value<vector<string>>());
+            ("query", po::value<vector<string>>())
+            ("record-snapshot", po::value<string>(), "Record the host state read by the built-in facts to a snapshot file.")
+            ("replay-snapshot", po::value<string>(), "Resolve the built-in facts from a snapshot file instead of the host.");
 
         // Create the supported command line options (visible + hidden)
         po::options_description command_line_options;
@@ -168,6 +213,21 @@ int main(int argc, char **argv)
             ("trace", po::value<bool>(), "Enable backtraces for custom facts.")
             ("verbose", po::value<bool>(), "Enable verbose (info) output.");
 
+        // Build a list of options that control how the built-in facts are collected
+        // These can only be set in the "facts" section of the config file and are passed to the fact collection
+        po::options_description fact_options("");
+        fact_options.add_options()
+            ("dhcp-lease-sources", po::value<vector<string>>(), "Sources of DHCP lease information for the networking facts.")
+            ("disks-attributes", po::value<vector<string>>(), "Groups of disk attributes to include in the disks fact.")
+            ("identity-timeout", po::value<vector<string>>(), "Seconds to wait for the user and group lookups of the identity fact.")
+            ("interfaces-exclude", po::value<vector<string>>(), "Interfaces to exclude from the networking facts.")
+            ("interfaces-include", po::value<vector<string>>(), "Interfaces to include in the networking facts.")
+            ("mountpoints-exclude-devices", po::value<vector<string>>(), "Devices whose mountpoints are excluded from the mountpoints fact.")
+            ("mountpoints-exclude-paths", po::value<vector<string>>(), "Paths whose mountpoints are excluded from the mountpoints fact.")
+            ("mountpoints-exclude-types", po::value<vector<string>>(), "File system types excluded from the mountpoints fact.")
+            ("partitions-exclude-devices", po::value<vector<string>>(), "Devices excluded from the partitions fact.")
+            ("tunables", po::value<vector<string>>(), "Kernel tunables to include in the tunables fact.");
+
         po::variables_map vm;
         try {
             po::store(po::command_line_parser(argc, argv).
@@ -188,6 +248,10 @@ int main(int argc, char **argv)
                     auto cli_settings = hocon_conf->get_object("cli")->to_config();
                     po::store(hocon::program_options::parse_hocon<char>(cli_settings, config_file_options, true), vm);
                 }
+                if (hocon_conf->has_path("facts")) {
+                    auto fact_settings = hocon_conf->get_object("facts")->to_config();
+                    po::store(hocon::program_options::parse_hocon<char>(fact_settings, fact_options, true), vm);
+                }
             }
 
             // Check for a help option first before notifying
@@ -223,6 +287,9 @@ int main(int argc, char **argv)
             if (vm.count("puppet") && vm["no-ruby"].as<bool>()) {
                 throw po::error("puppet and no-ruby options conflict: please specify only one.");
             }
+            if (vm.count("record-snapshot") && vm.count("replay-snapshot")) {
+                throw po::error("record-snapshot and replay-snapshot options conflict: please specify only one.");
+            }
         }
         catch (exception& ex) {
             colorize(boost::nowide::cerr, level::error);
@@ -256,6 +323,10 @@ int main(int argc, char **argv)
 
         log_command_line(argc, argv);
 
+        if (vm.count("timeline")) {
+            facter::util::start_timeline(vm["timeline"].as<string>());
+        }
+
         // Initialize Ruby in main
         bool ruby = (!vm["no-ruby"].as<bool>()) && facter::ruby::initialize(vm["trace"].as<bool>());
         leatherman::util::scope_exit ruby_cleanup{[ruby]() {
@@ -287,7 +358,23 @@ int main(int argc, char **argv)
 
         log_queries(queries);
 
+        // Resolve the built-in facts from a recorded host, or record the host for later replay
+        if (vm.count("record-snapshot")) {
+            facter::util::record_snapshot(vm["record-snapshot"].as<string>());
+        } else if (vm.count("replay-snapshot")) {
+            facter::util::replay_snapshot(vm["replay-snapshot"].as<string>());
+        }
+
         collection facts;
+        for (auto const& option : fact_options.options()) {
+            auto const& name = option->long_name();
+            if (vm.count(name)) {
+                facts.set_option(name, vm[name].as<vector<string>>());
+            }
+        }
+        if (vm.count("memory-report")) {
+            facts.enable_memory_accounting();
+        }
         facts.add_default_facts(ruby);
 
         if (!vm["no-external-facts"].as<bool>()) {
@@ -306,6 +393,11 @@ int main(int argc, char **argv)
         // Add the environment facts
         facts.add_environment_facts();
 
+        // Add facts from native plugins in the custom fact directories
+        if (!vm["no-custom-facts"].as<bool>()) {
+            facts.add_plugin_facts(custom_directories);
+        }
+
         if (ruby && !vm["no-custom-facts"].as<bool>()) {
             facter::ruby::load_custom_facts(facts, vm.count("puppet"), custom_directories);
         }
@@ -322,6 +414,14 @@ int main(int argc, char **argv)
         bool strict_errors = vm.count("strict");
         facts.write(boost::nowide::cout, fmt, queries, show_legacy, strict_errors);
         boost::nowide::cout << endl;
+
+        if (vm.count("memory-report")) {
+            write_memory_report(boost::nowide::cerr, facts);
+            boost::nowide::cerr << flush;
+        }
+
+        facter::util::finish_snapshot();
+        facter::util::finish_timeline();
     } catch (locale_error const& e) {
         boost::nowide::cerr << "failed to initialize logging system due to a locale error: " << e.what() << "\n" << endl;
         return 2;  // special error code to indicate we failed harder than normal
@@ -0,0 +1,240 @@
+/**
+ * @file
+ * Declares the C API for embedding libfacter.
+ * All functions are safe to call from C; no C++ exceptions propagate out of them.
+ * Pointers to values returned by this API are owned by the collection and remain valid until the collection is freed
+ * or modified.
+ */
+#pragma once
+
+#include "../export.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An opaque handle to a fact collection.
+ */
+typedef struct facter_collection facter_collection;
+
+/**
+ * An opaque handle to a fact value owned by a collection.
+ */
+typedef struct facter_value facter_value;
+
+/**
+ * The status codes returned by the C API.
+ */
+typedef enum facter_status
+{
+    /**
+     * The operation succeeded.
+     */
+    FACTER_OK = 0,
+    /**
+     * An argument was invalid (e.g. a null pointer).
+     */
+    FACTER_ERROR_INVALID_ARGUMENT = 1,
+    /**
+     * The caller-provided buffer was too small; the required size was returned.
+     */
+    FACTER_ERROR_BUFFER_TOO_SMALL = 2,
+    /**
+     * The operation failed; details are logged.
+     */
+    FACTER_ERROR_FAILED = 3
+} facter_status;
+
+/**
+ * The output formats supported for serialization.
+ */
+typedef enum facter_format
+{
+    /**
+     * Use Ruby "hash" style output.
+     */
+    FACTER_FORMAT_HASH = 0,
+    /**
+     * Use JSON output.
+     */
+    FACTER_FORMAT_JSON = 1,
+    /**
+     * Use YAML output.
+     */
+    FACTER_FORMAT_YAML = 2
+} facter_format;
+
+/**
+ * The types of fact values.
+ */
+typedef enum facter_value_type
+{
+    FACTER_VALUE_STRING = 0,
+    FACTER_VALUE_INTEGER = 1,
+    FACTER_VALUE_BOOLEAN = 2,
+    FACTER_VALUE_DOUBLE = 3,
+    FACTER_VALUE_ARRAY = 4,
+    FACTER_VALUE_MAP = 5,
+    /**
+     * A value of a type not representable by the C API (e.g. a value from a Ruby custom fact).
+     */
+    FACTER_VALUE_OTHER = 6
+} facter_value_type;
+
+/**
+ * The callback used to enumerate facts and elements of arrays and maps.
+ * @param name The fact name or map key; NULL for array elements.
+ * @param value The value; valid only for the lifetime of the collection.
+ * @param context The context pointer given to the enumeration function.
+ * @return Return non-zero to continue enumerating or zero to stop.
+ */
+typedef int (*facter_value_callback)(char const* name, facter_value const* value, void* context);
+
+/**
+ * Creates an empty fact collection.
+ * @return Returns the new collection or NULL on failure. Free it with facter_collection_free.
+ */
+LIBFACTER_EXPORT facter_collection* facter_collection_create(void);
+
+/**
+ * Frees a fact collection and all of its values.
+ * @param facts The collection to free; may be NULL.
+ */
+LIBFACTER_EXPORT void facter_collection_free(facter_collection* facts);
+
+/**
+ * Adds the default (built-in) facts to the collection.
+ * Facts requiring Ruby are not included.
+ * @param facts The collection to add facts to.
+ * @return Returns FACTER_OK on success or an error status.
+ */
+LIBFACTER_EXPORT facter_status facter_collection_add_default_facts(facter_collection* facts);
+
+/**
+ * Adds external facts to the collection.
+ * @param facts The collection to add facts to.
+ * @param directories The directories to search in addition to the default directories; may be NULL if count is 0.
+ * @param count The number of directories.
+ * @return Returns FACTER_OK on success or an error status.
+ */
+LIBFACTER_EXPORT facter_status facter_collection_add_external_facts(facter_collection* facts, char const* const* directories, size_t count);
+
+/**
+ * Resolves every fact in the collection.
+ * @param facts The collection to resolve.
+ * @return Returns FACTER_OK on success or an error status.
+ */
+LIBFACTER_EXPORT facter_status facter_collection_resolve(facter_collection* facts);
+
+/**
+ * Enables concurrent access to the collection.
+ * Once enabled, the query, each and write functions may be called on the collection from multiple threads.
+ * Each fact is resolved at most once; lookups of facts that are already resolved do not lock.
+ * @param facts The collection to enable concurrent access for.
+ * @return Returns FACTER_OK on success or an error status.
+ */
+LIBFACTER_EXPORT facter_status facter_collection_enable_concurrency(facter_collection* facts);
+
+/**
+ * Queries the collection, resolving only the facts needed to answer the query.
+ * @param facts The collection to query.
+ * @param query The query (e.g. "os.family").
+ * @return Returns the value or NULL if the query produced no value.
+ */
+LIBFACTER_EXPORT facter_value const* facter_collection_query(facter_collection* facts, char const* query);
+
+/**
+ * Enumerates the facts in the collection, resolving them if necessary.
+ * @param facts The collection to enumerate.
+ * @param callback The callback to call for each fact.
+ * @param context The context pointer passed to the callback.
+ * @return Returns FACTER_OK on success or an error status.
+ */
+LIBFACTER_EXPORT facter_status facter_collection_each(facter_collection* facts, facter_value_callback callback, void* context);
+
+/**
+ * Serializes facts into a caller-provided buffer.
+ * The output is NUL-terminated.  If the buffer is too small, nothing is written, *size is set to the required size
+ * (including the terminator) and FACTER_ERROR_BUFFER_TOO_SMALL is returned.
+ * @param facts The collection to serialize.
+ * @param format The output format.
+ * @param queries The queries to output or NULL to output all facts.
+ * @param query_count The number of queries.
+ * @param buffer The buffer to write to; may be NULL to determine the required size.
+ * @param size On input, the size of the buffer; on output, the number of bytes required including the terminator.
+ * @return Returns FACTER_OK on success or an error status.
+ */
+LIBFACTER_EXPORT facter_status facter_collection_write(
+    facter_collection* facts,
+    facter_format format,
+    char const* const* queries,
+    size_t query_count,
+    char* buffer,
+    size_t* size);
+
+/**
+ * Gets the type of a value.
+ * @param value The value.
+ * @return Returns the type of the value.
+ */
+LIBFACTER_EXPORT facter_value_type facter_value_get_type(facter_value const* value);
+
+/**
+ * Gets a string value without copying.
+ * @param value The value; must be of type FACTER_VALUE_STRING.
+ * @param length Set to the length of the string, in bytes; may be NULL.
+ * @return Returns a pointer to the NUL-terminated string owned by the value or NULL if not a string.
+ */
+LIBFACTER_EXPORT char const* facter_value_get_string(facter_value const* value, size_t* length);
+
+/**
+ * Gets an integer value.
+ * @param value The value; must be of type FACTER_VALUE_INTEGER.
+ * @return Returns the integer or 0 if not an integer.
+ */
+LIBFACTER_EXPORT int64_t facter_value_get_integer(facter_value const* value);
+
+/**
+ * Gets a boolean value.
+ * @param value The value; must be of type FACTER_VALUE_BOOLEAN.
+ * @return Returns non-zero for true or zero for false (or if not a boolean).
+ */
+LIBFACTER_EXPORT int facter_value_get_boolean(facter_value const* value);
+
+/**
+ * Gets a double value.
+ * @param value The value; must be of type FACTER_VALUE_DOUBLE.
+ * @return Returns the double or 0 if not a double.
+ */
+LIBFACTER_EXPORT double facter_value_get_double(facter_value const* value);
+
+/**
+ * Gets the number of elements in an array or map value.
+ * @param value The value.
+ * @return Returns the number of elements or 0 if the value is not an array or map.
+ */
+LIBFACTER_EXPORT size_t facter_value_get_size(facter_value const* value);
+
+/**
+ * Gets an element of a map value by key.
+ * @param value The map value.
+ * @param name The key of the element.
+ * @return Returns the element or NULL if not found or the value is not a map.
+ */
+LIBFACTER_EXPORT facter_value const* facter_value_get_element(facter_value const* value, char const* name);
+
+/**
+ * Enumerates the elements of an array or map value.
+ * @param value The array or map value.
+ * @param callback The callback to call for each element; the name is NULL for array elements.
+ * @param context The context pointer passed to the callback.
+ * @return Returns FACTER_OK on success or FACTER_ERROR_INVALID_ARGUMENT if the value is not an array or map.
+ */
+LIBFACTER_EXPORT facter_status facter_value_each(facter_value const* value, facter_value_callback callback, void* context);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -15,9 +15,16 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <cstdint>
 #include <stdexcept>
 #include <iostream>
 
+namespace leatherman { namespace dynamic_library {
+
+    struct dynamic_library;
+
+}}  // namespace leatherman::dynamic_library
+
 namespace facter { namespace facts {
 
     /**
@@ -107,6 +114,14 @@ namespace facter { namespace facts {
          */
         void add_external_facts(std::vector<std::string> const& directories = {});
 
+        /**
+         * Adds facts from native fact plugins.
+         * Each shared library in the given directories that exports the plugin registration function
+         * (see plugin.hpp) is loaded and asked to add its resolvers to the collection.
+         * @param directories The directories to search for native fact plugins.
+         */
+        void add_plugin_facts(std::vector<std::string> const& directories);
+
         /**
          * Adds facts defined via "FACTER_xyz" environment variables.
          * @param callback The callback that is called with the name of each fact added from the environment.
@@ -166,9 +181,7 @@ namespace facter { namespace facts {
         template <typename T = value>
         T const* get_resolved(std::string const& name) const
         {
-            // Lookup the fact without resolving
-            auto it = _facts.find(name);
-            return dynamic_cast<T const*>(it == _facts.end() ? nullptr : it->second.get());
+            return dynamic_cast<T const*>(get_resolved_value(name));
         }
 
         /**
@@ -224,6 +237,60 @@ namespace facter { namespace facts {
          */
         void resolve_facts();
 
+        /**
+         * Enables concurrent access to the fact collection.
+         * Once enabled, the collection may be used from multiple threads at once.
+         * Each resolver still runs at most once: resolution is serialized by a lock, while lookups
+         * of facts that have already been resolved read an immutable snapshot and do not lock.
+         * Values returned by the collection remain valid until the fact is replaced or removed; a replaced or removed
+         * value is kept alive until every lookup or iteration that could still see it has finished.
+         * Facts resolved by Ruby should not be accessed concurrently because the Ruby VM is not thread safe.
+         */
+        void enable_concurrency();
+
+        /**
+         * Determines if concurrent access to the fact collection is enabled.
+         * @return Returns true if concurrent access is enabled or false if not.
+         */
+        bool concurrent() const;
+
+        /**
+         * Sets an option that controls how the built-in resolvers collect facts (e.g. "interfaces-exclude").
+         * Resolvers read options when they resolve, so options should be set before facts are resolved.
+         * @param name The name of the option.
+         * @param values The values of the option.
+         */
+        void set_option(std::string const& name, std::vector<std::string> values);
+
+        /**
+         * Gets an option that controls how the built-in resolvers collect facts.
+         * @param name The name of the option.
+         * @return Returns the values of the option or an empty list if the option is not set.
+         */
+        std::vector<std::string> const& get_option(std::string const& name) const;
+
+        /**
+         * Enables accounting of the heap memory allocated by each resolver.
+         * The allocator's count of allocated bytes is read before and after each resolver resolves its facts.
+         * Accounting is only available on platforms where the allocator reports its usage.
+         */
+        void enable_memory_accounting();
+
+        /**
+         * Gets the heap memory allocated by each resolver since memory accounting was enabled.
+         * Memory allocated by resolvers of facts looked up by a resolver is counted against those resolvers instead.
+         * Memory freed by a resolver counts against its allocations, so a resolver may have negative allocations.
+         * @return Returns a map of resolver name to allocated bytes; empty if accounting is not enabled or not available.
+         */
+        std::map<std::string, int64_t> resolver_allocations() const;
+
+        /**
+         * Measures the approximate memory used by each fact in the collection.
+         * Facts are not resolved before they are measured.
+         * @return Returns a map of fact name to the memory used by the fact's value and its entry in the collection.
+         */
+        std::map<std::string, memory_usage> measure() const;
+
      protected:
         /**
          *  Gets external fact directories for the current platform.
@@ -232,7 +299,15 @@ namespace facter { namespace facts {
         virtual std::vector<std::string> get_external_fact_directories() const;
 
      private:
+        struct snapshot;
+        struct concurrency_state;
+        struct allocation_state;
+
+        value const* get_resolved_value(std::string const& name) const;
+        LIBFACTER_NO_EXPORT void each_fact(std::function<bool(std::string const&, value const*)> const& func) const;
+        LIBFACTER_NO_EXPORT void retire(std::unique_ptr<value> value);
         LIBFACTER_NO_EXPORT void resolve_fact(std::string const& name);
+        LIBFACTER_NO_EXPORT void run_resolver(resolver& res);
         LIBFACTER_NO_EXPORT value const* get_value(std::string const& name);
         LIBFACTER_NO_EXPORT value const* query_value(std::string const& query, bool strict_errors);
         LIBFACTER_NO_EXPORT value const* lookup(value const* value, std::string const& name, bool strict_errors);
@@ -246,10 +321,15 @@ namespace facter { namespace facts {
         LIBFACTER_NO_EXPORT void add_platform_facts();
         LIBFACTER_NO_EXPORT std::vector<std::unique_ptr<external::resolver>> get_external_resolvers();
 
+        // Plugins are declared first so they are unloaded after any resolvers or values they created
+        std::vector<std::unique_ptr<leatherman::dynamic_library::dynamic_library>> _plugins;
         std::map<std::string, std::unique_ptr<value>> _facts;
         std::list<std::shared_ptr<resolver>> _resolvers;
         std::multimap<std::string, std::shared_ptr<resolver>> _resolver_map;
         std::list<std::shared_ptr<resolver>> _pattern_resolvers;
+        std::map<std::string, std::vector<std::string>> _options;
+        std::unique_ptr<concurrency_state> _concurrency;
+        std::unique_ptr<allocation_state> _allocations;
     };
 
 }}  // namespace facter::facts
@@ -0,0 +1,145 @@
+/**
+ * @file
+ * Declares the fact value for strings computed from numbers on demand.
+ */
+#pragma once
+
+#include "value.hpp"
+#include "../export.h"
+#include <cstdint>
+#include <string>
+#include <atomic>
+
+namespace facter { namespace facts {
+
+    /**
+     * Represents a string fact value that is formatted from a number only when needed.
+     * The source number and a formatter are stored; the string is produced on the first lookup or serialization
+     * and then retained.  This is used for human-readable forms of values (e.g. "4.00 GiB") that are also
+     * available as raw numbers.
+     * Until it is formatted, a computed_value is no larger than a string_value holding the formatted string.
+     * This type can be moved but cannot be copied.
+     */
+    struct LIBFACTER_EXPORT computed_value : value
+    {
+        /**
+         * The function type used to format the value.
+         * @param value The source value.
+         * @param total The total the source value is relative to (e.g. for percentages); otherwise 0.
+         * @return Returns the formatted string.
+         */
+        using formatter = std::string (*)(uint64_t value, uint64_t total);
+
+        /**
+         * Constructs a computed_value.
+         * @param format The formatter to produce the string with.
+         * @param value The source value.
+         * @param total The total the source value is relative to, if the formatter uses one.
+         * @param hidden True if the fact is hidden from output by default or false if not.
+         */
+        computed_value(formatter format, uint64_t value, uint64_t total = 0, bool hidden = false);
+
+        /**
+         * Destructor for computed_value.
+         */
+        ~computed_value();
+
+        /**
+         * Moves the given computed_value into this computed_value.
+         * @param other The computed_value to move into this computed_value.
+         */
+        // Visual Studio 12 still doesn't allow default for move constructor.
+        computed_value(computed_value&& other);
+
+        /**
+         * Moves the given computed_value into this computed_value.
+         * @param other The computed_value to move into this computed_value.
+         * @return Returns this computed_value.
+         */
+        // Visual Studio 12 still doesn't allow default for move assignment.
+        computed_value& operator=(computed_value&& other);
+
+        /**
+         * Formats a size in bytes using SI-prefixed units (e.g. "4.05 GiB").
+         * @param value The size in bytes.
+         * @param total Unused.
+         * @return Returns the formatted size.
+         */
+        static std::string size(uint64_t value, uint64_t total);
+
+        /**
+         * Formats an amount used as a percentage of a total (e.g. "41.53%").
+         * @param value The amount used.
+         * @param total The total amount.
+         * @return Returns the formatted percentage.
+         */
+        static std::string percentage(uint64_t value, uint64_t total);
+
+        /**
+         * Formats a frequency in Hz (e.g. "1.24 GHz").
+         * @param value The frequency in Hz.
+         * @param total Unused.
+         * @return Returns the formatted frequency.
+         */
+        static std::string frequency(uint64_t value, uint64_t total);
+
+        /**
+         * Gets the source value.
+         * @return Returns the source value.
+         */
+        uint64_t source() const;
+
+        /**
+         * Gets the formatted string, formatting it if it has not yet been formatted.
+         * This is safe to call from multiple threads.
+         * @return Returns the formatted string.
+         */
+        std::string const& value() const;
+
+        /**
+         * Converts the value to a JSON value.
+         * @param allocator The allocator to use for creating the JSON value.
+         * @param value The returned JSON value.
+         */
+        virtual void to_json(json_allocator& allocator, json_value& value) const override;
+
+        /**
+          * Writes the value to the given stream.
+          * @param os The stream to write to.
+          * @param quoted True if string values should be quoted or false if not.
+          * @param level The current indentation level.
+          * @returns Returns the stream being written to.
+          */
+        virtual std::ostream& write(std::ostream& os, bool quoted = true, unsigned int level = 1) const override;
+
+        /**
+          * Writes the value to the given YAML emitter.
+          * @param emitter The YAML emitter to write to.
+          * @returns Returns the given YAML emitter.
+          */
+        virtual YAML::Emitter& write(YAML::Emitter& emitter) const override;
+
+        /**
+          * Writes the value to the given YAML writer.
+          * @param writer The YAML writer to write to.
+          * @returns Returns the given YAML writer.
+          */
+        virtual yaml_writer& write(yaml_writer& writer) const override;
+
+        /**
+          * Adds the approximate memory used by the value and the values it contains to the given memory usage.
+          * @param usage The memory usage to add to.
+          */
+        virtual void measure(memory_usage& usage) const override;
+
+     private:
+        computed_value(computed_value const&) = delete;
+        computed_value& operator=(computed_value const&) = delete;
+
+        formatter _format;
+        uint64_t _value;
+        uint64_t _total;
+        mutable std::atomic<std::string*> _string;
+    };
+
+}}  // namespace facter::facts
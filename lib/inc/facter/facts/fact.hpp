@@ -518,6 +518,16 @@ namespace facter { namespace facts {
          */
         constexpr static char const* swapencrypted = "swapencrypted";
 
+        /**
+         * The fact for the resource limits of the process's control group.
+         */
+        constexpr static char const* cgroup = "cgroup";
+
+        /**
+         * The fact for the values of the configured kernel tunables.
+         */
+        constexpr static char const* tunables = "tunables";
+
         /**
          * The ZFS version fact.
          */
@@ -120,6 +120,19 @@ namespace facter { namespace facts {
           */
         virtual YAML::Emitter& write(YAML::Emitter& emitter) const override;
 
+        /**
+          * Writes the value to the given YAML writer.
+          * @param writer The YAML writer to write to.
+          * @returns Returns the given YAML writer.
+          */
+        virtual yaml_writer& write(yaml_writer& writer) const override;
+
+        /**
+          * Adds the approximate memory used by the value and the values it contains to the given memory usage.
+          * @param usage The memory usage to add to.
+          */
+        virtual void measure(memory_usage& usage) const override;
+
      private:
         std::map<std::string, std::unique_ptr<value>> _elements;
     };
@@ -0,0 +1,51 @@
+/**
+ * @file
+ * Declares the interface for native fact plugins.
+ *
+ * A native fact plugin is a shared library placed in a custom fact directory.
+ * It exports a C function named by FACTER_PLUGIN_REGISTER_SYMBOL that adds resolvers to the collection:
+ *
+ *     extern "C" FACTER_PLUGIN_EXPORT int facter_plugin_register(unsigned int version, facter::facts::collection* facts)
+ *     {
+ *         if (version != FACTER_PLUGIN_API_VERSION) {
+ *             return 1;
+ *         }
+ *         facts->add(std::make_shared<my_resolver>());
+ *         return 0;
+ *     }
+ *
+ * The library stays loaded for the lifetime of the collection.
+ */
+#pragma once
+
+#include "collection.hpp"
+
+/**
+ * The version of the plugin interface passed to the registration function.
+ * This is incremented whenever the interface changes incompatibly.
+ */
+#define FACTER_PLUGIN_API_VERSION 2u
+
+/**
+ * The name of the registration function a plugin must export.
+ */
+#define FACTER_PLUGIN_REGISTER_SYMBOL "facter_plugin_register"
+
+/**
+ * Marks a plugin's registration function as exported from the plugin library.
+ */
+#if defined(_WIN32)
+#define FACTER_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define FACTER_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C" {
+    /**
+     * The signature of a plugin's registration function.
+     * @param version The plugin interface version of the loading Facter (FACTER_PLUGIN_API_VERSION).
+     * @param facts The collection to add resolvers to.
+     * @return Returns 0 on success or non-zero if the plugin could not register (e.g. unsupported version).
+     */
+    typedef int (*facter_plugin_register_function)(unsigned int version, facter::facts::collection* facts);
+}
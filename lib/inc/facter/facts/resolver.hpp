@@ -9,7 +9,6 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
-#include <boost/regex.hpp>
 
 namespace facter { namespace facts {
 
@@ -105,9 +104,11 @@ namespace facter { namespace facts {
         virtual void resolve(collection& facts) = 0;
 
      private:
+        struct pattern;
+
         std::string _name;
         std::vector<std::string> _names;
-        std::vector<boost::regex> _regexes;
+        std::vector<std::unique_ptr<pattern>> _patterns;
     };
 
 }}  // namespace facter::facts
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "value.hpp"
+#include "yaml_writer.hpp"
 #include "../export.h"
 #include <cstdint>
 #include <string>
@@ -98,6 +99,27 @@ namespace facter { namespace facts {
             return emitter;
         }
 
+        /**
+          * Writes the value to the given YAML writer.
+          * @param writer The YAML writer to write to.
+          * @returns Returns the given YAML writer.
+          */
+        virtual yaml_writer& write(yaml_writer& writer) const override
+        {
+            writer.write(_value);
+            return writer;
+        }
+
+        /**
+          * Adds the approximate memory used by the value to the given memory usage.
+          * @param usage The memory usage to add to.
+          */
+        virtual void measure(memory_usage& usage) const override
+        {
+            ++usage.nodes;
+            usage.node_bytes += sizeof(*this);
+        }
+
      private:
         scalar_value(scalar_value const&) = delete;
         scalar_value& operator=(scalar_value const&) = delete;
@@ -118,6 +140,8 @@ namespace facter { namespace facts {
     // Declare the specializations for YAML output
     template <>
     YAML::Emitter& scalar_value<std::string>::write(YAML::Emitter& emitter) const;
+    template <>
+    yaml_writer& scalar_value<std::string>::write(yaml_writer& writer) const;
 
     // Declare the specializations for stream output
     template <>
@@ -125,6 +149,10 @@ namespace facter { namespace facts {
     template <>
     std::ostream& scalar_value<std::string>::write(std::ostream& os, bool quoted, unsigned int level) const;
 
+    // Declare the specializations for measuring memory
+    template <>
+    void scalar_value<std::string>::measure(memory_usage& usage) const;
+
     // Declare the common instantiations as external; defined in scalar_value.cc
     extern template struct scalar_value<std::string>;
     extern template struct scalar_value<int64_t>;
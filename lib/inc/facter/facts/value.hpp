@@ -32,6 +32,60 @@ extern "C" {
 
 namespace facter { namespace facts {
 
+    struct yaml_writer;
+
+    /**
+     * Represents the approximate memory used by a value and the values it contains.
+     */
+    struct LIBFACTER_EXPORT memory_usage
+    {
+        /**
+         * Constructs an empty memory usage.
+         */
+        memory_usage();
+
+        /**
+         * Stores the number of values.
+         */
+        size_t nodes;
+
+        /**
+         * Stores the bytes used by the value objects themselves.
+         */
+        size_t node_bytes;
+
+        /**
+         * Stores the bytes allocated for string data.
+         */
+        size_t string_bytes;
+
+        /**
+         * Stores the bytes used by the storage of maps and arrays beyond their elements.
+         */
+        size_t container_bytes;
+
+        /**
+         * Gets the total bytes used.
+         * @return Returns the sum of the node, string and container bytes.
+         */
+        size_t total() const;
+
+        /**
+         * Adds the given memory usage to this memory usage.
+         * @param other The memory usage to add.
+         * @return Returns this memory usage.
+         */
+        memory_usage& operator+=(memory_usage const& other);
+
+        /**
+         * Gets the bytes a string has allocated outside of itself.
+         * Strings short enough to be stored within the string object allocate nothing.
+         * @param str The string to measure.
+         * @return Returns the number of bytes allocated for the string's data.
+         */
+        static size_t allocated(std::string const& str);
+    };
+
     /**
      * Typedef for RapidJSON allocator.
      */
@@ -119,6 +173,21 @@ namespace facter { namespace facts {
           */
         virtual YAML::Emitter& write(YAML::Emitter& emitter) const = 0;
 
+        /**
+          * Writes the value to the given YAML writer.
+          * The default implementation writes the value with yaml-cpp's emitter and copies the output to the writer.
+          * @param writer The YAML writer to write to.
+          * @returns Returns the given YAML writer.
+          */
+        virtual yaml_writer& write(yaml_writer& writer) const;
+
+        /**
+          * Adds the approximate memory used by the value and the values it contains to the given memory usage.
+          * The default implementation counts the value but adds no bytes, as the size of a derived value is not known.
+          * @param usage The memory usage to add to.
+          */
+        virtual void measure(memory_usage& usage) const;
+
      private:
         value(value const&) = delete;
         value& operator=(value const&) = delete;
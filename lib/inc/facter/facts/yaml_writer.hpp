@@ -0,0 +1,149 @@
+/**
+ * @file
+ * Declares the YAML writer for fact values.
+ */
+#pragma once
+
+#include "../export.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace facter { namespace facts {
+
+    /**
+     * Writes fact values as block-style YAML.
+     * The output is identical to what yaml-cpp's emitter produces for the same sequence of nodes with its default
+     * settings, including the precision of doubles.
+     * Output is buffered and written to the underlying stream when the buffer fills, when flushed, or when the writer
+     * is destroyed.
+     * This type cannot be copied.
+     */
+    struct LIBFACTER_EXPORT yaml_writer
+    {
+        /**
+         * Constructs a YAML writer.
+         * @param stream The stream to write to.
+         */
+        explicit yaml_writer(std::ostream& stream);
+
+        /**
+         * Destructs the YAML writer and flushes any buffered output.
+         */
+        ~yaml_writer();
+
+        /**
+         * Begins a map.
+         * Each entry in the map is written by calling key followed by writing the entry's value.
+         */
+        void begin_map();
+
+        /**
+         * Ends the current map.
+         */
+        void end_map();
+
+        /**
+         * Begins a sequence.
+         */
+        void begin_sequence();
+
+        /**
+         * Ends the current sequence.
+         */
+        void end_sequence();
+
+        /**
+         * Writes a map key.
+         * @param key The key to write.
+         * @param quoted True to always double-quote the key or false to quote it only if it cannot be written plainly.
+         */
+        void key(std::string const& key, bool quoted = false);
+
+        /**
+         * Writes a string.
+         * @param value The string to write.
+         * @param quoted True to always double-quote the string or false to quote it only if it cannot be written plainly.
+         */
+        void write(std::string const& value, bool quoted = false);
+
+        /**
+         * Writes a string.
+         * @param value The null-terminated string to write.
+         * @param quoted True to always double-quote the string or false to quote it only if it cannot be written plainly.
+         */
+        void write(char const* value, bool quoted = false);
+
+        /**
+         * Writes an integer.
+         * @param value The integer to write.
+         */
+        void write(int64_t value);
+
+        /**
+         * Writes a boolean.
+         * @param value The boolean to write.
+         */
+        void write(bool value);
+
+        /**
+         * Writes a double.
+         * @param value The double to write.
+         */
+        void write(double value);
+
+        /**
+         * Writes a node that was already written by yaml-cpp's emitter.
+         * Used for values that do not write themselves to a YAML writer.
+         * @param yaml The block-style YAML of the node.
+         */
+        void write_emitted(std::string const& yaml);
+
+        /**
+         * Writes a null ("~").
+         */
+        void write_null();
+
+        /**
+         * Writes any buffered output to the underlying stream.
+         */
+        void flush();
+
+     private:
+        yaml_writer(yaml_writer const&) = delete;
+        yaml_writer& operator=(yaml_writer const&) = delete;
+
+        enum class node
+        {
+            scalar,
+            sequence,
+            map
+        };
+
+        struct group
+        {
+            bool map;
+            size_t indent;
+            size_t count;
+            bool long_key;
+        };
+
+        LIBFACTER_NO_EXPORT void prepare(node child);
+        LIBFACTER_NO_EXPORT void begin_group(bool map);
+        LIBFACTER_NO_EXPORT void end_group(bool map);
+        LIBFACTER_NO_EXPORT void started_node();
+        LIBFACTER_NO_EXPORT void write_string(std::string const& value, bool quoted);
+        LIBFACTER_NO_EXPORT void write_scalar(char const* text, size_t length);
+        LIBFACTER_NO_EXPORT void write_double_quoted(std::string const& value);
+        LIBFACTER_NO_EXPORT void indent_to(size_t column);
+        LIBFACTER_NO_EXPORT void put(char c);
+        LIBFACTER_NO_EXPORT void put(char const* text, size_t length);
+
+        std::ostream& _stream;
+        std::string _buffer;
+        size_t _column;
+        std::vector<group> _groups;
+    };
+
+}}  // namespace facter::facts
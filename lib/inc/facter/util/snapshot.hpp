@@ -0,0 +1,47 @@
+/**
+ * @file
+ * Declares the functions for recording and replaying host snapshots.
+ */
+#pragma once
+
+#include "../export.h"
+#include <stdexcept>
+#include <string>
+
+namespace facter { namespace util {
+
+    /**
+     * Thrown when a host snapshot cannot be loaded or saved.
+     */
+    struct LIBFACTER_EXPORT snapshot_exception : std::runtime_error
+    {
+        /**
+         * Constructs a snapshot_exception.
+         * @param message The exception message.
+         */
+        explicit snapshot_exception(std::string const& message);
+    };
+
+    /**
+     * Starts recording a host snapshot.
+     * Every file read, directory listing, path check and command run by the resolvers is recorded until
+     * finish_snapshot is called, which writes the snapshot to the given path.
+     * @param path The path of the snapshot file to write.
+     */
+    LIBFACTER_EXPORT void record_snapshot(std::string const& path);
+
+    /**
+     * Starts replaying a host snapshot.
+     * Until finish_snapshot is called, the resolvers see the recorded host instead of the live one:
+     * files, directories and commands that were not recorded do not exist.
+     * @param path The path of the snapshot file to replay.
+     */
+    LIBFACTER_EXPORT void replay_snapshot(std::string const& path);
+
+    /**
+     * Finishes recording or replaying a host snapshot, writing the snapshot if one was being recorded.
+     * Does nothing if a snapshot is not being recorded or replayed.
+     */
+    LIBFACTER_EXPORT void finish_snapshot();
+
+}}  // namespace facter::util
@@ -60,4 +60,14 @@ namespace facter { namespace util {
      */
     bool needs_quotation(std::string const& str);
 
+    /**
+     * Matches a string against a shell-style wildcard pattern.
+     * In the pattern, '*' matches any sequence of characters (including none) and '?' matches any one character.
+     * All other characters match only themselves.
+     * @param str The string to match.
+     * @param pattern The wildcard pattern.
+     * @return Returns true if the whole string matches the pattern or false if it does not.
+     */
+    bool wildcard_match(std::string const& str, std::string const& pattern);
+
 }}  // namespace facter::util
@@ -0,0 +1,28 @@
+/**
+ * @file
+ * Declares the functions for recording a timeline of a facter run.
+ */
+#pragma once
+
+#include "../export.h"
+#include <string>
+
+namespace facter { namespace util {
+
+    /**
+     * Starts recording a timeline.
+     * Resolvers, fact lookups, external fact files, Ruby fact resolutions and subprocesses are recorded as spans
+     * until finish_timeline is called, which writes them to the given path as Chrome trace event JSON.
+     * The file can be opened in chrome://tracing or Perfetto.
+     * @param path The path of the timeline file to write.
+     */
+    LIBFACTER_EXPORT void start_timeline(std::string const& path);
+
+    /**
+     * Finishes recording a timeline and writes it.
+     * Does nothing if a timeline is not being recorded.
+     * @return Returns true if the timeline was written or false if it could not be written.
+     */
+    LIBFACTER_EXPORT bool finish_timeline();
+
+}}  // namespace facter::util
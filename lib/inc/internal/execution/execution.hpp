@@ -4,11 +4,36 @@
  */
 #pragma once
 
+#include <leatherman/execution/execution.hpp>
+#include <leatherman/util/environment.hpp>
 #include <string>
+#include <vector>
+#include <tuple>
 #include <functional>
 
 namespace facter { namespace execution {
 
+    // Bring in the leatherman types so resolvers can use this namespace as a drop-in replacement
+    using leatherman::execution::execution_options;
+    using leatherman::execution::result;
+    using leatherman::execution::expand_command;
+    using leatherman::execution::command_shell;
+    using leatherman::execution::command_args;
+    using leatherman::execution::execution_exception;
+    using leatherman::execution::execution_failure_exception;
+    using leatherman::execution::child_exit_exception;
+    using leatherman::execution::child_signal_exception;
+    using leatherman::execution::timeout_exception;
+
+    /**
+     * Searches the given paths for an executable file.
+     * Behaves the same as leatherman::execution::which unless a host snapshot is being recorded or replayed.
+     * @param file The file to search for.
+     * @param directories The directories to search.
+     * @return Returns the full path or empty if the file could not be found.
+     */
+    std::string which(std::string const& file, std::vector<std::string> const& directories = leatherman::util::environment::search_paths());
+
     /**
      * Processes stdout and stderror streams of a child process.
      * @param trim True if output should be trimmed or false if not.
@@ -23,4 +48,69 @@ namespace facter { namespace execution {
         std::function<bool(std::string&)> const& stderr_callback,
         std::function<void(std::function<bool(std::string const&)>, std::function<bool(std::string const&)>)> const& read_streams);
 
+    /**
+     * Executes the given program and returns its output.
+     * On POSIX platforms the child is started with posix_spawn (vfork semantics) rather than fork, so the cost of
+     * spawning does not grow with the size of the calling process (e.g. a Puppet agent or JVM with a large heap).
+     * Behaves the same as leatherman::execution::execute otherwise.
+     * While a host snapshot is being recorded the output is recorded, and while one is being replayed the recorded
+     * output is returned without running the program.
+     * @param file The name or path of the program to execute.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.
+     * @return Returns the result of the execution.
+     */
+    result execute(
+        std::string const& file,
+        uint32_t timeout = 0,
+        leatherman::util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program and returns its output.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.
+     * @return Returns the result of the execution.
+     */
+    result execute(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        uint32_t timeout = 0,
+        leatherman::util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program and calls a callback for each line of output.
+     * @param file The name or path of the program to execute.
+     * @param stdout_callback The callback that is called for each line of output on stdout.
+     * @param stderr_callback The callback that is called for each line of output on stderr; if nullptr, stderr is redirected to null.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.
+     * @return Returns true if the execution succeeded or false if it did not.
+     */
+    bool each_line(
+        std::string const& file,
+        std::function<bool(std::string&)> stdout_callback,
+        std::function<bool(std::string&)> stderr_callback = nullptr,
+        uint32_t timeout = 0,
+        leatherman::util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
+
+    /**
+     * Executes the given program and calls a callback for each line of output.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program.
+     * @param stdout_callback The callback that is called for each line of output on stdout.
+     * @param stderr_callback The callback that is called for each line of output on stderr; if nullptr, stderr is redirected to null.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.
+     * @return Returns true if the execution succeeded or false if it did not.
+     */
+    bool each_line(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::function<bool(std::string&)> stdout_callback,
+        std::function<bool(std::string&)> stderr_callback = nullptr,
+        uint32_t timeout = 0,
+        leatherman::util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
+
 }}  // namespace facter::execution
@@ -6,6 +6,8 @@
 
 #include "../posix/networking_resolver.hpp"
 #include <map>
+#include <string>
+#include <vector>
 #include <ifaddrs.h>
 
 namespace facter { namespace facts { namespace bsd {
@@ -15,7 +17,50 @@ namespace facter { namespace facts { namespace bsd {
      */
     struct networking_resolver : posix::networking_resolver
     {
+        /**
+         * The sources of DHCP lease information, which are selected with the "dhcp-lease-sources" option.
+         */
+        enum dhcp_source : unsigned int
+        {
+            /**
+             * No sources.
+             */
+            no_sources = 0,
+            /**
+             * dhclient lease files.
+             */
+            dhclient = 1,
+            /**
+             * systemd-networkd lease files, which are named by interface index.
+             */
+            networkd = 2,
+            /**
+             * NetworkManager lease files, from either its dhclient or internal DHCP client.
+             */
+            networkmanager = 4,
+            /**
+             * Running dhcpcd for each interface not found in a lease file.
+             */
+            dhcpcd = 8
+        };
+
      protected:
+        /**
+         * Represents the DHCP servers found in lease files.
+         */
+        struct dhcp_leases
+        {
+            /**
+             * Stores the DHCP servers keyed by interface name.
+             */
+            std::map<std::string, std::string> by_name;
+
+            /**
+             * Stores the DHCP servers keyed by interface index, for lease files that do not name the interface.
+             */
+            std::map<unsigned int, std::string> by_index;
+        };
+
         /**
          * Collects the resolver data.
          * @param facts The fact collection that is resolving facts.
@@ -40,16 +85,35 @@ namespace facter { namespace facts { namespace bsd {
 
         /**
          * Finds known DHCP servers for all interfaces.
-         * @return Returns a map between interface name and DHCP server.
+         * @param sources The DHCP sources to use.
+         * @return Returns the DHCP servers found in the lease files of the given sources.
          */
-        virtual std::map<std::string, std::string> find_dhcp_servers() const;
+        virtual dhcp_leases find_dhcp_servers(unsigned int sources) const;
 
         /**
-         * Finds the DHCP server for the given interface.
+         * Finds the DHCP server for an interface that was not found in a lease file.
+         * This runs dhcpcd, so it is only done when the dhcpcd source is given.
          * @param interface The interface to find the DHCP server for.
+         * @param sources The DHCP sources to use.
          * @returns Returns the DHCP server for the interface or empty string if one isn't found.
          */
-        virtual std::string find_dhcp_server(std::string const& interface) const;
+        virtual std::string find_dhcp_server(std::string const& interface, unsigned int sources) const;
+
+        /**
+         * Parses the names of DHCP sources.
+         * @param names The names of the sources; "all" and "none" are also accepted.
+         * @return Returns the DHCP sources, or every source other than dhcpcd if no names are given.
+         */
+        static unsigned int parse_dhcp_sources(std::vector<std::string> const& names);
+
+        /**
+         * Scans the lease files of the given DHCP sources.
+         * Each lease store is scanned once; the last lease for an interface in a lease file is used.
+         * @param sources The DHCP sources to scan.
+         * @param root The directory the lease stores are relative to (normally empty).
+         * @return Returns the DHCP servers found.
+         */
+        static dhcp_leases scan_dhcp_leases(unsigned int sources, std::string const& root);
 
      private:
         void populate_binding(interface& iface, ifaddrs const* addr) const;
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * Declares the Linux control group fact resolver.
+ */
+#pragma once
+
+#include "../resolvers/cgroup_resolver.hpp"
+#include <string>
+
+namespace facter { namespace facts { namespace linux {
+
+    /**
+     * Responsible for resolving the resource limits of the control group the process runs in.
+     */
+    struct cgroup_resolver : resolvers::cgroup_resolver
+    {
+     protected:
+        /**
+         * Collects the resolver data.
+         * @param facts The fact collection that is resolving facts.
+         * @return Returns the resolver data.
+         */
+        virtual data collect_data(collection& facts) override;
+
+        /**
+         * Collects the effective limits of the process's control group.
+         * Controllers mounted in a v1 hierarchy take precedence over the unified (v2) hierarchy.
+         * Limits are the lowest set on the control group or any of its ancestors within the mount.
+         * @param result The data to populate.
+         * @param cgroup_path The path of the process's control group file (normally "/proc/self/cgroup").
+         * @param mountinfo_path The path of the process's mount information file (normally "/proc/self/mountinfo").
+         * @param root The directory mount points are relative to (normally empty).
+         */
+        static void collect_limits(data& result, std::string const& cgroup_path, std::string const& mountinfo_path, std::string const& root);
+    };
+
+}}}  // namespace facter::facts::linux
@@ -13,6 +13,34 @@ namespace facter { namespace facts { namespace linux {
      */
     struct disk_resolver : resolvers::disk_resolver
     {
+        /**
+         * The optional groups of disk attributes.
+         * Each group costs additional sysfs reads per disk, so only the queue group is collected by default.
+         */
+        enum attribute_group : unsigned int
+        {
+            /**
+             * No optional attributes.
+             */
+            none = 0,
+            /**
+             * The rotational flag, block sizes and discard support.
+             */
+            queue = 1 << 0,
+            /**
+             * The I/O scheduler, nr_requests and max_sectors_kb.
+             */
+            scheduler = 1 << 1,
+            /**
+             * The NVMe namespace and transport.
+             */
+            nvme = 1 << 2,
+            /**
+             * The number of hardware queues.
+             */
+            mq = 1 << 3
+        };
+
      protected:
         /**
          * Collects the resolver data.
@@ -20,6 +48,21 @@ namespace facter { namespace facts { namespace linux {
          * @return Returns the resolver data.
          */
         virtual data collect_data(collection& facts) override;
+
+        /**
+         * Parses the attribute groups from the "disks-attributes" option.
+         * @param names The names of the groups ("queue", "scheduler", "nvme", "mq", "all" or "none").
+         * @return Returns the groups to collect; the queue group if no names are given.
+         */
+        static unsigned int parse_attribute_groups(std::vector<std::string> const& names);
+
+        /**
+         * Collects the disks from the given sysfs block directory.
+         * @param root The directory of block devices (normally "/sys/block").
+         * @param groups The optional attribute groups to collect.
+         * @return Returns the resolver data.
+         */
+        static data collect_disks(std::string const& root, unsigned int groups);
     };
 
 }}}  // namespace facter::facts::linux
@@ -14,6 +14,14 @@ namespace facter { namespace facts { namespace linux {
      */
     struct dmi_resolver : resolvers::dmi_resolver
     {
+        /**
+         * Parses a dmidecode section header (e.g. "Handle 0x0001, DMI type 1, 27 bytes").
+         * @param line The line to parse.
+         * @param dmi_type Set to the DMI type of the section if the line is a section header.
+         * @return Returns true if the line is a section header or false if not.
+         */
+        static bool parse_section_header(std::string const& line, int& dmi_type);
+
      protected:
         /**
          * Collects the resolver data.
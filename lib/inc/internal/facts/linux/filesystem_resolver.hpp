@@ -6,6 +6,8 @@
 
 #include "../resolvers/filesystem_resolver.hpp"
 #include <map>
+#include <string>
+#include <vector>
 
 namespace facter { namespace facts { namespace linux {
 
@@ -22,6 +24,51 @@ namespace facter { namespace facts { namespace linux {
          */
         static std::string safe_convert(char const* value);
 
+        /**
+         * Represents the filters used to exclude mountpoints and partitions from collection.
+         * Filtered mountpoints are not statted and filtered partitions are not probed.
+         */
+        struct filters
+        {
+            /**
+             * Constructs the filters from the options of the given fact collection.
+             * The options are "mountpoints-exclude-types", "mountpoints-exclude-paths", "mountpoints-exclude-devices"
+             * and "partitions-exclude-devices".
+             * @param facts The fact collection to read the options from.
+             */
+            explicit filters(collection const& facts);
+
+            /**
+             * Determines if any partitions are filtered.
+             * @return Returns true if partitions are filtered or false if not.
+             */
+            bool filters_partitions() const;
+
+            /**
+             * Determines if a mountpoint should be excluded.
+             * File system types and devices are matched with shell-style wildcard patterns.
+             * Paths are excluded if they are, or are beneath, an excluded path.
+             * @param path The path of the mountpoint.
+             * @param device The device of the mountpoint.
+             * @param filesystem The file system type of the mountpoint.
+             * @return Returns true if the mountpoint should be excluded or false if not.
+             */
+            bool exclude_mountpoint(std::string const& path, std::string const& device, std::string const& filesystem) const;
+
+            /**
+             * Determines if a partition should be excluded.
+             * @param device The device of the partition; matched with shell-style wildcard patterns.
+             * @return Returns true if the partition should be excluded or false if not.
+             */
+            bool exclude_partition(std::string const& device) const;
+
+         private:
+            std::vector<std::string> _mountpoint_types;
+            std::vector<std::string> _mountpoint_paths;
+            std::vector<std::string> _mountpoint_devices;
+            std::vector<std::string> _partition_devices;
+        };
+
      protected:
         /**
          * Collects the DMI data.
@@ -31,10 +78,10 @@ namespace facter { namespace facts { namespace linux {
         virtual data collect_data(collection& facts) override;
 
      private:
-        void collect_mountpoint_data(data& result);
+        void collect_mountpoint_data(data& result, filters const& filter, std::map<std::string, std::string>& mounted_devices);
         void collect_filesystem_data(data& result);
-        void collect_partition_data(data& result);
-        void populate_partition_attributes(partition& part, std::string const& device_directory, void* cache, std::map<std::string, std::string> const& mountpoints);
+        void collect_partition_data(data& result, filters const& filter, std::map<std::string, std::string> const& mounted_devices);
+        void populate_partition_attributes(partition& part, std::string const& device_directory, void* cache, bool probe, std::map<std::string, std::string> const& mountpoints);
     };
 
 }}}  // namespace facter::facts::linux
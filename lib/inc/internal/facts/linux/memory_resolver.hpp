@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../resolvers/memory_resolver.hpp"
+#include <string>
 
 namespace facter { namespace facts { namespace linux {
 
@@ -20,6 +21,14 @@ namespace facter { namespace facts { namespace linux {
          * @return Returns the resolver data.
          */
         virtual data collect_data(collection& facts) override;
+
+        /**
+         * Collects the memory of each NUMA node from sysfs.
+         * A node's available memory is its free memory plus its file pages, matching the system memory facts.
+         * @param result The data to populate with the NUMA nodes.
+         * @param root The sysfs directory of NUMA nodes (normally "/sys/devices/system/node").
+         */
+        static void collect_numa_data(data& result, std::string const& root);
     };
 
 }}}  // namespace facter::facts::linux
@@ -70,6 +70,7 @@ namespace facter { namespace facts { namespace linux {
         template <typename appender>
         void associate_src_with_iface(const route&, data&, appender) const;
         std::string get_bond_master(const std::string& name) const;
+        void collect_ethtool_data(data& result) const;
 
         std::vector<route> routes4;
         std::vector<route> routes6;
@@ -62,6 +62,16 @@ namespace facter { namespace facts { namespace linux {
          */
         static std::map<std::string, std::string> key_value_file(std::string file, std::set<std::string> const& items);
 
+        /**
+         * Parses a line of a key-value file (e.g. KEY="value").
+         * Surrounding quotes are removed from the value.
+         * @param line The line to parse.
+         * @param key Set to the key if the line is a key-value pair.
+         * @param value Set to the value if the line is a key-value pair.
+         * @return Returns true if the line is a key-value pair or false if not.
+         */
+        static bool parse_key_value(std::string const& line, std::string& key, std::string& value);
+
      protected:
         /**
          * A map of key-value pairs read from the release file.
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../posix/processor_resolver.hpp"
+#include <string>
 
 namespace facter { namespace facts { namespace linux {
 
@@ -13,6 +14,13 @@ namespace facter { namespace facts { namespace linux {
      */
     struct processor_resolver : posix::processor_resolver
     {
+        /**
+         * Determines if a directory in /sys/devices/system/cpu is the directory of a logical processor (e.g. "cpu12").
+         * @param name The name of the directory.
+         * @return Returns true if the name is "cpu" followed by digits or false if not.
+         */
+        static bool is_cpu_directory(std::string const& name);
+
      protected:
         /**
          * Collects the resolver data.
@@ -20,6 +28,38 @@ namespace facter { namespace facts { namespace linux {
          * @return Returns the resolver data.
          */
         virtual data collect_data(collection& facts) override;
+
+        /**
+         * Collects the CPU cache and NUMA topology from sysfs.
+         * Each cache shared by several CPUs is read only once, so the number of attributes read grows with the number
+         * of distinct caches rather than with the number of CPUs.
+         * @param result The data to populate with the caches and NUMA nodes.
+         * @param root The sysfs directory of system devices (normally "/sys/devices/system").
+         */
+        static void collect_topology(data& result, std::string const& root);
+
+        /**
+         * Collects the instruction set features from the processor itself, using CPUID on x86 or the auxiliary vector
+         * on ARM.  Features the kernel has disabled are not reported: on x86, features that need register state the
+         * kernel does not enable in XCR0 are left out, and on ARM the kernel only sets the hwcaps it enables.
+         * @param result The data to populate with the sorted features.
+         * @return Returns true if the features were collected or false if they must be parsed from /proc/cpuinfo.
+         */
+        static bool collect_isa_features(data& result);
+
+        /**
+         * Parses the instruction set features from the "flags" or "Features" value of a processor in /proc/cpuinfo.
+         * @param result The data to populate with the sorted features.
+         * @param flags The space-separated feature flags.
+         */
+        static void parse_isa_features(data& result, std::string const& flags);
+
+        /**
+         * Sets whether each of the common vector extensions of the architecture is supported, based on the
+         * instruction set features.
+         * @param result The data to populate.
+         */
+        static void set_vector_extensions(data& result);
     };
 
 }}}  // namespace facter::facts::linux
@@ -0,0 +1,40 @@
+/**
+ * @file
+ * Declares the Linux kernel tunables fact resolver.
+ */
+#pragma once
+
+#include "../resolvers/tunables_resolver.hpp"
+#include <string>
+#include <vector>
+
+namespace facter { namespace facts { namespace linux {
+
+    /**
+     * Responsible for resolving the values of the tunables listed in the "tunables" option.
+     */
+    struct tunables_resolver : resolvers::tunables_resolver
+    {
+     protected:
+        /**
+         * Collects the resolver data.
+         * @param facts The fact collection that is resolving facts.
+         * @return Returns the resolver data.
+         */
+        virtual data collect_data(collection& facts) override;
+
+        /**
+         * Reads the given tunables.
+         * A tunable is either a sysctl name (e.g. "vm.swappiness") or an absolute path under /proc/sys or /sys.
+         * As with sysctl, a component containing a dot is written with a slash (e.g. "net.ipv4.conf.eth0/100.rp_filter")
+         * or the name is written with slashes as separators (e.g. "net/ipv4/conf/eth0.100/rp_filter").
+         * Path components may contain shell-style wildcards, which expand to each matching file.
+         * Values are keyed by sysctl name or path, matching how the tunable was given.
+         * @param result The data to populate with the values.
+         * @param tunables The tunables to read.
+         * @param root The directory the paths are relative to (normally empty).
+         */
+        static void collect_tunables(data& result, std::vector<std::string> const& tunables, std::string const& root);
+    };
+
+}}}  // namespace facter::facts::linux
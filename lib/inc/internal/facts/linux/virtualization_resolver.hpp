@@ -14,6 +14,13 @@ namespace facter { namespace facts { namespace linux {
      */
     struct virtualization_resolver : resolvers::virtualization_resolver
     {
+        /**
+         * Determines the hypervisor from a line of lspci output.
+         * @param line The line of lspci output.
+         * @return Returns the name of the hypervisor or empty string if the line does not identify one.
+         */
+        static std::string parse_lspci(std::string const& line);
+
      protected:
         /**
          * Gets the name of the hypervisor.
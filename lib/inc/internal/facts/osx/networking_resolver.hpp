@@ -45,16 +45,18 @@ namespace facter { namespace facts { namespace osx {
 
         /**
          * Finds known DHCP servers for all interfaces.
-         * @return Returns a map between interface name and DHCP server.
+         * @param sources The DHCP sources to use.
+         * @return Returns the DHCP servers found in the lease files of the given sources.
          */
-        virtual std::map<std::string, std::string> find_dhcp_servers() const override;
+        virtual dhcp_leases find_dhcp_servers(unsigned int sources) const override;
 
         /**
          * Finds the DHCP server for the given interface.
          * @param interface The interface to find the DHCP server for.
+         * @param sources The DHCP sources to use.
          * @returns Returns the DHCP server for the interface or empty string if one isn't found.
          */
-        virtual std::string find_dhcp_server(std::string const& interface) const override;
+        virtual std::string find_dhcp_server(std::string const& interface, unsigned int sources) const override;
     };
 
 }}}  // namespace facter::facts::osx
@@ -5,6 +5,10 @@
 #pragma once
 
 #include "../resolvers/identity_resolver.hpp"
+#include <chrono>
+#include <functional>
+#include <string>
+#include <sys/types.h>
 
 namespace facter { namespace facts { namespace posix {
 
@@ -14,12 +18,61 @@ namespace facter { namespace facts { namespace posix {
     struct identity_resolver : resolvers::identity_resolver
     {
      protected:
+        /**
+         * The function type used to look up the user and group.
+         * @param uid The user id to look up.
+         * @param gid The group id to look up.
+         * @return Returns the identity data for whichever of the user and group were found.
+         */
+        using lookup_function = std::function<data(uid_t uid, gid_t gid)>;
+
         /**
          * Collects the resolver data.
          * @param facts The fact collection that is resolving facts.
          * @return Returns the resolver data.
          */
         virtual data collect_data(collection& facts) override;
+
+        /**
+         * Looks up the user and group with getpwuid_r and getgrgid_r.
+         * These go through NSS and can block for a long time when a directory service is unreachable.
+         * @param uid The user id to look up.
+         * @param gid The group id to look up.
+         * @return Returns the identity data for whichever of the user and group were found.
+         */
+        static data lookup_identity(uid_t uid, gid_t gid);
+
+        /**
+         * Looks up the user and group on a worker thread, waiting no longer than the given timeout.
+         * A successful lookup is written to the cache file.  If the timeout expires, the names of the user
+         * and group are read from the cache file instead and the worker is abandoned.
+         * At most one lookup of a given user and group is outstanding: while an abandoned worker is still blocked,
+         * later calls wait on it rather than starting another.
+         * @param uid The user id to look up.
+         * @param gid The group id to look up.
+         * @param timeout The time to wait for the lookup, or zero to wait without a deadline.
+         * @param cache_path The path of the cache file, or empty to not use a cache.
+         * @param lookup The function that looks up the user and group.
+         * @return Returns the identity data.
+         */
+        static data collect_identity(uid_t uid, gid_t gid, std::chrono::milliseconds timeout, std::string const& cache_path, lookup_function lookup);
+
+     private:
+        /**
+         * Reads the cached names of the given user and group into the result.
+         * @param path The path of the cache file.
+         * @param uid The user id being looked up.
+         * @param gid The group id being looked up.
+         * @param result The data to populate.
+         */
+        static void read_cache(std::string const& path, uid_t uid, gid_t gid, data& result);
+
+        /**
+         * Writes the looked up names to the cache file if they have changed.
+         * @param path The path of the cache file.
+         * @param result The looked up identity data.
+         */
+        static void write_cache(std::string const& path, data const& result);
     };
 
 }}}  // namespace facter::facts::posix
@@ -37,6 +37,12 @@ namespace facter { namespace facts { namespace posix {
          */
         virtual uint8_t const* get_link_address_bytes(sockaddr const* addr) const = 0;
 
+        /**
+         * Gets the name of the host as reported by gethostname.
+         * @return Returns the host name, which may be fully qualified, or an empty string if it is unavailable.
+         */
+        virtual std::string get_hostname() const;
+
         /**
          * Collects the resolver data.
          * @param facts The fact collection that is resolving facts.
@@ -0,0 +1,100 @@
+/**
+ * @file
+ * Declares the base control group fact resolver.
+ */
+#pragma once
+
+#include <facter/facts/resolver.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <string>
+
+namespace facter { namespace facts { namespace resolvers {
+
+    /**
+     * Responsible for resolving the resource limits of the control group the process runs in.
+     */
+    struct cgroup_resolver : resolver
+    {
+        /**
+         * Constructs the cgroup_resolver.
+         */
+        cgroup_resolver();
+
+        /**
+         * Called to resolve all facts the resolver is responsible for.
+         * @param facts The fact collection that is resolving facts.
+         */
+        virtual void resolve(collection& facts) override;
+
+     protected:
+        /**
+         * Represents the effective resource limits of a control group.
+         * Limits that are not set (i.e. unlimited) are left uninitialized.
+         */
+        struct data
+        {
+            /**
+             * Constructs the data.
+             */
+            data() :
+                version(0),
+                cpuset_count(0)
+            {
+            }
+
+            /**
+             * Stores the control group version (1 or 2), or 0 if the process's control group could not be found.
+             */
+            unsigned int version;
+
+            /**
+             * Stores the path of the control group, relative to the root of its hierarchy.
+             */
+            std::string path;
+
+            /**
+             * Stores the CPU bandwidth quota, in microseconds per period.
+             */
+            boost::optional<uint64_t> cpu_quota;
+
+            /**
+             * Stores the CPU bandwidth period, in microseconds.
+             */
+            boost::optional<uint64_t> cpu_period;
+
+            /**
+             * Stores the CPUs the control group may run on (e.g. "0-3").
+             */
+            std::string cpuset_cpus;
+
+            /**
+             * Stores the number of CPUs the control group may run on.
+             */
+            unsigned int cpuset_count;
+
+            /**
+             * Stores the hard memory limit, in bytes.
+             */
+            boost::optional<uint64_t> memory_max;
+
+            /**
+             * Stores the memory throttling limit, in bytes.
+             */
+            boost::optional<uint64_t> memory_high;
+
+            /**
+             * Stores the maximum number of processes.
+             */
+            boost::optional<uint64_t> pids_max;
+        };
+
+        /**
+         * Collects the resolver data.
+         * @param facts The fact collection that is resolving facts.
+         * @return Returns the resolver data.
+         */
+        virtual data collect_data(collection& facts) = 0;
+    };
+
+}}}  // namespace facter::facts::resolvers
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <facter/facts/resolver.hpp>
+#include <boost/optional.hpp>
 #include <string>
 #include <cstdint>
 #include <vector>
@@ -33,6 +34,20 @@ namespace facter { namespace facts { namespace resolvers {
          */
         struct disk
         {
+            /**
+             * Constructs the disk.
+             */
+            disk() :
+                size(0),
+                logical_block_size(0),
+                physical_block_size(0),
+                nr_requests(0),
+                max_sectors_kb(0),
+                nvme_namespace(0),
+                hardware_queues(0)
+            {
+            }
+
             /**
              * Stores the name of the disk.
              */
@@ -57,6 +72,56 @@ namespace facter { namespace facts { namespace resolvers {
              * Stores the size of the disk.
              */
             uint64_t size;
+
+            /**
+             * Stores whether the disk is rotational (i.e. not solid state), if known.
+             */
+            boost::optional<bool> rotational;
+
+            /**
+             * Stores the smallest unit the disk can address, in bytes, or 0 if unknown.
+             */
+            uint64_t logical_block_size;
+
+            /**
+             * Stores the smallest unit the disk can write without a read-modify-write, in bytes, or 0 if unknown.
+             */
+            uint64_t physical_block_size;
+
+            /**
+             * Stores whether the disk supports discard (TRIM/UNMAP), if known.
+             */
+            boost::optional<bool> discard;
+
+            /**
+             * Stores the active I/O scheduler of the disk (e.g. "mq-deadline").
+             */
+            std::string scheduler;
+
+            /**
+             * Stores the number of requests that can be queued for the disk, or 0 if unknown.
+             */
+            uint64_t nr_requests;
+
+            /**
+             * Stores the largest request size, in KiB, or 0 if unknown.
+             */
+            uint64_t max_sectors_kb;
+
+            /**
+             * Stores the NVMe namespace identifier of the disk, or 0 if the disk is not an NVMe namespace.
+             */
+            uint64_t nvme_namespace;
+
+            /**
+             * Stores the transport of the NVMe controller of the disk (e.g. "pcie" or "tcp").
+             */
+            std::string nvme_transport;
+
+            /**
+             * Stores the number of hardware queues of the disk, or 0 if unknown.
+             */
+            uint64_t hardware_queues;
         };
 
         /**
@@ -6,6 +6,8 @@
 
 #include <facter/facts/resolver.hpp>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace facter { namespace facts { namespace resolvers {
 
@@ -45,6 +47,36 @@ namespace facter { namespace facts { namespace resolvers {
             not_encrypted
         };
 
+        /**
+         * Represents the memory of a NUMA node.
+         */
+        struct numa_node
+        {
+            /**
+             * Constructs the NUMA node.
+             */
+            numa_node() :
+                mem_free(0),
+                mem_total(0)
+            {
+            }
+
+            /**
+             * Stores the name of the node (e.g. "node0").
+             */
+            std::string name;
+
+            /**
+             * Stores the free memory of the node, in bytes.
+             */
+            uint64_t mem_free;
+
+            /**
+             * Stores the total memory of the node, in bytes.
+             */
+            uint64_t mem_total;
+        };
+
         /**
          * Represents data about system memory.
          */
@@ -86,6 +118,11 @@ namespace facter { namespace facts { namespace resolvers {
              * Stores the swap encryption status.
              */
             encryption_status swap_encryption;
+
+            /**
+             * Stores the memory of each NUMA node.
+             */
+            std::vector<numa_node> numa_nodes;
         };
 
         /**
@@ -44,6 +44,17 @@ namespace facter { namespace facts { namespace resolvers {
          */
         static bool ignored_ipv6_address(std::string const& addr);
 
+        /**
+         * Returns whether an interface should be collected given the "interfaces-include" and "interfaces-exclude" options.
+         * Patterns are shell-style wildcards (e.g. "veth*").  If there are include patterns, the interface must match one.
+         * An interface matching any exclude pattern is not collected.
+         * @param name The name of the interface.
+         * @param include The include patterns.
+         * @param exclude The exclude patterns.
+         * @return Returns true if the interface should be collected or false if not.
+         */
+        static bool include_interface(std::string const& name, std::vector<std::string> const& include, std::vector<std::string> const& exclude);
+
         /**
          * Called to resolve all facts the resolver is responsible for.
          * @param facts The fact collection that is resolving facts.
@@ -106,6 +117,81 @@ namespace facter { namespace facts { namespace resolvers {
              * Stores the interface MTU.
              */
             boost::optional<uint64_t> mtu;
+
+            /**
+             * Stores the driver of the interface's device (e.g. "ixgbe").
+             */
+            std::string driver;
+
+            /**
+             * Stores the version of the driver.
+             */
+            std::string driver_version;
+
+            /**
+             * Stores the firmware version of the interface's device.
+             */
+            std::string firmware_version;
+
+            /**
+             * Stores the negotiated link speed, in Mb/s.
+             */
+            boost::optional<uint64_t> speed;
+
+            /**
+             * Stores the negotiated duplex ("full" or "half").
+             */
+            std::string duplex;
+
+            /**
+             * Stores the number of receive-only queues.
+             */
+            boost::optional<uint64_t> rx_queues;
+
+            /**
+             * Stores the number of transmit-only queues.
+             */
+            boost::optional<uint64_t> tx_queues;
+
+            /**
+             * Stores the number of combined receive and transmit queues.
+             */
+            boost::optional<uint64_t> combined_queues;
+
+            /**
+             * Stores the current receive ring size.
+             */
+            boost::optional<uint64_t> rx_ring;
+
+            /**
+             * Stores the maximum receive ring size.
+             */
+            boost::optional<uint64_t> rx_ring_max;
+
+            /**
+             * Stores the current transmit ring size.
+             */
+            boost::optional<uint64_t> tx_ring;
+
+            /**
+             * Stores the maximum transmit ring size.
+             */
+            boost::optional<uint64_t> tx_ring_max;
+
+            /**
+             * Stores whether TCP segmentation offload is enabled.
+             */
+            boost::optional<bool> tso;
+
+            /**
+             * Stores whether generic receive offload is enabled.
+             */
+            boost::optional<bool> gro;
+
+            /**
+             * Stores whether large receive offload is enabled.
+             */
+            boost::optional<bool> lro;
         };
 
         /**
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <facter/facts/resolver.hpp>
+#include <map>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -28,6 +29,78 @@ namespace facter { namespace facts { namespace resolvers {
         virtual void resolve(collection& facts) override;
 
      protected:
+        /**
+         * Represents a kind of CPU cache.
+         * Identical caches (e.g. the L1 data cache of each core) are represented once, with a count.
+         */
+        struct cache
+        {
+            /**
+             * Constructs the cache.
+             */
+            cache() :
+                level(0),
+                size(0),
+                shared_cpus(0),
+                count(0)
+            {
+            }
+
+            /**
+             * Stores the cache level (e.g. 1 for L1).
+             */
+            int level;
+
+            /**
+             * Stores the cache type (e.g. "Data", "Instruction" or "Unified").
+             */
+            std::string type;
+
+            /**
+             * Stores the size of one cache, in bytes.
+             */
+            uint64_t size;
+
+            /**
+             * Stores the number of logical processors sharing one cache.
+             */
+            int shared_cpus;
+
+            /**
+             * Stores the number of caches of this kind.
+             */
+            int count;
+        };
+
+        /**
+         * Represents a NUMA node.
+         */
+        struct numa_node
+        {
+            /**
+             * Constructs the NUMA node.
+             */
+            numa_node() :
+                cpu_count(0)
+            {
+            }
+
+            /**
+             * Stores the name of the node (e.g. "node0").
+             */
+            std::string name;
+
+            /**
+             * Stores the list of logical processors in the node (e.g. "0-7,16-23").
+             */
+            std::string cpus;
+
+            /**
+             * Stores the number of logical processors in the node.
+             */
+            int cpu_count;
+        };
+
         /**
          * Represents processor resolver data.
          */
@@ -67,6 +140,26 @@ namespace facter { namespace facts { namespace resolvers {
              * Stores the processor instruction set architecture.
              */
             std::string isa;
+
+            /**
+             * Stores the instruction set features of the processors, sorted and without duplicates (e.g. "avx2").
+             */
+            std::vector<std::string> isa_features;
+
+            /**
+             * Stores whether each of the common vector extensions is supported, keyed by extension (e.g. "avx512").
+             */
+            std::map<std::string, bool> vector_extensions;
+
+            /**
+             * Stores the CPU caches.
+             */
+            std::vector<cache> caches;
+
+            /**
+             * Stores the NUMA nodes.
+             */
+            std::vector<numa_node> numa_nodes;
         };
 
         /**
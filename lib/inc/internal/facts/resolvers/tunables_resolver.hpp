@@ -0,0 +1,60 @@
+/**
+ * @file
+ * Declares the base kernel tunables fact resolver.
+ */
+#pragma once
+
+#include <facter/facts/resolver.hpp>
+#include <facter/facts/value.hpp>
+#include <map>
+#include <string>
+
+namespace facter { namespace facts { namespace resolvers {
+
+    /**
+     * Responsible for resolving the values of configured kernel tunables.
+     */
+    struct tunables_resolver : resolver
+    {
+        /**
+         * Constructs the tunables_resolver.
+         */
+        tunables_resolver();
+
+        /**
+         * Called to resolve all facts the resolver is responsible for.
+         * @param facts The fact collection that is resolving facts.
+         */
+        virtual void resolve(collection& facts) override;
+
+     protected:
+        /**
+         * Represents the values of the configured tunables.
+         */
+        struct data
+        {
+            /**
+             * Stores the raw value of each tunable, keyed by the tunable's name.
+             */
+            std::map<std::string, std::string> values;
+        };
+
+        /**
+         * Collects the resolver data.
+         * @param facts The fact collection that is resolving facts.
+         * @return Returns the resolver data.
+         */
+        virtual data collect_data(collection& facts) = 0;
+
+        /**
+         * Converts the raw value of a tunable to a typed fact value.
+         * Integers become integer values and lists of integers (e.g. "4096 87380 6291456") become arrays of them.
+         * Bracket-selected values (e.g. "[always] madvise never") become the selected string.
+         * Anything else is kept as a string.
+         * @param text The raw value.
+         * @return Returns the typed fact value.
+         */
+        static std::unique_ptr<value> parse_value(std::string const& text);
+    };
+
+}}}  // namespace facter::facts::resolvers
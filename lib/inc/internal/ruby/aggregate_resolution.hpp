@@ -68,6 +68,7 @@ namespace facter { namespace ruby {
 
         // Helper functions
         static leatherman::ruby::VALUE deep_merge(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE left, leatherman::ruby::VALUE right);
+        static leatherman::ruby::VALUE deep_merge_all(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE values);
 
         leatherman::ruby::VALUE _self;
         leatherman::ruby::VALUE _block;
@@ -75,6 +75,11 @@ namespace facter { namespace ruby {
          */
         void flush();
 
+        /**
+         * Removes any cached values of the fact's resolutions and then flushes the fact.
+         */
+        void flush_cache();
+
      private:
         // Construction and assignment
         fact();
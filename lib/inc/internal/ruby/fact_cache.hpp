@@ -0,0 +1,74 @@
+/**
+ * @file
+ * Declares the on-disk cache for custom fact values.
+ */
+#pragma once
+
+#include <leatherman/ruby/api.hpp>
+#include <string>
+#include <cstdint>
+
+namespace facter { namespace ruby {
+
+    /**
+     * Persists values of custom fact resolutions that declare a cache TTL.
+     * Entries are keyed by fact name and the source file of the resolution.
+     */
+    struct fact_cache
+    {
+        /**
+         * Constructs a fact cache.
+         * @param directory The directory to store cached values in; caching is disabled if empty.
+         */
+        explicit fact_cache(std::string directory = {});
+
+        /**
+         * Gets the directory cached values are stored in.
+         * @return Returns the cache directory or an empty string if caching is disabled.
+         */
+        std::string const& directory() const;
+
+        /**
+         * Sets the directory cached values are stored in.
+         * @param directory The cache directory; caching is disabled if empty.
+         */
+        void directory(std::string directory);
+
+        /**
+         * Gets the path of the cache entry for the given fact and source file.
+         * @param fact The name of the fact.
+         * @param file The source file of the resolution.
+         * @return Returns the path to the cache entry or an empty string if caching is disabled.
+         */
+        std::string path(std::string const& fact, std::string const& file) const;
+
+        /**
+         * Loads a cached value if present and not expired.
+         * @param fact The name of the fact.
+         * @param file The source file of the resolution.
+         * @param ttl The time-to-live of the entry, in seconds.
+         * @param value Set to the cached value if one was loaded.
+         * @return Returns true if a value was loaded or false if there was no valid entry.
+         */
+        bool load(std::string const& fact, std::string const& file, uint32_t ttl, leatherman::ruby::VALUE& value) const;
+
+        /**
+         * Stores a value in the cache.
+         * @param fact The name of the fact.
+         * @param file The source file of the resolution.
+         * @param value The value to store.
+         */
+        void store(std::string const& fact, std::string const& file, leatherman::ruby::VALUE value) const;
+
+        /**
+         * Removes a value from the cache.
+         * @param fact The name of the fact.
+         * @param file The source file of the resolution.
+         */
+        void remove(std::string const& fact, std::string const& file) const;
+
+     private:
+        std::string _directory;
+    };
+
+}}  // namespace facter::ruby
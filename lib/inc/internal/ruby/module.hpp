@@ -6,6 +6,7 @@
 
 #include <leatherman/ruby/api.hpp>
 #include "fact.hpp"
+#include "fact_cache.hpp"
 #include <map>
 #include <set>
 #include <string>
@@ -91,6 +92,12 @@ namespace facter { namespace ruby {
          */
         facter::facts::collection& facts();
 
+        /**
+         * Gets the cache used by custom fact resolutions that declare a cache TTL.
+         * @return Returns the custom fact cache.
+         */
+        fact_cache& cache();
+
         /**
          * Gets the module's self.
          * @return Returns the module's self.
@@ -119,7 +126,7 @@ namespace facter { namespace ruby {
         static leatherman::ruby::VALUE ruby_get_debugging(leatherman::ruby::VALUE self);
         static leatherman::ruby::VALUE ruby_set_trace(leatherman::ruby::VALUE self, leatherman::ruby::VALUE value);
         static leatherman::ruby::VALUE ruby_get_trace(leatherman::ruby::VALUE self);
-        static leatherman::ruby::VALUE ruby_flush(leatherman::ruby::VALUE self);
+        static leatherman::ruby::VALUE ruby_flush(int argc, leatherman::ruby::VALUE* argv, leatherman::ruby::VALUE self);
         static leatherman::ruby::VALUE ruby_list(leatherman::ruby::VALUE self);
         static leatherman::ruby::VALUE ruby_to_hash(leatherman::ruby::VALUE self);
         static leatherman::ruby::VALUE ruby_each(leatherman::ruby::VALUE self);
@@ -153,6 +160,7 @@ namespace facter { namespace ruby {
         std::vector<std::string> _additional_search_paths;
         std::vector<std::string> _external_search_paths;
         std::set<std::string> _loaded_files;
+        fact_cache _cache;
         bool _loaded_all;
         leatherman::ruby::VALUE _self;
         leatherman::ruby::VALUE _on_message_block;
@@ -8,6 +8,8 @@
 #include "confine.hpp"
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstdint>
 
 namespace facter { namespace facts {
 
@@ -61,6 +63,26 @@ namespace facter { namespace ruby {
          */
         void value(leatherman::ruby::VALUE v);
 
+        /**
+         * Gets the cache time-to-live of the resolution.
+         * @return Returns the number of seconds a resolved value may be cached for or 0 if the value is not cached.
+         */
+        uint32_t cache_ttl() const;
+
+        /**
+         * Gets the source file the resolution's cache TTL was declared in.
+         * Cache entries are keyed by fact name and this file.
+         * @return Returns the source file or an empty string if unknown.
+         */
+        std::string const& cache_file() const;
+
+        /**
+         * Sets the cache time-to-live of the resolution.
+         * The source file is taken from the calling Ruby code.
+         * @param ttl The number of seconds a resolved value may be cached for; 0 disables caching.
+         */
+        void cache_ttl(uint32_t ttl);
+
         /**
          * Determines if the resolution is suitable.
          * @param facter The Ruby facter module to resolve facts with.
@@ -114,13 +136,16 @@ namespace facter { namespace ruby {
         static leatherman::ruby::VALUE ruby_name(leatherman::ruby::VALUE self);
         static leatherman::ruby::VALUE ruby_timeout(leatherman::ruby::VALUE self, leatherman::ruby::VALUE timeout);
         static leatherman::ruby::VALUE ruby_on_flush(leatherman::ruby::VALUE self);
+        static leatherman::ruby::VALUE ruby_cache_ttl(leatherman::ruby::VALUE self, leatherman::ruby::VALUE ttl);
 
         leatherman::ruby::VALUE _name;
         leatherman::ruby::VALUE _value;
         leatherman::ruby::VALUE _flush_block;
         std::vector<ruby::confine> _confines;
+        std::string _cache_file;
         bool _has_weight;
         size_t _weight;
+        uint32_t _cache_ttl;
     };
 
 }}  // namespace facter::ruby
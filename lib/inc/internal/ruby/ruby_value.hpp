@@ -75,6 +75,20 @@ namespace facter { namespace ruby {
           */
         virtual YAML::Emitter& write(YAML::Emitter& emitter) const override;
 
+        /**
+          * Writes the value to the given YAML writer.
+          * @param writer The YAML writer to write to.
+          * @returns Returns the given YAML writer.
+          */
+        virtual facts::yaml_writer& write(facts::yaml_writer& writer) const override;
+
+        /**
+          * Adds an estimate of the memory used by the Ruby value to the given memory usage.
+          * Ruby objects are estimated from their size in the Ruby heap rather than measured.
+          * @param usage The memory usage to add to.
+          */
+        virtual void measure(facts::memory_usage& usage) const override;
+
         /**
          * Gets the Ruby value.
          * @return Returns the Ruby value.
@@ -100,6 +114,8 @@ namespace facter { namespace ruby {
         static void to_json(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE value, facts::json_allocator& allocator, facts::json_value& json);
         static void write(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE value, std::ostream& os, bool quoted, unsigned int level);
         static void write(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE value, YAML::Emitter& emitter);
+        static void write(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE value, facts::yaml_writer& writer);
+        static void measure(leatherman::ruby::api const& ruby, leatherman::ruby::VALUE value, facts::memory_usage& usage);
 
         leatherman::ruby::VALUE _value;
 
@@ -17,6 +17,7 @@ namespace facter { namespace util { namespace bsd {
         /**
          * Default constructor.
          * This constructor will handle calling getifaddrs.
+         * The addresses are recorded into the host snapshot being recorded, or served from the snapshot being replayed.
          */
         scoped_ifaddrs();
 
@@ -28,6 +29,7 @@ namespace facter { namespace util { namespace bsd {
 
      private:
         static void free(ifaddrs* addrs);
+        static void free_replayed(ifaddrs* addrs);
     };
 
 }}}  // namespace facter::util::bsd
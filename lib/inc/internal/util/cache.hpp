@@ -0,0 +1,21 @@
+/**
+ * @file
+ * Declares the location of the data Facter caches between runs.
+ */
+#pragma once
+
+#include <string>
+
+namespace facter { namespace util {
+
+    /**
+     * Gets the directory Facter caches the given kind of data in.
+     * The directory may not exist yet; callers create it before writing their cache files into it.
+     * On POSIX platforms, root uses the system cache in /opt/puppetlabs/facter/cache.
+     * Other users use .puppetlabs/opt/facter/cache in their home directory, beside their external facts directory.
+     * @param name The name of the cache (e.g. "custom_facts").
+     * @return Returns the cache directory or an empty string if there is no home directory to cache in.
+     */
+    std::string cache_directory(std::string const& name);
+
+}}  // namespace facter::util
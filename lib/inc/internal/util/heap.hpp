@@ -0,0 +1,18 @@
+/**
+ * @file
+ * Declares the function for reading the heap usage of the process.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace facter { namespace util {
+
+    /**
+     * Gets the number of bytes the process currently has allocated from the heap.
+     * @param bytes Returns the number of bytes allocated.
+     * @return Returns true if the allocator reports its usage or false if it does not.
+     */
+    bool heap_allocated(uint64_t& bytes);
+
+}}  // namespace facter::util
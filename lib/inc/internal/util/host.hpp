@@ -0,0 +1,354 @@
+/**
+ * @file
+ * Declares the functions resolvers use to read the state of the host.
+ */
+#pragma once
+
+#include <facter/util/snapshot.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace facter { namespace util { namespace host {
+
+    /**
+     * Determines if a host snapshot is being recorded or replayed.
+     * @return Returns true if reads of the host go through a snapshot or false if they go directly to the host.
+     */
+    bool snapshot_active();
+
+    /**
+     * Determines if a host snapshot is being replayed.
+     * Host state that is neither recorded nor replayed (e.g. ioctls) should not be read from the live host during a replay.
+     * @return Returns true if reads of the host are served from a snapshot or false if they go to the host.
+     */
+    bool snapshot_replaying();
+
+    /**
+     * Counts the access to the host's filesystem made through these functions.
+     */
+    struct io_counters
+    {
+        /**
+         * Constructs zeroed counters.
+         */
+        io_counters();
+
+        /**
+         * Stores the number of files opened for reading.
+         */
+        uint64_t opens;
+
+        /**
+         * Stores the number of bytes read from files.
+         */
+        uint64_t bytes_read;
+
+        /**
+         * Stores the number of paths checked for existence or type.
+         */
+        uint64_t stats;
+
+        /**
+         * Stores the number of directories listed.
+         */
+        uint64_t scans;
+
+        /**
+         * Stores the number of directory entries passed to callbacks.
+         */
+        uint64_t entries;
+    };
+
+    /**
+     * Counts the access to the host's filesystem made while it exists.
+     * Only access from the thread that created the scope is counted, and the scope must be destroyed on that thread.
+     * Scopes nest: access is only counted against the thread's most recently created scope still in existence, so a
+     * thread's scopes must be destroyed in the reverse order they were created in.
+     */
+    struct io_scope
+    {
+        /**
+         * Starts counting.
+         */
+        io_scope();
+
+        /**
+         * Stops counting and restores the previous scope.
+         */
+        ~io_scope();
+
+        /**
+         * Prevents the scope from being copied.
+         */
+        io_scope(io_scope const&) = delete;
+
+        /**
+         * Prevents the scope from being copied.
+         * @returns Returns this scope.
+         */
+        io_scope& operator=(io_scope const&) = delete;
+
+        /**
+         * Gets the counters of the scope.
+         * @return Returns the access counted so far.
+         */
+        io_counters counters() const;
+
+        /**
+         * Adds to a counter of the current scope.
+         * Used to count access that bypasses these functions (e.g. sysfs attributes read directly).
+         * Does nothing if there is no scope.
+         * @param counter The counter to add to.
+         * @param amount The amount to add.
+         */
+        static void add(uint64_t io_counters::*counter, uint64_t amount = 1);
+
+     private:
+        io_scope* _previous;
+        io_counters _counters;
+    };
+
+#ifdef FACTER_FAULT_INJECTION
+    /**
+     * The kinds of host access faults can be injected into.
+     */
+    enum class access
+    {
+        /**
+         * Reading a file.
+         */
+        file,
+        /**
+         * Checking the existence or type of a path.
+         */
+        stat,
+        /**
+         * Listing a directory.
+         */
+        directory,
+        /**
+         * Resolving a hostname.
+         */
+        dns,
+        /**
+         * Running a command.
+         */
+        command
+    };
+
+    /**
+     * The faults that can be injected into host access.
+     */
+    enum class fault
+    {
+        /**
+         * The access proceeds normally.
+         */
+        none,
+        /**
+         * The access fails as if the target was missing or unreachable.
+         */
+        error,
+        /**
+         * The access blocks until hangs are released, then fails; a command run with a timeout times out instead.
+         */
+        hang
+    };
+
+    /**
+     * Injects faults into host access to reproduce slow or broken hosts in tests.
+     * Only the test build defines FACTER_FAULT_INJECTION; the library itself has no injection points.
+     * The injector is called before each access with the kind of access and its target (a path, hostname or command
+     * line), and may block before returning to inject latency.  Replacing the injector releases any hangs.
+     * @param injector The function that decides the fault for each access, or an empty function to stop injecting faults.
+     */
+    void inject_faults(std::function<fault(access, std::string const&)> injector);
+
+    /**
+     * Releases every access blocked by an injected hang.
+     */
+    void release_hangs();
+
+    /**
+     * Injects a fault into an access to the host.
+     * Returns fault::none without locking when no faults are being injected.
+     * An injected hang blocks until hangs are released, after which fault::error is returned, or until the timeout passes,
+     * after which fault::hang is returned.
+     * @param kind The kind of access.
+     * @param target The path, hostname or command line being accessed.
+     * @param timeout The longest time a hang may block, or zero to block until hangs are released.
+     * @return Returns the fault the access should fail with, or fault::none if it should proceed.
+     */
+    fault inject_fault(access kind, std::string const& target, std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+#endif  // FACTER_FAULT_INJECTION
+
+    /**
+     * Reads the contents of a file.
+     * Behaves the same as leatherman::file_util::read unless a host snapshot is being recorded or replayed.
+     * @param path The path of the file to read.
+     * @param contents Set to the contents of the file.
+     * @return Returns true if the file was read or false if it could not be read.
+     */
+    bool read(std::string const& path, std::string& contents);
+
+    /**
+     * Reads the contents of a file.
+     * @param path The path of the file to read.
+     * @return Returns the contents of the file or an empty string if it could not be read.
+     */
+    std::string read(std::string const& path);
+
+    /**
+     * Reads each line of a file.
+     * Behaves the same as leatherman::file_util::each_line unless a host snapshot is being recorded or replayed.
+     * @param path The path of the file to read.
+     * @param callback The callback that is passed each line; return false to stop reading.
+     * @return Returns true if the file was read or false if it could not be read.
+     */
+    bool each_line(std::string const& path, std::function<bool(std::string&)> callback);
+
+    /**
+     * Calls a callback for each regular file in a directory.
+     * Behaves the same as leatherman::file_util::each_file unless a host snapshot is being recorded or replayed.
+     * @param directory The directory to search.
+     * @param callback The callback that is passed the path of each file; return false to stop searching.
+     * @param pattern The regular expression file names must match, or empty for all files.
+     */
+    void each_file(std::string const& directory, std::function<bool(std::string const&)> callback, std::string const& pattern = {});
+
+    /**
+     * Calls a callback for each subdirectory of a directory.
+     * Behaves the same as leatherman::file_util::each_subdirectory unless a host snapshot is being recorded or replayed.
+     * @param directory The directory to search.
+     * @param callback The callback that is passed the path of each subdirectory; return false to stop searching.
+     * @param pattern The regular expression subdirectory names must match, or empty for all subdirectories.
+     */
+    void each_subdirectory(std::string const& directory, std::function<bool(std::string const&)> callback, std::string const& pattern = {});
+
+    /**
+     * Determines if a path exists.
+     * @param path The path to check.
+     * @return Returns true if the path exists or false if it does not.
+     */
+    bool exists(std::string const& path);
+
+    /**
+     * Determines if a path is a directory, following symbolic links.
+     * @param path The path to check.
+     * @return Returns true if the path is a directory or false if it is not.
+     */
+    bool is_directory(std::string const& path);
+
+    /**
+     * Determines if a path is a regular file, following symbolic links.
+     * @param path The path to check.
+     * @return Returns true if the path is a regular file or false if it is not.
+     */
+    bool is_regular_file(std::string const& path);
+
+    /**
+     * Represents the outcome of running a command on the host.
+     */
+    struct command_output
+    {
+        /**
+         * Constructs a command output for a command that was not found.
+         */
+        command_output() :
+            found(false),
+            timed_out(false),
+            signaled(false),
+            exit_code(127)
+        {
+        }
+
+        /**
+         * Stores whether or not the command was found.
+         */
+        bool found;
+
+        /**
+         * Stores whether or not the command timed out.
+         */
+        bool timed_out;
+
+        /**
+         * Stores whether or not the command was terminated by a signal.
+         */
+        bool signaled;
+
+        /**
+         * Stores the exit code of the command, or the signal that terminated it.
+         */
+        int exit_code;
+
+        /**
+         * Stores the unprocessed output written to stdout.
+         */
+        std::string output;
+
+        /**
+         * Stores the unprocessed output written to stderr.
+         */
+        std::string error;
+    };
+
+    /**
+     * Finds the recorded output of a command in the host snapshot being replayed.
+     * @param command The command and its arguments.
+     * @param output Set to the recorded output; a command that was never recorded is reported as not found.
+     * @return Returns true if a snapshot is being replayed or false if the command should be run.
+     */
+    bool replay_command(std::vector<std::string> const& command, command_output& output);
+
+    /**
+     * Records the output of a command into the host snapshot being recorded.
+     * Does nothing if a snapshot is not being recorded.
+     * @param command The command and its arguments.
+     * @param output The output of the command.
+     */
+    void record_command(std::vector<std::string> const& command, command_output output);
+
+    /**
+     * Finds the recorded location of a program in the host snapshot being replayed.
+     * @param program The program being searched for.
+     * @param path Set to the recorded path of the program or empty if it was not found.
+     * @return Returns true if a snapshot is being replayed or false if the program should be searched for.
+     */
+    bool replay_program(std::string const& program, std::string& path);
+
+    /**
+     * Records the location of a program into the host snapshot being recorded.
+     * Does nothing if a snapshot is not being recorded.
+     * @param program The program that was searched for.
+     * @param path The path of the program or empty if it was not found.
+     */
+    void record_program(std::string const& program, std::string const& path);
+
+    /**
+     * Represents one result of a system call (e.g. one interface address or one mount) as named fields.
+     */
+    using call_record = std::map<std::string, std::string>;
+
+    /**
+     * Finds the recorded results of a system call in the host snapshot being replayed.
+     * Used for host state that comes from system calls rather than files, such as getifaddrs, getmntent and uname.
+     * @param call The name of the system call.
+     * @param records Set to the recorded results; a call that was never recorded has no results.
+     * @return Returns true if a snapshot is being replayed or false if the system call should be made.
+     */
+    bool replay_call(std::string const& call, std::vector<call_record>& records);
+
+    /**
+     * Records the results of a system call into the host snapshot being recorded.
+     * Does nothing if a snapshot is not being recorded.
+     * @param call The name of the system call.
+     * @param records The results of the system call.
+     */
+    void record_call(std::string const& call, std::vector<call_record> records);
+
+}}}  // namespace facter::util::host
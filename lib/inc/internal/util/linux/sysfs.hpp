@@ -0,0 +1,30 @@
+/**
+ * @file
+ * Declares the utility functions for reading sysfs attributes.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace facter { namespace util { namespace linux {
+
+    /**
+     * Reads a sysfs attribute.
+     * Attributes are small, so each is read with a single read into a stack buffer rather than through a stream.
+     * This keeps reading hundreds of attributes (e.g. per-CPU attributes on large machines) cheap.
+     * While a host snapshot is being recorded or replayed, the attribute is read through the snapshot instead.
+     * @param path The path to the attribute file.
+     * @param value Set to the value of the attribute, with trailing whitespace removed.  The string's storage is reused.
+     * @return Returns true if the attribute was read or false if it could not be read.
+     */
+    bool read_attribute(std::string const& path, std::string& value);
+
+    /**
+     * Parses a sysfs CPU list (e.g. "0-3,8,10-11").
+     * @param list The CPU list to parse.
+     * @return Returns the CPUs in the list, in the order given, or an empty vector if the list is malformed.
+     */
+    std::vector<unsigned int> parse_cpu_list(std::string const& list);
+
+}}}  // namespace facter::util::linux
@@ -0,0 +1,19 @@
+/**
+ * @file
+ * Declares the uname function that is recorded into host snapshots.
+ */
+#pragma once
+
+#include <sys/utsname.h>
+
+namespace facter { namespace util { namespace posix {
+
+    /**
+     * Gets the names of the kernel and hardware with uname.
+     * The names are recorded into the host snapshot being recorded, or served from the snapshot being replayed.
+     * @param name The structure to populate.
+     * @return Returns true if the names were retrieved or false if uname failed (setting errno) or was not recorded.
+     */
+    bool read_uname(utsname& name);
+
+}}}  // namespace facter::util::posix
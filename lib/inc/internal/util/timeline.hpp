@@ -0,0 +1,58 @@
+/**
+ * @file
+ * Declares the spans recorded in a timeline of a facter run.
+ */
+#pragma once
+
+#include <facter/util/timeline.hpp>
+#include <chrono>
+#include <string>
+
+namespace facter { namespace util { namespace timeline {
+
+    /**
+     * Determines if a timeline is being recorded.
+     * @return Returns true if spans are being recorded or false if not.
+     */
+    bool enabled();
+
+    /**
+     * Records the time between its construction and destruction as a span on the calling thread.
+     * Spans on the same thread nest by time, so a span started while another is open appears beneath it.
+     * Constructing a span when a timeline is not being recorded costs a single atomic load.
+     */
+    struct span
+    {
+        /**
+         * Starts a span.
+         * @param category The category of the span (e.g. "resolver"); must be a string literal.
+         * @param name The name of the span.
+         * @param detail Additional detail shown for the span, or empty for none.
+         */
+        span(char const* category, std::string const& name, std::string const& detail = {});
+
+        /**
+         * Ends the span and records it.
+         */
+        ~span();
+
+        /**
+         * Prevents the span from being copied.
+         */
+        span(span const&) = delete;
+
+        /**
+         * Prevents the span from being copied.
+         * @returns Returns this span.
+         */
+        span& operator=(span const&) = delete;
+
+     private:
+        bool _enabled;
+        char const* _category;
+        std::string _name;
+        std::string _detail;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+}}}  // namespace facter::util::timeline
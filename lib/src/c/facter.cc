@@ -0,0 +1,285 @@
+#include <facter/c/facter.h>
+#include <facter/facts/collection.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/array_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include <facter/facts/computed_value.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+
+using namespace std;
+using namespace facter::facts;
+
+// The opaque handle given to C callers
+struct facter_collection
+{
+    collection facts;
+};
+
+static collection* to_collection(facter_collection* facts)
+{
+    return &facts->facts;
+}
+
+static value const* to_value(facter_value const* val)
+{
+    return reinterpret_cast<value const*>(val);
+}
+
+static facter_value const* from_value(value const* val)
+{
+    return reinterpret_cast<facter_value const*>(val);
+}
+
+template <typename F>
+static facter_status guard(char const* function, F body)
+{
+    // C++ exceptions must not propagate into C callers
+    try {
+        return body();
+    } catch (exception& ex) {
+        LOG_ERROR("%1% failed: %2%", function, ex.what());
+    } catch (...) {
+        LOG_ERROR("%1% failed with an unknown error.", function);
+    }
+    return FACTER_ERROR_FAILED;
+}
+
+extern "C" {
+    LIBFACTER_EXPORT facter_collection* facter_collection_create(void)
+    {
+        try {
+            return new facter_collection();
+        } catch (exception& ex) {
+            LOG_ERROR("facter_collection_create failed: %1%", ex.what());
+        }
+        return nullptr;
+    }
+
+    LIBFACTER_EXPORT void facter_collection_free(facter_collection* facts)
+    {
+        delete facts;
+    }
+
+    LIBFACTER_EXPORT facter_status facter_collection_add_default_facts(facter_collection* facts)
+    {
+        if (!facts) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        return guard(__func__, [&]() {
+            // Ruby facts are not supported without the Ruby integration
+            to_collection(facts)->add_default_facts(false);
+            return FACTER_OK;
+        });
+    }
+
+    LIBFACTER_EXPORT facter_status facter_collection_add_external_facts(facter_collection* facts, char const* const* directories, size_t count)
+    {
+        if (!facts || (count && !directories)) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        return guard(__func__, [&]() {
+            vector<string> paths;
+            for (size_t i = 0; i < count; ++i) {
+                if (directories[i]) {
+                    paths.emplace_back(directories[i]);
+                }
+            }
+            to_collection(facts)->add_external_facts(paths);
+            return FACTER_OK;
+        });
+    }
+
+    LIBFACTER_EXPORT facter_status facter_collection_resolve(facter_collection* facts)
+    {
+        if (!facts) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        return guard(__func__, [&]() {
+            to_collection(facts)->resolve_facts();
+            return FACTER_OK;
+        });
+    }
+
+    LIBFACTER_EXPORT facter_status facter_collection_enable_concurrency(facter_collection* facts)
+    {
+        if (!facts) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        return guard(__func__, [&]() {
+            to_collection(facts)->enable_concurrency();
+            return FACTER_OK;
+        });
+    }
+
+    LIBFACTER_EXPORT facter_value const* facter_collection_query(facter_collection* facts, char const* query)
+    {
+        if (!facts || !query) {
+            return nullptr;
+        }
+        value const* result = nullptr;
+        guard(__func__, [&]() {
+            result = to_collection(facts)->query<value>(query);
+            return FACTER_OK;
+        });
+        return from_value(result);
+    }
+
+    LIBFACTER_EXPORT facter_status facter_collection_each(facter_collection* facts, facter_value_callback callback, void* context)
+    {
+        if (!facts || !callback) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        return guard(__func__, [&]() {
+            to_collection(facts)->each([&](string const& name, value const* val) {
+                return callback(name.c_str(), from_value(val), context) != 0;
+            });
+            return FACTER_OK;
+        });
+    }
+
+    LIBFACTER_EXPORT facter_status facter_collection_write(
+        facter_collection* facts,
+        facter_format format,
+        char const* const* queries,
+        size_t query_count,
+        char* buffer,
+        size_t* size)
+    {
+        if (!facts || !size || (query_count && !queries) || (*size && !buffer)) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        return guard(__func__, [&]() {
+            facter::facts::format fmt = facter::facts::format::hash;
+            if (format == FACTER_FORMAT_JSON) {
+                fmt = facter::facts::format::json;
+            } else if (format == FACTER_FORMAT_YAML) {
+                fmt = facter::facts::format::yaml;
+            }
+
+            set<string> query_set;
+            for (size_t i = 0; i < query_count; ++i) {
+                if (queries[i]) {
+                    query_set.emplace(queries[i]);
+                }
+            }
+
+            ostringstream stream;
+            to_collection(facts)->write(stream, fmt, query_set);
+            string output = stream.str();
+
+            size_t required = output.size() + 1;
+            if (!buffer || *size < required) {
+                *size = required;
+                return FACTER_ERROR_BUFFER_TOO_SMALL;
+            }
+            memcpy(buffer, output.c_str(), required);
+            *size = required;
+            return FACTER_OK;
+        });
+    }
+
+    LIBFACTER_EXPORT facter_value_type facter_value_get_type(facter_value const* val)
+    {
+        auto ptr = to_value(val);
+        if (dynamic_cast<string_value const*>(ptr) || dynamic_cast<computed_value const*>(ptr)) {
+            return FACTER_VALUE_STRING;
+        }
+        if (dynamic_cast<integer_value const*>(ptr)) {
+            return FACTER_VALUE_INTEGER;
+        }
+        if (dynamic_cast<boolean_value const*>(ptr)) {
+            return FACTER_VALUE_BOOLEAN;
+        }
+        if (dynamic_cast<double_value const*>(ptr)) {
+            return FACTER_VALUE_DOUBLE;
+        }
+        if (dynamic_cast<array_value const*>(ptr)) {
+            return FACTER_VALUE_ARRAY;
+        }
+        if (dynamic_cast<map_value const*>(ptr)) {
+            return FACTER_VALUE_MAP;
+        }
+        return FACTER_VALUE_OTHER;
+    }
+
+    LIBFACTER_EXPORT char const* facter_value_get_string(facter_value const* val, size_t* length)
+    {
+        auto base = to_value(val);
+        string const* str = nullptr;
+        if (auto ptr = dynamic_cast<string_value const*>(base)) {
+            str = &ptr->value();
+        } else if (auto ptr = dynamic_cast<computed_value const*>(base)) {
+            str = &ptr->value();
+        }
+        if (!str) {
+            return nullptr;
+        }
+        if (length) {
+            *length = str->size();
+        }
+        return str->c_str();
+    }
+
+    LIBFACTER_EXPORT int64_t facter_value_get_integer(facter_value const* val)
+    {
+        auto ptr = dynamic_cast<integer_value const*>(to_value(val));
+        return ptr ? ptr->value() : 0;
+    }
+
+    LIBFACTER_EXPORT int facter_value_get_boolean(facter_value const* val)
+    {
+        auto ptr = dynamic_cast<boolean_value const*>(to_value(val));
+        return ptr && ptr->value() ? 1 : 0;
+    }
+
+    LIBFACTER_EXPORT double facter_value_get_double(facter_value const* val)
+    {
+        auto ptr = dynamic_cast<double_value const*>(to_value(val));
+        return ptr ? ptr->value() : 0.0;
+    }
+
+    LIBFACTER_EXPORT size_t facter_value_get_size(facter_value const* val)
+    {
+        if (auto ptr = dynamic_cast<array_value const*>(to_value(val))) {
+            return ptr->size();
+        }
+        if (auto ptr = dynamic_cast<map_value const*>(to_value(val))) {
+            return ptr->size();
+        }
+        return 0;
+    }
+
+    LIBFACTER_EXPORT facter_value const* facter_value_get_element(facter_value const* val, char const* name)
+    {
+        auto ptr = dynamic_cast<map_value const*>(to_value(val));
+        if (!ptr || !name) {
+            return nullptr;
+        }
+        return from_value((*ptr)[name]);
+    }
+
+    LIBFACTER_EXPORT facter_status facter_value_each(facter_value const* val, facter_value_callback callback, void* context)
+    {
+        if (!callback) {
+            return FACTER_ERROR_INVALID_ARGUMENT;
+        }
+        if (auto ptr = dynamic_cast<array_value const*>(to_value(val))) {
+            ptr->each([&](value const* element) {
+                return callback(nullptr, from_value(element), context) != 0;
+            });
+            return FACTER_OK;
+        }
+        if (auto ptr = dynamic_cast<map_value const*>(to_value(val))) {
+            ptr->each([&](string const& name, value const* element) {
+                return callback(name.c_str(), from_value(element), context) != 0;
+            });
+            return FACTER_OK;
+        }
+        return FACTER_ERROR_INVALID_ARGUMENT;
+    }
+}  // extern "C"
@@ -0,0 +1,93 @@
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
+#include <boost/algorithm/string.hpp>
+
+using namespace std;
+
+namespace facter { namespace execution {
+
+    string which(string const& file, vector<string> const& directories)
+    {
+        string path;
+        if (util::host::replay_program(file, path)) {
+            return path;
+        }
+        path = leatherman::execution::which(file, directories);
+        util::host::record_program(file, path);
+        return path;
+    }
+
+    tuple<string, string> process_streams(
+        bool trim,
+        function<bool(string&)> const& stdout_callback,
+        function<bool(string&)> const& stderr_callback,
+        function<void(function<bool(string const&)>, function<bool(string const&)>)> const& read_streams)
+    {
+        string output;
+        string error;
+        string stdout_buffer;
+        string stderr_buffer;
+
+        // Splits the data read from a stream into lines and passes them to the callback
+        // If there is no callback, the data is accumulated into the result instead
+        auto process_stream = [&](string& buffer, string& result, function<bool(string&)> const& callback, string const& data) {
+            if (!callback) {
+                result.append(data);
+                return true;
+            }
+
+            buffer.append(data);
+            size_t offset = 0;
+            size_t pos;
+            while ((pos = buffer.find('\n', offset)) != string::npos) {
+                string line = buffer.substr(offset, pos - offset);
+                offset = pos + 1;
+
+                // Handle Windows CR in the output
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (trim) {
+                    boost::trim(line);
+                }
+                if (!callback(line)) {
+                    buffer.clear();
+                    return false;
+                }
+            }
+            buffer.erase(0, offset);
+            return true;
+        };
+
+        bool done = false;
+        read_streams(
+            [&](string const& data) {
+                done = !process_stream(stdout_buffer, output, stdout_callback, data);
+                return !done;
+            },
+            [&](string const& data) {
+                done = !process_stream(stderr_buffer, error, stderr_callback, data);
+                return !done;
+            });
+
+        // Process any trailing output that did not end with a newline
+        auto flush_stream = [&](string& buffer, function<bool(string&)> const& callback) {
+            if (done || !callback || buffer.empty()) {
+                return;
+            }
+            if (trim) {
+                boost::trim(buffer);
+            }
+            done = !callback(buffer);
+        };
+        flush_stream(stdout_buffer, stdout_callback);
+        flush_stream(stderr_buffer, stderr_callback);
+
+        if (trim) {
+            boost::trim(output);
+            boost::trim(error);
+        }
+        return make_tuple(move(output), move(error));
+    }
+
+}}  // namespace facter::execution
@@ -0,0 +1,448 @@
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
+#include <internal/util/timeline.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <leatherman/util/scope_exit.hpp>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <thread>
+
+extern char** environ;
+
+using namespace std;
+using namespace leatherman::util;
+using facter::util::host::command_output;
+
+namespace facter { namespace execution {
+
+    /**
+     * Helper for managing the lifetime of posix_spawn attributes.
+     */
+    struct spawn_attributes
+    {
+        spawn_attributes()
+        {
+            posix_spawnattr_init(&attributes);
+        }
+
+        ~spawn_attributes()
+        {
+            posix_spawnattr_destroy(&attributes);
+        }
+
+        posix_spawnattr_t attributes;
+    };
+
+    /**
+     * Helper for managing the lifetime of posix_spawn file actions.
+     */
+    struct spawn_file_actions
+    {
+        spawn_file_actions()
+        {
+            posix_spawn_file_actions_init(&actions);
+        }
+
+        ~spawn_file_actions()
+        {
+            posix_spawn_file_actions_destroy(&actions);
+        }
+
+        posix_spawn_file_actions_t actions;
+    };
+
+    static bool create_pipe(int descriptors[2])
+    {
+        // Don't leak the pipes into children spawned concurrently; the dup2 in the child clears the flag
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+        return pipe2(descriptors, O_CLOEXEC) == 0;
+#else
+        // Without pipe2 a child spawned by another thread between these calls may still inherit the pipes
+        if (pipe(descriptors) < 0) {
+            return false;
+        }
+        fcntl(descriptors[0], F_SETFD, FD_CLOEXEC);
+        fcntl(descriptors[1], F_SETFD, FD_CLOEXEC);
+        return true;
+#endif
+    }
+
+    static vector<string> build_environment(option_set<execution_options> const& options)
+    {
+        vector<string> variables;
+        bool inherit_locale = options[execution_options::inherit_locale];
+        for (auto variable = environ; variable && *variable; ++variable) {
+            bool locale = boost::starts_with(*variable, "LC_ALL=") || boost::starts_with(*variable, "LANG=");
+            if (locale ? inherit_locale : options[execution_options::merge_environment]) {
+                variables.emplace_back(*variable);
+            }
+        }
+        if (!inherit_locale) {
+            // Use the C locale so output can be parsed reliably
+            variables.emplace_back("LC_ALL=C");
+            variables.emplace_back("LANG=C");
+        }
+        return variables;
+    }
+
+    static vector<char*> to_pointers(vector<string>& strings)
+    {
+        vector<char*> pointers;
+        pointers.reserve(strings.size() + 1);
+        for (auto& s : strings) {
+            pointers.push_back(&s[0]);
+        }
+        pointers.push_back(nullptr);
+        return pointers;
+    }
+
+    static void close_descriptor(int& descriptor)
+    {
+        if (descriptor >= 0) {
+            close(descriptor);
+            descriptor = -1;
+        }
+    }
+
+    static void kill_child(pid_t pid)
+    {
+        // The child is the leader of its own process group; kill the group so grandchildren don't linger
+        kill(-pid, SIGKILL);
+        kill(pid, SIGKILL);
+    }
+
+    static bool wait_for_child(pid_t pid, int& status, uint32_t timeout, chrono::steady_clock::time_point deadline)
+    {
+        // Without a timeout, block until the child exits; otherwise poll for its exit until the deadline
+        while (true) {
+            pid_t result = waitpid(pid, &status, timeout ? WNOHANG : 0);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result != 0) {
+                return true;
+            }
+            auto remaining = deadline - chrono::steady_clock::now();
+            if (remaining <= chrono::steady_clock::duration::zero()) {
+                return false;
+            }
+            this_thread::sleep_for(min<chrono::steady_clock::duration>(remaining, chrono::milliseconds(10)));
+        }
+    }
+
+    static result complete(
+        string const& file,
+        bool signaled,
+        int code,
+        string output,
+        string error_output,
+        size_t pid,
+        option_set<execution_options> const& options)
+    {
+        if (!error_output.empty()) {
+            LOG_DEBUG("%1% wrote to stderr: %2%", file, error_output);
+        }
+
+        bool success = false;
+        if (!signaled) {
+            success = code == 0;
+            if (!success && options[execution_options::throw_on_nonzero_exit]) {
+                throw child_exit_exception("child process returned non-zero exit status (" + to_string(code) + ").", code, move(output), move(error_output));
+            }
+        } else if (options[execution_options::throw_on_signal]) {
+            throw child_signal_exception("child process was terminated by signal (" + to_string(code) + ").", code, move(output), move(error_output));
+        }
+        LOG_DEBUG("process exited with status code %1%.", code);
+        return result { success, move(output), move(error_output), code, pid };
+    }
+
+    static result not_found(string const& file, option_set<execution_options> const& options)
+    {
+        LOG_DEBUG("%1% was not found on the PATH.", file);
+        if (options[execution_options::throw_on_nonzero_exit]) {
+            throw child_exit_exception("child process returned non-zero exit status.", 127, {}, {});
+        }
+        return result { false, "", "", 127, 0 };
+    }
+
+    // Passes the recorded output of a command through the same processing as the output of a live child
+    static result replay(
+        string const& file,
+        command_output const& recorded,
+        function<bool(string&)> const& stdout_callback,
+        function<bool(string&)> const& stderr_callback,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        if (!recorded.found) {
+            return not_found(file, options);
+        }
+
+        string output, error_output;
+        tie(output, error_output) = process_streams(options[execution_options::trim_output], stdout_callback, stderr_callback, [&](function<bool(string const&)> const& process_stdout, function<bool(string const&)> const& process_stderr) {
+            if (!recorded.output.empty() && !process_stdout(recorded.output)) {
+                return;
+            }
+            if (!recorded.error.empty()) {
+                process_stderr(recorded.error);
+            }
+        });
+
+        if (recorded.timed_out) {
+            throw timeout_exception("command timed out after " + to_string(timeout) + " seconds.", 0);
+        }
+        return complete(file, recorded.signaled, recorded.exit_code, move(output), move(error_output), 0, options);
+    }
+
+    static result spawn(
+        string const& file,
+        vector<string> const* arguments,
+        function<bool(string&)> const& stdout_callback,
+        function<bool(string&)> const& stderr_callback,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        LOG_DEBUG("executing command: %1%%2%%3%", file, arguments && !arguments->empty() ? " " : "", arguments ? boost::join(*arguments, " ") : "");
+        util::timeline::span span("process", file, arguments && util::timeline::enabled() ? boost::join(*arguments, " ") : string());
+
+#ifdef FACTER_FAULT_INJECTION
+        // An injected hang of a command run with a timeout times out like a child that never exits
+        auto injected = util::host::inject_fault(
+            util::host::access::command,
+            arguments && !arguments->empty() ? file + " " + boost::join(*arguments, " ") : file,
+            chrono::seconds(timeout));
+        if (injected == util::host::fault::hang) {
+            throw timeout_exception("command timed out after " + to_string(timeout) + " seconds.", 0);
+        }
+        if (injected == util::host::fault::error) {
+            return not_found(file, options);
+        }
+#endif
+
+        // Commands are keyed in a host snapshot by the program and its arguments as given
+        bool recording = util::host::snapshot_active();
+        vector<string> command;
+        command_output recorded;
+        if (recording) {
+            command.push_back(file);
+            if (arguments) {
+                command.insert(command.end(), arguments->begin(), arguments->end());
+            }
+            if (util::host::replay_command(command, recorded)) {
+                return replay(file, recorded, stdout_callback, stderr_callback, timeout, options);
+            }
+        }
+
+        // Search for the executable
+        string executable = which(file);
+        if (executable.empty()) {
+            util::host::record_command(command, recorded);
+            return not_found(file, options);
+        }
+        recorded.found = true;
+
+        bool redirect_to_stdout = options[execution_options::redirect_stderr_to_stdout];
+        bool redirect_to_null = !redirect_to_stdout && !stderr_callback && options[execution_options::redirect_stderr_to_null];
+
+        int stdout_pipe[2] = { -1, -1 };
+        int stderr_pipe[2] = { -1, -1 };
+        scope_exit cleanup([&]() {
+            close_descriptor(stdout_pipe[0]);
+            close_descriptor(stdout_pipe[1]);
+            close_descriptor(stderr_pipe[0]);
+            close_descriptor(stderr_pipe[1]);
+        });
+        if (!create_pipe(stdout_pipe)) {
+            throw execution_exception(string("failed to allocate pipe for stdout redirection: ") + strerror(errno));
+        }
+        if (!redirect_to_stdout && !redirect_to_null && !create_pipe(stderr_pipe)) {
+            throw execution_exception(string("failed to allocate pipe for stderr redirection: ") + strerror(errno));
+        }
+
+        // Setup the child's standard streams
+        spawn_file_actions actions;
+        posix_spawn_file_actions_addopen(&actions.actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_adddup2(&actions.actions, stdout_pipe[1], STDOUT_FILENO);
+        if (redirect_to_stdout) {
+            posix_spawn_file_actions_adddup2(&actions.actions, stdout_pipe[1], STDERR_FILENO);
+        } else if (redirect_to_null) {
+            posix_spawn_file_actions_addopen(&actions.actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        } else {
+            posix_spawn_file_actions_adddup2(&actions.actions, stderr_pipe[1], STDERR_FILENO);
+        }
+
+        // Reset the signal mask and dispositions, and put the child in its own process group so it can be killed on timeout
+        spawn_attributes attributes;
+        short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#ifdef POSIX_SPAWN_USEVFORK
+        // Older glibc versions only avoid copying the address space when asked to
+        flags |= POSIX_SPAWN_USEVFORK;
+#endif
+#ifdef POSIX_SPAWN_SETSID
+        flags |= POSIX_SPAWN_SETSID;
+#else
+        flags |= POSIX_SPAWN_SETPGROUP;
+        posix_spawnattr_setpgroup(&attributes.attributes, 0);
+#endif
+        sigset_t mask;
+        sigemptyset(&mask);
+        posix_spawnattr_setsigmask(&attributes.attributes, &mask);
+        sigset_t defaults;
+        sigfillset(&defaults);
+        sigdelset(&defaults, SIGKILL);
+        sigdelset(&defaults, SIGSTOP);
+        posix_spawnattr_setsigdefault(&attributes.attributes, &defaults);
+        posix_spawnattr_setflags(&attributes.attributes, flags);
+
+        // Build the argument and environment arrays
+        vector<string> argument_strings;
+        argument_strings.push_back(executable);
+        if (arguments) {
+            argument_strings.insert(argument_strings.end(), arguments->begin(), arguments->end());
+        }
+        auto argv = to_pointers(argument_strings);
+        auto environment_strings = build_environment(options);
+        auto envp = to_pointers(environment_strings);
+
+        pid_t child = 0;
+        int error = posix_spawn(&child, executable.c_str(), &actions.actions, &attributes.attributes, argv.data(), envp.data());
+        if (error != 0) {
+            throw execution_exception(string("failed to spawn child process: ") + strerror(error));
+        }
+
+        // Close the child's ends of the pipes so reads see EOF when the child exits
+        close_descriptor(stdout_pipe[1]);
+        close_descriptor(stderr_pipe[1]);
+
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(timeout);
+        bool timed_out = false;
+        bool stopped = false;
+
+        string output, error_output;
+        tie(output, error_output) = process_streams(options[execution_options::trim_output], stdout_callback, stderr_callback, [&](function<bool(string const&)> const& process_stdout, function<bool(string const&)> const& process_stderr) {
+            pollfd descriptors[2];
+            descriptors[0] = { stdout_pipe[0], POLLIN, 0 };
+            descriptors[1] = { stderr_pipe[0], POLLIN, 0 };
+            nfds_t count = descriptors[1].fd >= 0 ? 2 : 1;
+            size_t open_streams = count;
+            char buffer[4096];
+
+            while (open_streams > 0) {
+                int wait = -1;
+                if (timeout) {
+                    auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+                    if (remaining <= 0) {
+                        timed_out = true;
+                        return;
+                    }
+                    wait = static_cast<int>(remaining);
+                }
+
+                int ready = poll(descriptors, count, wait);
+                if (ready < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw execution_exception(string("failed to poll child process output: ") + strerror(errno));
+                }
+                if (ready == 0) {
+                    continue;
+                }
+
+                for (nfds_t i = 0; i < count; ++i) {
+                    if (descriptors[i].fd < 0 || !(descriptors[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                        continue;
+                    }
+                    ssize_t size = read(descriptors[i].fd, buffer, sizeof(buffer));
+                    if (size < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (size <= 0) {
+                        // Stop polling the stream once it's closed
+                        descriptors[i].fd = -1;
+                        --open_streams;
+                        continue;
+                    }
+                    if (recording) {
+                        (i == 0 ? recorded.output : recorded.error).append(buffer, size);
+                    }
+                    if (!(i == 0 ? process_stdout : process_stderr)(string(buffer, size))) {
+                        // The callback requested to stop reading
+                        stopped = true;
+                        return;
+                    }
+                }
+            }
+        });
+
+        // Close our ends of the pipes; a child still writing will get SIGPIPE
+        close_descriptor(stdout_pipe[0]);
+        close_descriptor(stderr_pipe[0]);
+
+        int status = 0;
+        if (stopped) {
+            // A child that is no longer being read from may never exit on its own, so kill it unless it already has
+            if (waitpid(child, &status, WNOHANG) != child) {
+                kill_child(child);
+                while (waitpid(child, &status, 0) < 0 && errno == EINTR) {
+                }
+            }
+        } else if (!timed_out && !wait_for_child(child, status, timeout, deadline)) {
+            // The timeout covers waiting for the child to exit as well as reading its output
+            timed_out = true;
+        }
+        if (timed_out) {
+            kill_child(child);
+            while (waitpid(child, nullptr, 0) < 0 && errno == EINTR) {
+            }
+            recorded.timed_out = true;
+            util::host::record_command(command, move(recorded));
+            throw timeout_exception("command timed out after " + to_string(timeout) + " seconds.", static_cast<size_t>(child));
+        }
+
+        int code = 0;
+        bool signaled = false;
+        if (WIFEXITED(status)) {
+            code = static_cast<char>(WEXITSTATUS(status));
+        } else if (WIFSIGNALED(status)) {
+            code = static_cast<char>(WTERMSIG(status));
+            signaled = true;
+        }
+        if (recording) {
+            recorded.exit_code = code;
+            recorded.signaled = signaled;
+            util::host::record_command(command, move(recorded));
+        }
+        return complete(file, signaled, code, move(output), move(error_output), static_cast<size_t>(child), options);
+    }
+
+    result execute(string const& file, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return spawn(file, nullptr, nullptr, nullptr, timeout, options);
+    }
+
+    result execute(string const& file, vector<string> const& arguments, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return spawn(file, &arguments, nullptr, nullptr, timeout, options);
+    }
+
+    bool each_line(string const& file, function<bool(string&)> stdout_callback, function<bool(string&)> stderr_callback, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return spawn(file, nullptr, stdout_callback, stderr_callback, timeout, options).success;
+    }
+
+    bool each_line(string const& file, vector<string> const& arguments, function<bool(string&)> stdout_callback, function<bool(string&)> stderr_callback, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return spawn(file, &arguments, stdout_callback, stderr_callback, timeout, options).success;
+    }
+
+}}  // namespace facter::execution
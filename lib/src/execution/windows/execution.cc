@@ -0,0 +1,30 @@
+#include <internal/execution/execution.hpp>
+
+using namespace std;
+using namespace leatherman::util;
+
+namespace facter { namespace execution {
+
+    // Windows has no fork, so process creation cost doesn't depend on the caller's heap; use leatherman directly
+
+    result execute(string const& file, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return leatherman::execution::execute(file, timeout, options);
+    }
+
+    result execute(string const& file, vector<string> const& arguments, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return leatherman::execution::execute(file, arguments, timeout, options);
+    }
+
+    bool each_line(string const& file, function<bool(string&)> stdout_callback, function<bool(string&)> stderr_callback, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return leatherman::execution::each_line(file, move(stdout_callback), move(stderr_callback), timeout, options);
+    }
+
+    bool each_line(string const& file, vector<string> const& arguments, function<bool(string&)> stdout_callback, function<bool(string&)> stderr_callback, uint32_t timeout, option_set<execution_options> const& options)
+    {
+        return leatherman::execution::each_line(file, arguments, move(stdout_callback), move(stderr_callback), timeout, options);
+    }
+
+}}  // namespace facter::execution
@@ -1,13 +1,13 @@
 #include <internal/facts/aix/kernel_resolver.hpp>
 #include <facter/facts/collection.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/util/regex.hpp>
 #include <leatherman/file_util/file.hpp>
 #include <boost/regex.hpp>
 
 using namespace leatherman::util;
-using namespace leatherman::execution;
+using namespace facter::execution;
 using namespace std;
 
 namespace lth_file = leatherman::file_util;
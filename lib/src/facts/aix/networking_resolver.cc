@@ -1,5 +1,5 @@
 #include <internal/facts/aix/networking_resolver.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -80,7 +80,7 @@ namespace facter { namespace facts { namespace aix {
 
     networking_resolver::mtu_map networking_resolver::get_mtus() const {
         mtu_map result;
-        leatherman::execution::each_line("/usr/bin/netstat", {"-in"}, [&](std::string line) {
+        facter::execution::each_line("/usr/bin/netstat", {"-in"}, [&](std::string line) {
             std::vector<std::string> fields;
             boost::trim(line);
             boost::split(fields, line, boost::is_space(), boost::token_compress_on);
@@ -212,7 +212,7 @@ namespace facter { namespace facts { namespace aix {
     std::string networking_resolver::get_primary_interface() const
     {
         std::string value;
-        leatherman::execution::each_line("netstat", { "-rn"}, [&value](std::string& line) {
+        facter::execution::each_line("netstat", { "-rn"}, [&value](std::string& line) {
             boost::trim(line);
             if (boost::starts_with(line, "default")) {
                 std::vector<std::string> fields;
@@ -1,6 +1,6 @@
 #include <internal/facts/aix/operating_system_resolver.hpp>
 #include <facter/facts/os.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/file_util/file.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <leatherman/util/regex.hpp>
@@ -11,7 +11,7 @@ using namespace std;
 using namespace leatherman::util;
 using namespace leatherman::file_util;
 using namespace boost;
-namespace execution = leatherman::execution;
+namespace execution = facter::execution;
 
 static string getattr(string object, string field)
 {
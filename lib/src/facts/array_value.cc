@@ -108,4 +108,24 @@ namespace facter { namespace facts {
         return emitter;
     }
 
+    yaml_writer& array_value::write(yaml_writer& writer) const
+    {
+        writer.begin_sequence();
+        for (auto const& element : _elements) {
+            element->write(writer);
+        }
+        writer.end_sequence();
+        return writer;
+    }
+
+    void array_value::measure(memory_usage& usage) const
+    {
+        ++usage.nodes;
+        usage.node_bytes += sizeof(*this);
+        usage.container_bytes += _elements.capacity() * sizeof(decltype(_elements)::value_type);
+        for (auto const& element : _elements) {
+            element->measure(usage);
+        }
+    }
+
 }}  // namespace facter::facts
@@ -1,17 +1,23 @@
 #include <internal/facts/bsd/networking_resolver.hpp>
+#include <facter/facts/collection.hpp>
 #include <internal/util/bsd/scoped_ifaddrs.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <leatherman/file_util/file.hpp>
-#include <leatherman/file_util/directory.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/regex.hpp>
+#include <net/if.h>
 #include <netinet/in.h>
 
 using namespace std;
 using namespace facter::util::bsd;
-using namespace leatherman::execution;
+using namespace facter::execution;
+using boost::lexical_cast;
+using boost::bad_lexical_cast;
 
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace bsd {
 
@@ -26,6 +32,14 @@ namespace facter { namespace facts { namespace bsd {
             return data;
         }
 
+        // Filter interfaces before any per-interface work is done
+        auto const& include = facts.get_option("interfaces-include");
+        auto const& exclude = facts.get_option("interfaces-exclude");
+        bool filtered = !include.empty() || !exclude.empty();
+        if (filtered) {
+            LOG_DEBUG("interfaces not matching the interface filters will not be collected.");
+        }
+
         // Map an interface to entries describing that interface
         multimap<string, ifaddrs const*> interface_map;
         for (ifaddrs* ptr = addrs; ptr; ptr = ptr->ifa_next) {
@@ -37,13 +51,18 @@ namespace facter { namespace facts { namespace bsd {
                 continue;
             }
 
+            if (filtered && !include_interface(ptr->ifa_name, include, exclude)) {
+                continue;
+            }
+
             interface_map.insert({ ptr->ifa_name, ptr });
         }
 
         data.primary_interface = get_primary_interface();
 
-        // Start by getting the DHCP servers
-        auto dhcp_servers = find_dhcp_servers();
+        // Start by getting the DHCP servers from the lease files
+        auto dhcp_sources = parse_dhcp_sources(facts.get_option("dhcp-lease-sources"));
+        auto dhcp_servers = find_dhcp_servers(dhcp_sources);
 
         // Walk the interfaces
         decltype(interface_map.begin()) it = interface_map.begin();
@@ -59,12 +78,19 @@ namespace facter { namespace facts { namespace bsd {
                 populate_mtu(iface, it->second);
             }
 
-            // Populate the interface's DHCP server value
-            auto dhcp_server_it = dhcp_servers.find(name);
-            if (dhcp_server_it == dhcp_servers.end()) {
-                iface.dhcp_server = find_dhcp_server(name);
-            } else {
+            // Populate the interface's DHCP server value, looking up the interface index only if a lease needs it
+            auto dhcp_server_it = dhcp_servers.by_name.find(name);
+            if (dhcp_server_it != dhcp_servers.by_name.end()) {
                 iface.dhcp_server = dhcp_server_it->second;
+            } else {
+                auto indexed_it = dhcp_servers.by_index.empty() ?
+                    dhcp_servers.by_index.end() :
+                    dhcp_servers.by_index.find(if_nametoindex(name.c_str()));
+                if (indexed_it != dhcp_servers.by_index.end()) {
+                    iface.dhcp_server = indexed_it->second;
+                } else {
+                    iface.dhcp_server = find_dhcp_server(name, dhcp_sources);
+                }
             }
 
             data.interfaces.emplace_back(move(iface));
@@ -118,48 +144,139 @@ namespace facter { namespace facts { namespace bsd {
         return {};
     }
 
-    map<string, string> networking_resolver::find_dhcp_servers() const
+    unsigned int networking_resolver::parse_dhcp_sources(vector<string> const& names)
     {
-        map<string, string> servers;
-
-        static vector<string> const dhclient_search_directories = {
-            "/var/lib/dhclient",
-            "/var/lib/dhcp",
-            "/var/lib/dhcp3",
-            "/var/lib/NetworkManager",
-            "/var/db"
-        };
-
-        for (auto const& dir : dhclient_search_directories) {
-            LOG_DEBUG("searching \"%1%\" for dhclient lease files.", dir);
-            lth_file::each_file(dir, [&](string const& path) {
-                LOG_DEBUG("reading \"%1%\" for dhclient lease information.", path);
-
-                // Each lease entry should have the interface declaration before the options
-                // We respect the last lease for an interface in the file
-                string interface;
-                lth_file::each_line(path, [&](string& line) {
-                    boost::trim(line);
-                    if (boost::starts_with(line, "interface ")) {
-                        interface = line.substr(10);
-                        trim_if(interface, boost::is_any_of("\";"));
-                    } else if (!interface.empty() && boost::starts_with(line, "option dhcp-server-identifier ")) {
-                        string server = line.substr(30);
-                        trim_if(server, boost::is_any_of("\";"));
-                        servers.emplace(make_pair(move(interface), move(server)));
-                    }
+        if (names.empty()) {
+            return dhclient | networkd | networkmanager;
+        }
+        unsigned int sources = no_sources;
+        for (auto const& name : names) {
+            if (name == "dhclient") {
+                sources |= dhclient;
+            } else if (name == "networkd") {
+                sources |= networkd;
+            } else if (name == "networkmanager") {
+                sources |= networkmanager;
+            } else if (name == "dhcpcd") {
+                sources |= dhcpcd;
+            } else if (name == "all") {
+                sources |= dhclient | networkd | networkmanager | dhcpcd;
+            } else if (name != "none") {
+                LOG_WARNING("unknown DHCP lease source \"%1%\" is ignored.", name);
+            }
+        }
+        return sources;
+    }
+
+    static void read_dhclient_leases(string const& path, map<string, string>& servers)
+    {
+        LOG_DEBUG("reading \"%1%\" for dhclient lease information.", path);
+
+        // Each lease entry should have the interface declaration before the options
+        // We respect the last lease for an interface in the file
+        string interface;
+        host::each_line(path, [&](string& line) {
+            boost::trim(line);
+            if (boost::starts_with(line, "interface ")) {
+                interface = line.substr(10);
+                trim_if(interface, boost::is_any_of("\";"));
+            } else if (!interface.empty() && boost::starts_with(line, "option dhcp-server-identifier ")) {
+                string server = line.substr(30);
+                trim_if(server, boost::is_any_of("\";"));
+                servers[interface] = move(server);
+            }
+            return true;
+        });
+    }
+
+    static string read_networkd_lease(string const& path)
+    {
+        // systemd-networkd and the NetworkManager internal client write "KEY=value" lines
+        string server;
+        host::each_line(path, [&](string& line) {
+            if (boost::starts_with(line, "SERVER_ADDRESS=")) {
+                server = line.substr(15);
+                boost::trim(server);
+                return false;
+            }
+            return true;
+        });
+        return server;
+    }
+
+    networking_resolver::dhcp_leases networking_resolver::scan_dhcp_leases(unsigned int sources, string const& root)
+    {
+        dhcp_leases leases;
+
+        if (sources & dhclient) {
+            static vector<string> const dhclient_search_directories = {
+                "/var/lib/dhclient",
+                "/var/lib/dhcp",
+                "/var/lib/dhcp3",
+                "/var/db"
+            };
+
+            for (auto const& dir : dhclient_search_directories) {
+                LOG_DEBUG("searching \"%1%\" for dhclient lease files.", dir);
+                host::each_file(root + dir, [&](string const& path) {
+                    read_dhclient_leases(path, leases.by_name);
                     return true;
-                });
+                }, "^dhclient.*lease.*$");
+            }
+        }
+
+        if (sources & networkmanager) {
+            // Lease files are named "<client>-<connection uuid>-<interface>.lease"
+            static boost::regex const internal_lease("^internal-[0-9a-fA-F-]{36}-(.+)\\.lease$");
+            string dir = "/var/lib/NetworkManager";
+            LOG_DEBUG("searching \"%1%\" for NetworkManager lease files.", dir);
+            host::each_file(root + dir, [&](string const& path) {
+                boost::smatch match;
+                auto name = boost::filesystem::path(path).filename().string();
+                if (boost::regex_match(name, match, internal_lease)) {
+                    auto server = read_networkd_lease(path);
+                    if (!server.empty()) {
+                        leases.by_name[match[1]] = move(server);
+                    }
+                } else {
+                    read_dhclient_leases(path, leases.by_name);
+                }
+                return true;
+            }, "^(dhclient|internal)-.*lease.*$");
+        }
+
+        if (sources & networkd) {
+            // Lease files are named by interface index
+            string dir = "/run/systemd/netif/leases";
+            LOG_DEBUG("searching \"%1%\" for systemd-networkd lease files.", dir);
+            host::each_file(root + dir, [&](string const& path) {
+                auto server = read_networkd_lease(path);
+                if (!server.empty()) {
+                    try {
+                        leases.by_index[lexical_cast<unsigned int>(boost::filesystem::path(path).filename().string())] = move(server);
+                    } catch (bad_lexical_cast&) {
+                    }
+                }
                 return true;
-            }, "^dhclient.*lease.*$");
+            }, "^[0-9]+$");
         }
-        return servers;
+        return leases;
     }
 
-    string networking_resolver::find_dhcp_server(string const& interface) const
+    networking_resolver::dhcp_leases networking_resolver::find_dhcp_servers(unsigned int sources) const
     {
+        return scan_dhcp_leases(sources, {});
+    }
+
+    string networking_resolver::find_dhcp_server(string const& interface, unsigned int sources) const
+    {
+        // Running dhcpcd for every interface is expensive, so it must be enabled
+        if (!(sources & dhcpcd)) {
+            return {};
+        }
+
         // Use dhcpcd if it's present to get the interface's DHCP lease information
-        // This assumes we've already searched for the interface with dhclient
+        // This assumes we've already searched for the interface in the lease files
         string value;
         each_line("dhcpcd", { "-U", interface }, [&value](string& line) {
             if (boost::starts_with(line, "dhcp_server_identifier=")) {
@@ -1,12 +1,15 @@
 #include <facter/facts/collection.hpp>
+#include <facter/facts/plugin.hpp>
 #include <facter/facts/resolver.hpp>
 #include <facter/facts/value.hpp>
 #include <facter/facts/scalar_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include <facter/facts/map_value.hpp>
+#include <facter/facts/yaml_writer.hpp>
 #include <facter/ruby/ruby.hpp>
 #include <leatherman/file_util/directory.hpp>
 #include <leatherman/util/environment.hpp>
+#include <leatherman/util/scope_exit.hpp>
 #include <facter/util/string.hpp>
 #include <facter/version.h>
 #include <leatherman/dynamic_library/dynamic_library.hpp>
@@ -16,24 +19,313 @@
 #include <internal/facts/resolvers/gce_resolver.hpp>
 #include <internal/facts/resolvers/augeas_resolver.hpp>
 #include <internal/ruby/ruby_value.hpp>
+#include <internal/util/heap.hpp>
+#include <internal/util/host.hpp>
+#include <internal/util/timeline.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
-#include <yaml-cpp/yaml.h>
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 using namespace facter::util;
 using namespace rapidjson;
-using namespace YAML;
 using namespace boost::filesystem;
 using namespace leatherman::util;
 using namespace leatherman::file_util;
 
 namespace facter { namespace facts {
 
+    /**
+     * An immutable view of the facts in a concurrent collection.
+     */
+    struct collection::snapshot
+    {
+        /**
+         * An immutable layer of the facts in a snapshot.
+         * A layer holds only what changed since the layer it is based on, so publishing a few newly settled facts doesn't
+         * copy every fact.  Layers are merged into their base once they hold at least half as many entries, which keeps
+         * the number of layers logarithmic in the number of facts.
+         */
+        struct layer
+        {
+            shared_ptr<layer const> base;
+            // The facts added or replaced in this layer; a null value is a fact removed from the layers below
+            map<string, value const*> facts;
+            // The names settled in this layer
+            set<string> settled;
+
+            size_t entries() const
+            {
+                return facts.size() + settled.size();
+            }
+
+            static shared_ptr<layer const> compact(shared_ptr<layer> top)
+            {
+                while (top->base && top->entries() * 2 >= top->base->entries()) {
+                    auto const& lower = *top->base;
+                    auto merged = make_shared<layer>();
+                    merged->base = lower.base;
+                    merged->facts = lower.facts;
+                    for (auto const& kvp : top->facts) {
+                        merged->facts[kvp.first] = kvp.second;
+                    }
+                    merged->settled = lower.settled;
+                    merged->settled.insert(top->settled.begin(), top->settled.end());
+                    if (!merged->base) {
+                        // Nothing is below the bottom layer to remove facts from
+                        for (auto it = merged->facts.begin(); it != merged->facts.end();) {
+                            if (it->second) {
+                                ++it;
+                            } else {
+                                it = merged->facts.erase(it);
+                            }
+                        }
+                    }
+                    top = move(merged);
+                }
+                return top;
+            }
+        };
+
+        value const* find(string const& name) const
+        {
+            for (auto level = facts.get(); level; level = level->base.get()) {
+                auto it = level->facts.find(name);
+                if (it != level->facts.end()) {
+                    return it->second;
+                }
+            }
+            return nullptr;
+        }
+
+        bool is_settled(string const& name) const
+        {
+            for (auto level = facts.get(); level; level = level->base.get()) {
+                if (level->settled.count(name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void each(function<bool(string const&, value const*)> const& func) const
+        {
+            map<string, value const*> merged;
+            auto const* visible = &facts->facts;
+            if (facts->base) {
+                // The upper layers take precedence, so only add the names not already seen
+                for (auto level = facts.get(); level; level = level->base.get()) {
+                    merged.insert(level->facts.begin(), level->facts.end());
+                }
+                visible = &merged;
+            }
+            for (auto const& kvp : *visible) {
+                if (kvp.second && !func(kvp.first, kvp.second)) {
+                    return;
+                }
+            }
+        }
+
+        shared_ptr<layer const> facts;
+        size_t size = 0;
+        bool resolved = false;
+        // Values replaced or removed while this was the current snapshot
+        vector<unique_ptr<value>> retired;
+        // A retired value may be visible in every earlier snapshot, so each snapshot keeps the later ones alive
+        shared_ptr<snapshot> next;
+
+        ~snapshot()
+        {
+            // Release the chain of later snapshots iteratively so a long chain cannot overflow the stack
+            auto following = move(next);
+            while (following && following.use_count() == 1) {
+                auto after = move(following->next);
+                following = move(after);
+            }
+        }
+    };
+
+    /**
+     * The synchronization state of a concurrent collection.
+     * All members other than the current snapshot and owner are protected by the mutex.
+     * The current snapshot is only accessed through the atomic shared_ptr functions, so a snapshot and the values retired
+     * with it are destroyed once it has been replaced and the last reader of it or an earlier snapshot has finished.
+     */
+    struct collection::concurrency_state
+    {
+        /**
+         * Holds the collection's lock for a scope; does nothing if the collection is not concurrent.
+         */
+        struct guard
+        {
+            guard(concurrency_state* state, map<string, unique_ptr<value>> const& facts) :
+                _state(state),
+                _facts(facts)
+            {
+                if (_state) {
+                    _state->enter();
+                }
+            }
+
+            ~guard()
+            {
+                if (_state) {
+                    _state->leave(_facts);
+                }
+            }
+
+         private:
+            concurrency_state* _state;
+            map<string, unique_ptr<value>> const& _facts;
+        };
+
+        bool owned() const
+        {
+            return owner.load() == this_thread::get_id();
+        }
+
+        void enter()
+        {
+            mutex.lock();
+            if (depth++ == 0) {
+                owner = this_thread::get_id();
+            }
+        }
+
+        void leave(map<string, unique_ptr<value>> const& facts)
+        {
+            scope_exit unlock([&]() { mutex.unlock(); });
+            if (--depth == 0) {
+                owner = thread::id();
+                // Only publish once the outermost operation completes so readers never see a partial resolution
+                if (dirty) {
+                    publish(facts);
+                }
+            }
+        }
+
+        shared_ptr<snapshot const> load() const
+        {
+            return atomic_load(&current);
+        }
+
+        void publish(map<string, unique_ptr<value>> const& facts)
+        {
+            auto previous = atomic_load(&current);
+            auto next = make_shared<snapshot>();
+            if (rebuild || !previous) {
+                auto layer = make_shared<snapshot::layer>();
+                for (auto const& kvp : facts) {
+                    layer->facts.emplace_hint(layer->facts.end(), kvp.first, kvp.second.get());
+                }
+                layer->settled = settled;
+                next->facts = move(layer);
+            } else if (changed.empty() && newly_settled.empty()) {
+                next->facts = previous->facts;
+            } else {
+                // Add only what changed since the previous snapshot so lazily settling facts one at a time stays linear
+                auto layer = make_shared<snapshot::layer>();
+                layer->base = previous->facts;
+                layer->facts = move(changed);
+                layer->settled = move(newly_settled);
+                next->facts = snapshot::layer::compact(move(layer));
+            }
+            next->size = facts.size();
+            next->resolved = resolved;
+            changed.clear();
+            newly_settled.clear();
+            rebuild = false;
+
+            // Readers of the previous snapshot may still be using the values retired since it was published
+            if (previous) {
+                move(retired.begin(), retired.end(), back_inserter(previous->retired));
+                previous->next = next;
+            }
+            retired.clear();
+            atomic_store(&current, next);
+            dirty = false;
+        }
+
+        void settle(string const& name, bool exists)
+        {
+            // Names that resolve to nothing are not settled so lookups of missing facts don't publish snapshots
+            if (!resolved && exists && settled.insert(name).second) {
+                newly_settled.insert(name);
+                dirty = true;
+            }
+        }
+
+        void change(string const& name, value const* val)
+        {
+            changed[name] = val;
+            dirty = true;
+        }
+
+        void reset()
+        {
+            // Rebuild the next snapshot from the facts rather than layering on the previous one
+            changed.clear();
+            newly_settled.clear();
+            rebuild = true;
+            dirty = true;
+        }
+
+        void invalidate(resolver const& res)
+        {
+            // Settled names are only ever added to layers, so forgetting one requires a rebuild
+            reset();
+            for (auto const& name : res.names()) {
+                settled.erase(name);
+            }
+            if (res.has_patterns()) {
+                for (auto it = settled.begin(); it != settled.end();) {
+                    if (res.is_match(*it)) {
+                        it = settled.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            resolved = false;
+        }
+
+        recursive_mutex mutex;
+        shared_ptr<snapshot> current;
+        atomic<thread::id> owner { thread::id() };
+        unsigned int depth = 0;
+        set<string> settled;
+        bool resolved = false;
+        bool dirty = true;
+        // The changes since the current snapshot was published
+        map<string, value const*> changed;
+        set<string> newly_settled;
+        bool rebuild = true;
+        vector<unique_ptr<value>> retired;
+    };
+
+    /**
+     * The heap memory allocated by the resolvers of a collection with memory accounting enabled.
+     */
+    struct collection::allocation_state
+    {
+        allocation_state() :
+            nested(0)
+        {
+        }
+
+        map<string, int64_t> resolvers;
+        // The bytes allocated by every resolver run so far, including nested ones
+        int64_t nested;
+    };
+
     collection::collection()
     {
         // This needs to be defined here since we use incomplete types in the header
@@ -56,6 +348,11 @@ namespace facter { namespace facts {
             _resolvers = std::move(other._resolvers);
             _resolver_map = std::move(other._resolver_map);
             _pattern_resolvers = std::move(other._pattern_resolvers);
+            _options = std::move(other._options);
+            _concurrency = std::move(other._concurrency);
+            _allocations = std::move(other._allocations);
+            // Move the plugins last so the libraries outlive any replaced resolvers
+            _plugins = std::move(other._plugins);
         }
         return *this;
     }
@@ -72,6 +369,8 @@ namespace facter { namespace facts {
             return;
         }
 
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
         for (auto const& name : res->names()) {
             _resolver_map.insert({ name, res });
         }
@@ -81,10 +380,16 @@ namespace facter { namespace facts {
         }
 
         _resolvers.push_back(res);
+
+        if (_concurrency) {
+            _concurrency->invalidate(*res);
+        }
     }
 
     void collection::add(string name, unique_ptr<value> value)
     {
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
         // Ensure the fact is resolved before replacing it
         auto old_value = get_value(name);
 
@@ -117,7 +422,12 @@ namespace facter { namespace facts {
             return;
         }
 
-        _facts[move(name)] = move(value);
+        auto& current = _facts[name];
+        retire(move(current));
+        current = move(value);
+        if (_concurrency) {
+            _concurrency->change(name, current.get());
+        }
     }
 
     bool collection::add_external_facts_dir(vector<unique_ptr<external::resolver>> const& resolvers, string const& dir, bool warn)
@@ -145,6 +455,7 @@ namespace facter { namespace facts {
                 if (res->can_resolve(path)) {
                     try {
                         found = true;
+                        timeline::span span("external", path);
                         res->resolve(path, *this);
                     }
                     catch (external::external_fact_exception& ex) {
@@ -178,6 +489,59 @@ namespace facter { namespace facts {
         }
     }
 
+    void collection::add_plugin_facts(vector<string> const& directories)
+    {
+#if defined(_WIN32)
+        static char const* extension = ".dll";
+#elif defined(__APPLE__)
+        static char const* extension = ".dylib";
+#else
+        static char const* extension = ".so";
+#endif
+        for (auto const& dir : directories) {
+            boost::system::error_code ec;
+            path search_dir = absolute(dir);
+            if (!is_directory(search_dir, ec)) {
+                LOG_DEBUG("skipping native fact plugins for \"%1%\": %2%", dir, ec ? ec.message() : "not a directory");
+                continue;
+            }
+
+            LOG_DEBUG("searching %1% for native fact plugins.", search_dir);
+
+            each_file(search_dir.string(), [&](string const& file) {
+                if (path(file).extension().string() != extension) {
+                    return true;
+                }
+
+                unique_ptr<leatherman::dynamic_library::dynamic_library> library(new leatherman::dynamic_library::dynamic_library());
+                if (!library->load(file)) {
+                    LOG_WARNING("native fact plugin \"%1%\" could not be loaded.", file);
+                    return true;
+                }
+
+                auto registration = reinterpret_cast<facter_plugin_register_function>(library->find_symbol(FACTER_PLUGIN_REGISTER_SYMBOL));
+                if (!registration) {
+                    LOG_WARNING("native fact plugin \"%1%\" does not export %2% and will be ignored.", file, FACTER_PLUGIN_REGISTER_SYMBOL);
+                    return true;
+                }
+
+                LOG_DEBUG("loading native fact plugin %1%.", file);
+                try {
+                    int result = registration(FACTER_PLUGIN_API_VERSION, this);
+                    if (result != 0) {
+                        LOG_ERROR("native fact plugin \"%1%\" failed to register (error %2%).", file, result);
+                    }
+                } catch (exception& ex) {
+                    LOG_ERROR("error while registering native fact plugin \"%1%\": %2%", file, ex.what());
+                }
+
+                // Keep the library loaded even on failure; it may have added resolvers before failing
+                _plugins.emplace_back(move(library));
+                return true;
+            });
+        }
+    }
+
     void collection::add_environment_facts(function<void(string const& name)> callback)
     {
         environment::each([&](string& name, string& value) {
@@ -205,6 +569,8 @@ namespace facter { namespace facts {
             return;
         }
 
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
         // Remove all name associations
         for (auto const& name : res->names()) {
             auto range = _resolver_map.equal_range(name);
@@ -224,31 +590,55 @@ namespace facter { namespace facts {
 
     void collection::remove(string const& name)
     {
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
         // Ensure the fact is in the collection
         // This will properly resolve the fact prior to removing it
         if (!get_value(name)) {
             return;
         }
 
-        _facts.erase(name);
+        auto it = _facts.find(name);
+        retire(move(it->second));
+        _facts.erase(it);
+        if (_concurrency) {
+            _concurrency->change(name, nullptr);
+        }
     }
 
     void collection::clear()
     {
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
+        for (auto& kvp : _facts) {
+            retire(move(kvp.second));
+        }
         _facts.clear();
         _resolvers.clear();
         _resolver_map.clear();
         _pattern_resolvers.clear();
+
+        if (_concurrency) {
+            // With no resolvers left, every fact is settled
+            _concurrency->settled.clear();
+            _concurrency->resolved = true;
+            _concurrency->reset();
+        }
     }
 
     bool collection::empty()
     {
+        concurrency_state::guard lock(_concurrency.get(), _facts);
         return _facts.empty() && _resolvers.empty();
     }
 
     size_t collection::size()
     {
         resolve_facts();
+
+        if (_concurrency && !_concurrency->owned()) {
+            return _concurrency->load()->size;
+        }
         return _facts.size();
     }
 
@@ -260,10 +650,7 @@ namespace facter { namespace facts {
     void collection::each(function<bool(string const&, value const*)> func)
     {
         resolve_facts();
-
-        find_if(begin(_facts), end(_facts), [&func](map<string, unique_ptr<value>>::value_type const& it) {
-            return !func(it.first, it.second.get());
-        });
+        each_fact(func);
     }
 
     ostream& collection::write(ostream& stream, format fmt, set<string> const& queries)
@@ -290,12 +677,113 @@ namespace facter { namespace facts {
 
     void collection::resolve_facts()
     {
+        if (_concurrency && !_concurrency->owned() && _concurrency->load()->resolved) {
+            return;
+        }
+
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
         // Remove the front of the resolvers list and resolve until no resolvers are left
         while (!_resolvers.empty()) {
             auto resolver = _resolvers.front();
             remove(resolver);
-            LOG_DEBUG("resolving %1% facts.", resolver->name());
-            resolver->resolve(*this);
+            run_resolver(*resolver);
+        }
+
+        if (_concurrency && !_concurrency->resolved) {
+            _concurrency->resolved = true;
+            _concurrency->dirty = true;
+        }
+    }
+
+    void collection::enable_concurrency()
+    {
+        if (_concurrency) {
+            return;
+        }
+
+        _concurrency.reset(new concurrency_state());
+        _concurrency->resolved = _resolvers.empty();
+        _concurrency->publish(_facts);
+    }
+
+    bool collection::concurrent() const
+    {
+        return static_cast<bool>(_concurrency);
+    }
+
+    void collection::set_option(string const& name, vector<string> values)
+    {
+        _options[name] = move(values);
+    }
+
+    vector<string> const& collection::get_option(string const& name) const
+    {
+        static vector<string> const empty;
+        auto it = _options.find(name);
+        return it == _options.end() ? empty : it->second;
+    }
+
+    void collection::enable_memory_accounting()
+    {
+        uint64_t bytes = 0;
+        if (_allocations || !heap_allocated(bytes)) {
+            return;
+        }
+        _allocations.reset(new allocation_state());
+    }
+
+    map<string, int64_t> collection::resolver_allocations() const
+    {
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+        return _allocations ? _allocations->resolvers : map<string, int64_t>();
+    }
+
+    map<string, memory_usage> collection::measure() const
+    {
+        map<string, memory_usage> result;
+        each_fact([&](string const& name, value const* val) {
+            auto& usage = result[name];
+            // Each fact is a tree node in the collection holding a color, three links and the name/value pair
+            usage.container_bytes += sizeof(decltype(_facts)::value_type) + 4 * sizeof(void*);
+            usage.string_bytes += memory_usage::allocated(name);
+            if (val) {
+                val->measure(usage);
+            }
+            return true;
+        });
+        return result;
+    }
+
+    void collection::run_resolver(resolver& res)
+    {
+        LOG_DEBUG("resolving %1% facts.", res.name());
+        timeline::span span("resolver", res.name());
+
+        // Only count the host access of a resolver when it is reported
+        unique_ptr<host::io_scope> io;
+        if (LOG_IS_DEBUG_ENABLED()) {
+            io.reset(new host::io_scope());
+        }
+
+        uint64_t before = 0;
+        bool accounting = _allocations && heap_allocated(before);
+        auto nested = accounting ? _allocations->nested : 0;
+
+        res.resolve(*this);
+
+        uint64_t after = 0;
+        if (accounting && heap_allocated(after)) {
+            auto allocated = static_cast<int64_t>(after - before);
+            // Leave out what the resolvers of facts looked up by this resolver allocated
+            _allocations->resolvers[res.name()] += allocated - (_allocations->nested - nested);
+            _allocations->nested = nested + allocated;
+        }
+
+        if (io) {
+            auto counters = io->counters();
+            LOG_DEBUG("%1% resolver opened %2% files, read %3% bytes, checked %4% paths and scanned %5% directories with %6% entries.",
+                      res.name(), counters.opens, counters.bytes_read, counters.stats, counters.scans, counters.entries);
         }
     }
 
@@ -307,8 +795,7 @@ namespace facter { namespace facts {
         while (it != range.second) {
             auto resolver = (it++)->second;
             remove(resolver);
-            LOG_DEBUG("resolving %1% facts.", resolver->name());
-            resolver->resolve(*this);
+            run_resolver(*resolver);
         }
 
          // Resolve every resolver that matches the given name
@@ -320,20 +807,66 @@ namespace facter { namespace facts {
             }
             auto resolver = *(pattern_it++);
             remove(resolver);
-            LOG_DEBUG("resolving %1% facts.", resolver->name());
-            resolver->resolve(*this);
+            run_resolver(*resolver);
         }
     }
 
     value const* collection::get_value(string const& name)
     {
+        if (_concurrency && !_concurrency->owned()) {
+            // Facts with no pending resolvers can be read from the current snapshot without locking
+            auto current = _concurrency->load();
+            if (current->resolved || current->is_settled(name)) {
+                return current->find(name);
+            }
+        }
+
+        timeline::span span("fact", name);
+        concurrency_state::guard lock(_concurrency.get(), _facts);
+
         resolve_fact(name);
 
         // Lookup the fact
         auto it = _facts.find(name);
+        if (_concurrency) {
+            _concurrency->settle(name, it != _facts.end());
+        }
         return it == _facts.end() ? nullptr : it->second.get();
     }
 
+    value const* collection::get_resolved_value(string const& name) const
+    {
+        if (_concurrency && !_concurrency->owned()) {
+            return _concurrency->load()->find(name);
+        }
+
+        // Lookup the fact without resolving
+        auto it = _facts.find(name);
+        return it == _facts.end() ? nullptr : it->second.get();
+    }
+
+    void collection::each_fact(function<bool(string const&, value const*)> const& func) const
+    {
+        if (_concurrency && !_concurrency->owned()) {
+            _concurrency->load()->each(func);
+            return;
+        }
+
+        for (auto const& kvp : _facts) {
+            if (!func(kvp.first, kvp.second.get())) {
+                return;
+            }
+        }
+    }
+
+    void collection::retire(unique_ptr<value> value)
+    {
+        // Concurrent readers may still hold the old value, so keep it alive until they are done with the snapshot
+        if (value && _concurrency) {
+            _concurrency->retired.emplace_back(move(value));
+        }
+    }
+
     value const* collection::query_value(string const& query, bool strict_errors)
     {
         // First attempt to lookup a fact with the exact name of the query
@@ -473,9 +1006,10 @@ namespace facter { namespace facts {
             }
         } else {
             // Print all facts in the map
-            for (auto const& kvp : _facts) {
-                writer(kvp.first, kvp.second.get());
-            }
+            each_fact([&](string const& name, value const* val) {
+                writer(name, val);
+                return true;
+            });
         }
     }
 
@@ -523,9 +1057,10 @@ namespace facter { namespace facts {
                 builder(query, this->query_value(query, strict_errors));
             }
         } else {
-            for (auto const& kvp : _facts) {
-                builder(kvp.first, kvp.second.get());
-            }
+            each_fact([&](string const& name, value const* val) {
+                builder(name, val);
+                return true;
+            });
         }
 
         stream_adapter adapter(stream);
@@ -536,23 +1071,19 @@ namespace facter { namespace facts {
 
     void collection::write_yaml(ostream& stream, set<string> const& queries, bool show_legacy, bool strict_errors)
     {
-        Emitter emitter(stream);
-        emitter << BeginMap;
+        yaml_writer output(stream);
+        output.begin_map();
 
         auto writer = ([&](string const& key, value const* val) {
             // Ignore facts with hidden values
             if (!show_legacy && queries.empty() && val && val->hidden()) {
                 return;
             }
-            emitter << Key;
-            if (needs_quotation(key)) {
-                emitter << DoubleQuoted;
-            }
-            emitter << key << YAML::Value;
+            output.key(key, needs_quotation(key));
             if (val) {
-                val->write(emitter);
+                val->write(output);
             } else {
-                emitter << DoubleQuoted << "";
+                output.write("", true);
             }
         });
 
@@ -566,11 +1097,12 @@ namespace facter { namespace facts {
                 writer(kvp.first, kvp.second);
             }
         } else {
-            for (auto const& kvp : _facts) {
-                writer(kvp.first, kvp.second.get());
-            }
+            each_fact([&](string const& name, value const* val) {
+                writer(name, val);
+                return true;
+            });
         }
-        emitter << EndMap;
+        output.end_map();
     }
 
     void collection::add_common_facts(bool include_ruby_facts)
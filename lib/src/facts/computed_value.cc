@@ -0,0 +1,131 @@
+#include <facter/facts/computed_value.hpp>
+#include <facter/facts/yaml_writer.hpp>
+#include <facter/util/string.hpp>
+#include <rapidjson/document.h>
+#include <yaml-cpp/yaml.h>
+#include <mutex>
+
+using namespace std;
+using namespace YAML;
+
+namespace facter { namespace facts {
+
+    // Formatting is rare and brief, so one lock serves every value rather than a lock per value
+    static mutex format_mutex;
+
+    computed_value::computed_value(formatter format, uint64_t value, uint64_t total, bool hidden) :
+        facter::facts::value(hidden),
+        _format(format),
+        _value(value),
+        _total(total),
+        _string(nullptr)
+    {
+    }
+
+    computed_value::~computed_value()
+    {
+        delete _string.load();
+    }
+
+    computed_value::computed_value(computed_value&& other) :
+        _format(nullptr),
+        _value(0),
+        _total(0),
+        _string(nullptr)
+    {
+        *this = std::move(other);
+    }
+
+    computed_value& computed_value::operator=(computed_value&& other)
+    {
+        value::operator=(static_cast<struct value&&>(other));
+        if (this != &other) {
+            _format = other._format;
+            _value = other._value;
+            _total = other._total;
+            // Take the other value's string if it was formatted; otherwise this value formats on demand
+            delete _string.exchange(other._string.exchange(nullptr));
+        }
+        return *this;
+    }
+
+    string computed_value::size(uint64_t value, uint64_t total)
+    {
+        return util::si_string(value);
+    }
+
+    string computed_value::percentage(uint64_t value, uint64_t total)
+    {
+        return util::percentage(value, total);
+    }
+
+    string computed_value::frequency(uint64_t value, uint64_t total)
+    {
+        return util::frequency(static_cast<int64_t>(value));
+    }
+
+    uint64_t computed_value::source() const
+    {
+        return _value;
+    }
+
+    string const& computed_value::value() const
+    {
+        auto str = _string.load(memory_order_acquire);
+        if (!str) {
+            lock_guard<mutex> lock(format_mutex);
+            str = _string.load(memory_order_relaxed);
+            if (!str) {
+                str = new string(_format ? _format(_value, _total) : string());
+                _string.store(str, memory_order_release);
+            }
+        }
+        return *str;
+    }
+
+    void computed_value::to_json(json_allocator& allocator, json_value& value) const
+    {
+        auto const& str = this->value();
+        value.SetString(str.c_str(), str.size());
+    }
+
+    ostream& computed_value::write(ostream& os, bool quoted, unsigned int level) const
+    {
+        if (quoted) {
+            os << '"';
+        }
+        os << value();
+        if (quoted) {
+            os << '"';
+        }
+        return os;
+    }
+
+    Emitter& computed_value::write(Emitter& emitter) const
+    {
+        auto const& str = value();
+        if (util::needs_quotation(str)) {
+            emitter << DoubleQuoted;
+        }
+        emitter << str;
+        return emitter;
+    }
+
+    yaml_writer& computed_value::write(yaml_writer& writer) const
+    {
+        auto const& str = value();
+        writer.write(str, util::needs_quotation(str));
+        return writer;
+    }
+
+    void computed_value::measure(memory_usage& usage) const
+    {
+        ++usage.nodes;
+        usage.node_bytes += sizeof(*this);
+        // Count the formatted string only if something has formatted it; measuring should not create it
+        if (auto str = _string.load(memory_order_acquire)) {
+            usage.string_bytes += sizeof(*str) + memory_usage::allocated(*str);
+        }
+    }
+
+}}  // namespace facter::facts
@@ -4,12 +4,12 @@
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/scalar_value.hpp>
 
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
 
 using namespace std;
-using namespace leatherman::execution;
+using namespace facter::execution;
 using namespace facter::facts;
 using namespace facter::facts::external;
 
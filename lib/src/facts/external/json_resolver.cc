@@ -82,7 +82,7 @@ namespace facter { namespace facts { namespace external {
         bool Key(const char* str, SizeType length, bool copy)
         {
             check_initialized();
-            _key = string(str, length);
+            _key.assign(str, length);
             return true;
         }
 
@@ -0,0 +1,261 @@
+#include <internal/facts/linux/cgroup_resolver.hpp>
+#include <internal/util/linux/sysfs.hpp>
+#include <internal/util/host.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+using namespace std;
+using namespace facter::util::linux;
+using boost::lexical_cast;
+using boost::bad_lexical_cast;
+
+namespace host = facter::util::host;
+
+namespace facter { namespace facts { namespace linux {
+
+    // Unset v1 memory limits read as LONG_MAX rounded down to a page; anything this large is unlimited
+    static const uint64_t unlimited_memory = 1ull << 62;
+
+    // A mounted control group hierarchy
+    struct cgroup_mount
+    {
+        string root;
+        string mount_point;
+    };
+
+    // The process's control group within the hierarchy that manages a controller
+    struct cgroup_hierarchy
+    {
+        cgroup_hierarchy() :
+            version(0)
+        {
+        }
+
+        unsigned int version;
+        string path;
+        string directory;
+        string mount_point;
+    };
+
+    static boost::optional<uint64_t> parse_limit(string const& value)
+    {
+        // Unlimited values are "max" (v2) or -1 (v1)
+        if (value.empty() || value == "max" || value[0] == '-') {
+            return boost::none;
+        }
+        try {
+            return lexical_cast<uint64_t>(value);
+        } catch (bad_lexical_cast&) {
+            return boost::none;
+        }
+    }
+
+    static void each_ancestor(string directory, string const& mount_point, function<bool(string const&)> callback)
+    {
+        while (callback(directory) && directory.size() > mount_point.size()) {
+            auto pos = directory.rfind('/');
+            directory.resize(pos == string::npos || pos < mount_point.size() ? mount_point.size() : pos);
+        }
+    }
+
+    static boost::optional<uint64_t> read_lowest_limit(cgroup_hierarchy const& hierarchy, string const& file)
+    {
+        boost::optional<uint64_t> lowest;
+        string buffer;
+        each_ancestor(hierarchy.directory, hierarchy.mount_point, [&](string const& directory) {
+            if (read_attribute(directory + "/" + file, buffer)) {
+                auto limit = parse_limit(buffer);
+                if (limit && (!lowest || *limit < *lowest)) {
+                    lowest = limit;
+                }
+            }
+            return true;
+        });
+        return lowest;
+    }
+
+    static cgroup_hierarchy find_hierarchy(map<string, string> const& paths, map<string, cgroup_mount> const& mounts, string const& controller)
+    {
+        // Controllers are keyed by name in v1 hierarchies and the unified hierarchy is keyed by an empty name
+        cgroup_hierarchy result;
+        auto resolve = [&](string const& key, unsigned int version) {
+            auto path = paths.find(key);
+            auto mount = mounts.find(key);
+            if (path == paths.end() || mount == mounts.end()) {
+                return false;
+            }
+
+            // The mount may expose only a subtree of the hierarchy (e.g. in a container without a cgroup namespace)
+            string relative = path->second;
+            auto const& root = mount->second.root;
+            if (root != "/") {
+                if (!boost::starts_with(relative, root) || (relative.size() > root.size() && relative[root.size()] != '/')) {
+                    LOG_DEBUG("control group %1% is not visible under %2%.", relative, mount->second.mount_point);
+                    return false;
+                }
+                relative.erase(0, root.size());
+            }
+            while (!relative.empty() && relative.back() == '/') {
+                relative.pop_back();
+            }
+
+            result.version = version;
+            result.path = path->second;
+            result.directory = mount->second.mount_point + relative;
+            result.mount_point = mount->second.mount_point;
+            return true;
+        };
+        if (!resolve(controller, 1)) {
+            resolve(string(), 2);
+        }
+        return result;
+    }
+
+    cgroup_resolver::data cgroup_resolver::collect_data(collection& facts)
+    {
+        data result;
+        collect_limits(result, "/proc/self/cgroup", "/proc/self/mountinfo", {});
+        return result;
+    }
+
+    void cgroup_resolver::collect_limits(data& result, string const& cgroup_path, string const& mountinfo_path, string const& root)
+    {
+        // Lines are in the form "hierarchy-ID:controller-list:cgroup-path"; v2 is "0::cgroup-path"
+        map<string, string> paths;
+        host::each_line(cgroup_path, [&](string& line) {
+            auto first = line.find(':');
+            auto second = first == string::npos ? string::npos : line.find(':', first + 1);
+            if (second == string::npos) {
+                return true;
+            }
+            auto path = line.substr(second + 1);
+            if (second == first + 1) {
+                paths[string()] = move(path);
+                return true;
+            }
+            vector<string> controllers;
+            boost::split(controllers, line.substr(first + 1, second - first - 1), boost::is_any_of(","));
+            for (auto& controller : controllers) {
+                paths[controller] = path;
+            }
+            return true;
+        });
+        if (paths.empty()) {
+            LOG_DEBUG("%1% could not be read: control group facts are unavailable.", cgroup_path);
+            return;
+        }
+
+        // Lines are in the form "id parent major:minor root mount-point options [optional...] - type source super-options"
+        map<string, cgroup_mount> mounts;
+        host::each_line(mountinfo_path, [&](string& line) {
+            vector<string> fields;
+            boost::split(fields, line, boost::is_space(), boost::token_compress_on);
+            auto separator = find(fields.begin(), fields.end(), "-");
+            if (separator == fields.end() || separator - fields.begin() < 6 || fields.end() - separator < 4) {
+                return true;
+            }
+            auto const& type = *(separator + 1);
+            cgroup_mount mount { fields[3], root + fields[4] };
+            if (type == "cgroup2") {
+                mounts.emplace(string{}, move(mount));
+            } else if (type == "cgroup") {
+                // v1 super options name the hierarchy's controllers
+                vector<string> options;
+                boost::split(options, *(separator + 3), boost::is_any_of(","));
+                for (auto& option : options) {
+                    mounts.emplace(move(option), mount);
+                }
+            }
+            return true;
+        });
+
+        string buffer;
+
+        // The most restrictive quota relative to its period applies
+        auto cpu = find_hierarchy(paths, mounts, "cpu");
+        auto lower_cpu_limit = [&](boost::optional<uint64_t> quota, boost::optional<uint64_t> period) {
+            if (!quota || !period || *period == 0) {
+                return;
+            }
+            if (!result.cpu_quota ||
+                static_cast<double>(*quota) / *period < static_cast<double>(*result.cpu_quota) / *result.cpu_period) {
+                result.cpu_quota = quota;
+                result.cpu_period = period;
+            }
+        };
+        if (cpu.version == 2) {
+            // cpu.max is in the form "quota period", where quota may be "max"
+            each_ancestor(cpu.directory, cpu.mount_point, [&](string const& directory) {
+                if (read_attribute(directory + "/cpu.max", buffer)) {
+                    vector<string> parts;
+                    boost::split(parts, buffer, boost::is_space(), boost::token_compress_on);
+                    if (parts.size() == 2) {
+                        lower_cpu_limit(parse_limit(parts[0]), parse_limit(parts[1]));
+                    }
+                }
+                return true;
+            });
+        } else if (cpu.version == 1) {
+            each_ancestor(cpu.directory, cpu.mount_point, [&](string const& directory) {
+                if (read_attribute(directory + "/cpu.cfs_quota_us", buffer)) {
+                    auto quota = parse_limit(buffer);
+                    if (quota && read_attribute(directory + "/cpu.cfs_period_us", buffer)) {
+                        lower_cpu_limit(quota, parse_limit(buffer));
+                    }
+                }
+                return true;
+            });
+        }
+
+        // The effective CPU list already accounts for ancestors, so the nearest one present is used
+        auto cpuset = find_hierarchy(paths, mounts, "cpuset");
+        if (cpuset.version != 0) {
+            vector<string> files;
+            if (cpuset.version == 2) {
+                files = { "cpuset.cpus.effective" };
+            } else {
+                files = { "cpuset.effective_cpus", "cpuset.cpus" };
+            }
+            each_ancestor(cpuset.directory, cpuset.mount_point, [&](string const& directory) {
+                for (auto const& file : files) {
+                    if (read_attribute(directory + "/" + file, buffer) && !buffer.empty()) {
+                        result.cpuset_cpus = buffer;
+                        result.cpuset_count = parse_cpu_list(buffer).size();
+                        return false;
+                    }
+                }
+                return true;
+            });
+        }
+
+        auto memory = find_hierarchy(paths, mounts, "memory");
+        if (memory.version == 2) {
+            result.memory_max = read_lowest_limit(memory, "memory.max");
+            result.memory_high = read_lowest_limit(memory, "memory.high");
+        } else if (memory.version == 1) {
+            result.memory_max = read_lowest_limit(memory, "memory.limit_in_bytes");
+            if (result.memory_max && *result.memory_max >= unlimited_memory) {
+                result.memory_max = boost::none;
+            }
+        }
+
+        auto pids = find_hierarchy(paths, mounts, "pids");
+        if (pids.version != 0) {
+            result.pids_max = read_lowest_limit(pids, "pids.max");
+        }
+
+        // Report the process's v1 control group if any controller is managed by a v1 hierarchy
+        for (auto hierarchy : { &cpu, &cpuset, &memory, &pids }) {
+            if (hierarchy->version != 0 && (result.version == 0 || hierarchy->version < result.version)) {
+                result.version = hierarchy->version;
+                result.path = hierarchy->path;
+            }
+        }
+    }
+
+}}}  // namespace facter::facts::linux
@@ -12,6 +12,8 @@
 #include <internal/facts/posix/timezone_resolver.hpp>
 #include <internal/facts/linux/filesystem_resolver.hpp>
 #include <internal/facts/linux/memory_resolver.hpp>
+#include <internal/facts/linux/cgroup_resolver.hpp>
+#include <internal/facts/linux/tunables_resolver.hpp>
 #include <internal/facts/glib/load_average_resolver.hpp>
 #include <internal/facts/posix/xen_resolver.hpp>
 
@@ -35,6 +37,8 @@ namespace facter { namespace facts {
         add(make_shared<posix::timezone_resolver>());
         add(make_shared<linux::filesystem_resolver>());
         add(make_shared<linux::memory_resolver>());
+        add(make_shared<linux::cgroup_resolver>());
+        add(make_shared<linux::tunables_resolver>());
         add(make_shared<glib::load_average_resolver>());
         add(make_shared<posix::xen_resolver>());
     }
@@ -1,6 +1,7 @@
 #include <internal/facts/linux/disk_resolver.hpp>
-#include <leatherman/file_util/file.hpp>
-#include <leatherman/file_util/directory.hpp>
+#include <internal/util/linux/sysfs.hpp>
+#include <internal/util/host.hpp>
+#include <facter/facts/collection.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/filesystem.hpp>
@@ -8,29 +9,85 @@
 
 using namespace std;
 using namespace boost::filesystem;
+using namespace facter::util::linux;
 using boost::lexical_cast;
 using boost::bad_lexical_cast;
 
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace linux {
 
+    static bool read_number(string const& path, string& buffer, uint64_t& value)
+    {
+        if (!read_attribute(path, buffer)) {
+            return false;
+        }
+        try {
+            value = lexical_cast<uint64_t>(buffer);
+            return true;
+        } catch (bad_lexical_cast&) {
+            return false;
+        }
+    }
+
+    // The scheduler attribute lists the available schedulers with the active one in brackets (e.g. "[none] kyber")
+    static string active_scheduler(string const& schedulers)
+    {
+        auto start = schedulers.find('[');
+        if (start == string::npos) {
+            return schedulers;
+        }
+        auto end = schedulers.find(']', start);
+        if (end == string::npos) {
+            return {};
+        }
+        return schedulers.substr(start + 1, end - start - 1);
+    }
+
     disk_resolver::data disk_resolver::collect_data(collection& facts)
     {
-        static string root_directory = "/sys/block";
+        return collect_disks("/sys/block", parse_attribute_groups(facts.get_option("disks-attributes")));
+    }
+
+    unsigned int disk_resolver::parse_attribute_groups(vector<string> const& names)
+    {
+        if (names.empty()) {
+            return queue;
+        }
+        unsigned int groups = none;
+        for (auto const& name : names) {
+            if (name == "queue") {
+                groups |= queue;
+            } else if (name == "scheduler") {
+                groups |= scheduler;
+            } else if (name == "nvme") {
+                groups |= nvme;
+            } else if (name == "mq") {
+                groups |= mq;
+            } else if (name == "all") {
+                groups |= queue | scheduler | nvme | mq;
+            } else if (name != "none") {
+                LOG_WARNING("unknown disk attribute group \"%1%\" is ignored.", name);
+            }
+        }
+        return groups;
+    }
 
+    disk_resolver::data disk_resolver::collect_disks(string const& root_directory, unsigned int groups)
+    {
         // The size of the block devices is in 512 byte blocks
         const int block_size = 512;
 
         data result;
 
-        boost::system::error_code ec;
-        if (!is_directory(root_directory, ec)) {
-            LOG_DEBUG("%1%: %2%: disk facts are unavailable.", root_directory, ec.message());
+        if (!host::is_directory(root_directory)) {
+            LOG_DEBUG("%1% is not a directory: disk facts are unavailable.", root_directory);
             return result;
         }
 
-        lth_file::each_subdirectory(root_directory, [&](string const& dir) {
+        // Attributes are read with one open and read each; missing attributes simply fail to open
+        string value;
+        host::each_subdirectory(root_directory, [&](string const& dir) {
             path device_directory(dir);
 
             disk d;
@@ -38,37 +95,66 @@ namespace facter { namespace facts { namespace linux {
 
             // Check for the device subdirectory's existence
             path device_subdirectory = device_directory / "device";
-            boost::system::error_code ec;
-            if (!is_directory(device_subdirectory, ec)) {
+            if (!host::is_directory(device_subdirectory.string())) {
                 return true;
             }
 
-            string size_file_path = (device_directory / "size").string();
-            string vendor_file_path = (device_subdirectory / "vendor").string();
-            string model_file_path = (device_subdirectory / "model").string();
+            string device_path = device_directory.string() + "/";
+            string device_subpath = device_subdirectory.string() + "/";
+            string queue_path = device_path + "queue/";
 
             // Read the size of the block device
             // The size is in 512 byte blocks
-            if (is_regular_file(size_file_path, ec)) {
+            if (read_attribute(device_path + "size", value)) {
                 try {
-                    string blocks = lth_file::read(size_file_path);
-                    boost::trim(blocks);
-                    d.size = lexical_cast<uint64_t>(blocks) * block_size;
+                    d.size = lexical_cast<uint64_t>(value) * block_size;
                 } catch (bad_lexical_cast& ex) {
                     LOG_DEBUG("size of disk %1% is invalid: size information is unavailable.", d.name);
                 }
             }
 
             // Read the vendor fact
-            if (is_regular_file(vendor_file_path, ec)) {
-                d.vendor = lth_file::read(vendor_file_path);
-                boost::trim(d.vendor);
+            if (read_attribute(device_subpath + "vendor", d.vendor)) {
+                boost::trim_left(d.vendor);
             }
 
             // Read the model fact
-            if (is_regular_file(model_file_path, ec)) {
-                d.model = lth_file::read(model_file_path);
-                boost::trim(d.model);
+            if (read_attribute(device_subpath + "model", d.model)) {
+                boost::trim_left(d.model);
+            }
+
+            if (groups & queue) {
+                if (read_attribute(queue_path + "rotational", value)) {
+                    d.rotational = value == "1";
+                }
+                read_number(queue_path + "logical_block_size", value, d.logical_block_size);
+                read_number(queue_path + "physical_block_size", value, d.physical_block_size);
+                uint64_t discard_max_bytes = 0;
+                if (read_number(queue_path + "discard_max_bytes", value, discard_max_bytes)) {
+                    d.discard = discard_max_bytes > 0;
+                }
+            }
+
+            if (groups & scheduler) {
+                if (read_attribute(queue_path + "scheduler", value)) {
+                    d.scheduler = active_scheduler(value);
+                }
+                read_number(queue_path + "nr_requests", value, d.nr_requests);
+                read_number(queue_path + "max_sectors_kb", value, d.max_sectors_kb);
+            }
+
+            // NVMe namespaces are named nvme<controller>n<namespace>; the device link is the controller
+            if ((groups & nvme) && boost::starts_with(d.name, "nvme")) {
+                read_number(device_path + "nsid", value, d.nvme_namespace);
+                read_attribute(device_subpath + "transport", d.nvme_transport);
+            }
+
+            // Each hardware queue of a multi-queue device has a numbered directory
+            if (groups & mq) {
+                host::each_subdirectory(device_path + "mq", [&](string const&) {
+                    ++d.hardware_queues;
+                    return true;
+                });
             }
 
             result.disks.emplace_back(move(d));
@@ -1,18 +1,14 @@
 #include <internal/facts/linux/dmi_resolver.hpp>
 #include <internal/util/agent.hpp>
-#include <leatherman/util/regex.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <leatherman/file_util/file.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <boost/filesystem.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <boost/algorithm/string.hpp>
+#include <cctype>
 
 using namespace std;
-using namespace boost::filesystem;
-namespace bs = boost::system;
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 using namespace facter::util;
-using namespace leatherman::util;
 
 namespace facter { namespace facts { namespace linux {
 
@@ -21,8 +17,7 @@ namespace facter { namespace facts { namespace linux {
         data result;
 
         // Check that /sys/class/dmi exists (requires kernel 2.6.23+)
-        bs::error_code ec;
-        if (exists("/sys/class/dmi/", ec)) {
+        if (host::exists("/sys/class/dmi/")) {
             result.bios_vendor          = read("/sys/class/dmi/id/bios_vendor");
             result.bios_version         = read("/sys/class/dmi/id/bios_version");
             result.bios_release_date    = read("/sys/class/dmi/id/bios_date");
@@ -41,7 +36,7 @@ namespace facter { namespace facts { namespace linux {
 
             int dmi_type = -1;
             string dmidecode = agent::which("dmidecode");
-            leatherman::execution::each_line(dmidecode, [&](string& line) {
+            facter::execution::each_line(dmidecode, [&](string& line) {
                 parse_dmidecode_output(result, line, dmi_type);
                 return true;
             });
@@ -49,10 +44,37 @@ namespace facter { namespace facts { namespace linux {
         return result;
     }
 
-    void dmi_resolver::parse_dmidecode_output(data& result, string& line, int& dmi_type)
+    bool dmi_resolver::parse_section_header(string const& line, int& dmi_type)
     {
-        static const boost::regex dmi_section_pattern("^Handle 0x.{4}, DMI type (\\d{1,3})");
+        // Equivalent to searching for ^Handle 0x.{4}, DMI type (\d{1,3}), where ^ also matches after a line separator
+        static const string prefix = "Handle 0x";
+        static const string separator = ", DMI type ";
+        size_t length = prefix.size() + 4 + separator.size();
+        for (size_t offset = 0; offset + length < line.size(); ++offset) {
+            if (offset > 0 && line[offset - 1] != '\r' && line[offset - 1] != '\n' && line[offset - 1] != '\f') {
+                continue;
+            }
+            if (line.compare(offset, prefix.size(), prefix) != 0 ||
+                line.compare(offset + prefix.size() + 4, separator.size(), separator) != 0) {
+                continue;
+            }
+
+            size_t start = offset + length;
+            size_t end = start;
+            while (end < line.size() && end - start < 3 && isdigit(static_cast<unsigned char>(line[end]))) {
+                ++end;
+            }
+            if (end == start) {
+                continue;
+            }
+            dmi_type = stoi(line.substr(start, end - start));
+            return true;
+        }
+        return false;
+    }
 
+    void dmi_resolver::parse_dmidecode_output(data& result, string& line, int& dmi_type)
+    {
         // Stores the relevant sections; this is in order based on DMI type ID
         // Ensure there's a trailing semicolon on each entry and keep in sync with the switch statement below
         static const vector<vector<string>> sections = {
@@ -83,7 +105,7 @@ namespace facter { namespace facts { namespace linux {
         };
 
         // Check for a section header
-        if (re_search(line, dmi_section_pattern, &dmi_type)) {
+        if (parse_section_header(line, dmi_type)) {
             return;
         }
 
@@ -171,14 +193,13 @@ namespace facter { namespace facts { namespace linux {
 
     string dmi_resolver::read(std::string const& path)
     {
-        bs::error_code ec;
-        if (!is_regular_file(path, ec)) {
-            LOG_DEBUG("%1%: %2%.", path, ec.message());
+        if (!host::is_regular_file(path)) {
+            LOG_DEBUG("%1% is not a regular file.", path);
             return {};
         }
 
         string value;
-        if (!lth_file::read(path, value)) {
+        if (!host::read(path, value)) {
             LOG_DEBUG("%1%: file could not be read.", path);
             return {};
         }
@@ -1,7 +1,8 @@
 #include <internal/facts/linux/filesystem_resolver.hpp>
 #include <internal/util/scoped_file.hpp>
-#include <leatherman/file_util/file.hpp>
-#include <leatherman/file_util/directory.hpp>
+#include <internal/util/host.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/util/string.hpp>
 #include <leatherman/util/regex.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
@@ -9,6 +10,7 @@
 #include <boost/lexical_cast.hpp>
 #include <mntent.h>
 #include <sys/vfs.h>
+#include <algorithm>
 #include <set>
 #include <map>
 
@@ -20,8 +22,7 @@ using namespace std;
 using namespace facter::facts;
 using namespace facter::util;
 using namespace boost::filesystem;
-namespace sys = boost::system;
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 using namespace leatherman::util;
 
 using boost::lexical_cast;
@@ -53,32 +54,72 @@ namespace facter { namespace facts { namespace linux {
         return result;
     }
 
+    filesystem_resolver::filters::filters(collection const& facts) :
+        _mountpoint_types(facts.get_option("mountpoints-exclude-types")),
+        _mountpoint_paths(facts.get_option("mountpoints-exclude-paths")),
+        _mountpoint_devices(facts.get_option("mountpoints-exclude-devices")),
+        _partition_devices(facts.get_option("partitions-exclude-devices"))
+    {
+        // Trailing slashes would prevent the path from matching itself
+        for (auto& path : _mountpoint_paths) {
+            while (path.size() > 1 && path.back() == '/') {
+                path.pop_back();
+            }
+        }
+    }
+
+    bool filesystem_resolver::filters::filters_partitions() const
+    {
+        return !_partition_devices.empty();
+    }
+
+    static bool matches_any(string const& str, vector<string> const& patterns)
+    {
+        return any_of(patterns.begin(), patterns.end(), [&](string const& pattern) {
+            return wildcard_match(str, pattern);
+        });
+    }
+
+    bool filesystem_resolver::filters::exclude_mountpoint(string const& path, string const& device, string const& filesystem) const
+    {
+        if (matches_any(filesystem, _mountpoint_types) || matches_any(device, _mountpoint_devices)) {
+            return true;
+        }
+        return any_of(_mountpoint_paths.begin(), _mountpoint_paths.end(), [&](string const& prefix) {
+            if (!boost::starts_with(path, prefix)) {
+                return false;
+            }
+            // Only match whole path components
+            return path.size() == prefix.size() || prefix.back() == '/' || path[prefix.size()] == '/';
+        });
+    }
+
+    bool filesystem_resolver::filters::exclude_partition(string const& device) const
+    {
+        return matches_any(device, _partition_devices);
+    }
+
     filesystem_resolver::data filesystem_resolver::collect_data(collection& facts)
     {
         data result;
-        collect_mountpoint_data(result);
+        filters filter(facts);
+        map<string, string> mounted_devices;
+        collect_mountpoint_data(result, filter, mounted_devices);
         collect_filesystem_data(result);
-        collect_partition_data(result);
+        collect_partition_data(result, filter, mounted_devices);
         return result;
     }
 
-    void filesystem_resolver::collect_mountpoint_data(data& result)
+    void filesystem_resolver::collect_mountpoint_data(data& result, filters const& filter, map<string, string>& mounted_devices)
     {
-        // Populate the mountpoint data
-        scoped_file file(setmntent("/etc/mtab", "r"));
-        if (!static_cast<FILE *>(file)) {
-            LOG_ERROR("setmntent failed: %1% (%2%): mountpoints are unavailable.", strerror(errno), errno);
-            return;
-        }
+        // Fills in a mountpoint from a mount table entry; returns false if the entry should not be reported
         string root_device;
-        mntent entry;
-        char buffer[4096];
-        while (mntent *ptr = getmntent_r(file, &entry, buffer, sizeof(buffer))) {
-            string device = ptr->mnt_fsname;
+        auto read_mountpoint = [&](mountpoint& point, char const* fsname, char const* directory, char const* type, char const* options) {
+            string device = fsname;
 
             // Skip over anything that doesn't map to a device
             if (!boost::starts_with(device, "/dev/")) {
-                continue;
+                return false;
             }
 
             // If the "root" device, lookup the actual device from the kernel options
@@ -86,7 +127,7 @@ namespace facter { namespace facts { namespace linux {
             if (device == "/dev/root") {
                 if (root_device.empty()) {
                     boost::regex root_pattern("root=([^\\s]+)");
-                    lth_file::each_line("/proc/cmdline", [&](string& line) {
+                    host::each_line("/proc/cmdline", [&](string& line) {
                         if (re_search(line, root_pattern, &root_device)) {
                             return false;
                         }
@@ -98,11 +139,67 @@ namespace facter { namespace facts { namespace linux {
                 }
             }
 
-            mountpoint point;
-            point.name = ptr->mnt_dir;
+            // Partitions report where they are mounted even if the mountpoint is filtered
+            mounted_devices.insert(make_pair(device, directory));
+
+            // Filtered mountpoints are not statted
+            if (filter.exclude_mountpoint(directory, device, type)) {
+                return false;
+            }
+
+            point.name = directory;
             point.device = std::move(device);
-            point.filesystem = ptr->mnt_type;
-            boost::split(point.options, ptr->mnt_opts, boost::is_any_of(","), boost::token_compress_on);
+            point.filesystem = type;
+            boost::split(point.options, options, boost::is_any_of(","), boost::token_compress_on);
+            return true;
+        };
+
+        // When replaying a host snapshot, the mount table comes from it along with the sizes from statfs
+        vector<host::call_record> mounts;
+        if (host::replay_call("getmntent", mounts)) {
+            for (auto& mount : mounts) {
+                mountpoint point;
+                if (!read_mountpoint(point, mount["fsname"].c_str(), mount["dir"].c_str(), mount["type"].c_str(), mount["opts"].c_str())) {
+                    continue;
+                }
+
+                // Only mountpoints that were statted when recording have sizes
+                try {
+                    point.size = lexical_cast<uint64_t>(mount["size"]);
+                    point.available = lexical_cast<uint64_t>(mount["available"]);
+                } catch (bad_lexical_cast&) {
+                }
+                result.mountpoints.emplace_back(move(point));
+            }
+            return;
+        }
+
+        // Populate the mountpoint data
+        scoped_file file(setmntent("/etc/mtab", "r"));
+        if (!static_cast<FILE *>(file)) {
+            LOG_ERROR("setmntent failed: %1% (%2%): mountpoints are unavailable.", strerror(errno), errno);
+            return;
+        }
+        bool recording = host::snapshot_active();
+        mntent entry;
+        char buffer[4096];
+        while (mntent *ptr = getmntent_r(file, &entry, buffer, sizeof(buffer))) {
+            // Only copy the entry when recording it into a host snapshot
+            host::call_record* record = nullptr;
+            if (recording) {
+                mounts.push_back({
+                    { "fsname", ptr->mnt_fsname },
+                    { "dir", ptr->mnt_dir },
+                    { "type", ptr->mnt_type },
+                    { "opts", ptr->mnt_opts }
+                });
+                record = &mounts.back();
+            }
+
+            mountpoint point;
+            if (!read_mountpoint(point, ptr->mnt_fsname, ptr->mnt_dir, ptr->mnt_type, ptr->mnt_opts)) {
+                continue;
+            }
 
             struct statfs stats;
             if (statfs(ptr->mnt_dir, &stats) != -1) {
@@ -110,16 +207,24 @@ namespace facter { namespace facts { namespace linux {
                               * static_cast<uint64_t>(stats.f_blocks));
                 point.available = (static_cast<uint64_t>(stats.f_frsize)
                                    * static_cast<uint64_t>(stats.f_bfree));
+                if (record) {
+                    (*record)["size"] = to_string(point.size);
+                    (*record)["available"] = to_string(point.available);
+                }
             }
 
             result.mountpoints.emplace_back(move(point));
         }
+
+        if (recording) {
+            host::record_call("getmntent", move(mounts));
+        }
     }
 
     void filesystem_resolver::collect_filesystem_data(data& result)
     {
         // Populate the partition data
-        lth_file::each_line("/proc/filesystems", [&](string &line) {
+        host::each_line("/proc/filesystems", [&](string &line) {
             boost::trim(line);
 
             // Ignore lines without devices or fuseblk
@@ -132,21 +237,18 @@ namespace facter { namespace facts { namespace linux {
         });
     }
 
-    void filesystem_resolver::collect_partition_data(data& result)
+    void filesystem_resolver::collect_partition_data(data& result, filters const& filter, map<string, string> const& mounted_devices)
     {
-        // Populate a map of device -> mountpoint
-        map<string, string> mountpoints;
-        for (auto const& point : result.mountpoints) {
-            mountpoints.insert(make_pair(point.device, point.name));
-        }
-
         void* cache = nullptr;
 
+        // When partitions are filtered, each partition is probed when it is collected instead of probing all devices up front
+        bool probe = filter.filters_partitions();
+
 #ifdef USE_BLKID
         blkid_cache actual = nullptr;
         if (blkid_get_cache(&actual, "/dev/null") == 0) {
             // Do a probe since we're not using a cache file
-            if (blkid_probe_all(actual) != 0) {
+            if (!probe && blkid_probe_all(actual) != 0) {
                 LOG_DEBUG("blkid_probe_all failed: partition attributes are not available.");
                 blkid_put_cache(actual);
                 actual = nullptr;
@@ -159,14 +261,13 @@ namespace facter { namespace facts { namespace linux {
         LOG_DEBUG("facter was built without libblkid support: partition attributes are not available.");
 #endif  // USE_BLKID
 
-        lth_file::each_subdirectory("/sys/block", [&](string const& subdirectory) {
+        host::each_subdirectory("/sys/block", [&](string const& subdirectory) {
             path block_device_path(subdirectory);
             auto block_device_filename = block_device_path.filename().string();
 
             // For devices, look up partition subdirectories
-            sys::error_code ec;
-            if (is_directory(block_device_path / "device", ec)) {
-                lth_file::each_subdirectory(subdirectory, [&](string const& subdirectory) {
+            if (host::is_directory((block_device_path / "device").string())) {
+                host::each_subdirectory(subdirectory, [&](string const& subdirectory) {
                     path partition_path(subdirectory);
                     auto partition_name = partition_path.filename().string();
 
@@ -177,14 +278,22 @@ namespace facter { namespace facts { namespace linux {
 
                     partition part;
                     part.name = "/dev/" + partition_name;
-                    populate_partition_attributes(part, subdirectory, cache, mountpoints);
+                    if (filter.exclude_partition(part.name)) {
+                        return true;
+                    }
+                    populate_partition_attributes(part, subdirectory, cache, probe, mounted_devices);
                     result.partitions.emplace_back(std::move(part));
                     return true;
                 });
-            } else if (is_directory(block_device_path / "dm", ec)) {
+            } else if (host::is_directory((block_device_path / "dm").string())) {
+                // Mapped devices can be filtered by either their kernel name or their mapping name
+                if (filter.exclude_partition("/dev/" + block_device_filename)) {
+                    return true;
+                }
+
                 // For mapped devices, lookup the mapping name
                 partition part;
-                string mapping_name = lth_file::read((block_device_path / "dm" / "name").string());
+                string mapping_name = host::read((block_device_path / "dm" / "name").string());
                 boost::trim(mapping_name);
                 if (mapping_name.empty()) {
                     mapping_name = "/dev/" + block_device_filename;
@@ -192,17 +301,23 @@ namespace facter { namespace facts { namespace linux {
                     mapping_name = "/dev/mapper/" + mapping_name;
                 }
                 part.name = std::move(mapping_name);
+                if (filter.exclude_partition(part.name)) {
+                    return true;
+                }
 
-                populate_partition_attributes(part, block_device_path.string(), cache, mountpoints);
+                populate_partition_attributes(part, block_device_path.string(), cache, probe, mounted_devices);
                 result.partitions.emplace_back(std::move(part));
-            } else if (is_directory(block_device_path / "loop")) {
+            } else if (host::is_directory((block_device_path / "loop").string())) {
                 // Lookup the backing file
                 partition part;
                 part.name = "/dev/" + block_device_filename;
-                part.backing_file = lth_file::read((block_device_path / "loop" / "backing_file").string());
+                if (filter.exclude_partition(part.name)) {
+                    return true;
+                }
+                part.backing_file = host::read((block_device_path / "loop" / "backing_file").string());
                 boost::trim(part.backing_file);
 
-                populate_partition_attributes(part, block_device_path.string(), cache, mountpoints);
+                populate_partition_attributes(part, block_device_path.string(), cache, probe, mounted_devices);
                 result.partitions.emplace_back(std::move(part));
             }
             return true;
@@ -217,11 +332,11 @@ namespace facter { namespace facts { namespace linux {
 #endif  // USE_BLKID
     }
 
-    void filesystem_resolver::populate_partition_attributes(partition& part, string const& device_directory, void* cache, map<string, string> const& mountpoints)
+    void filesystem_resolver::populate_partition_attributes(partition& part, string const& device_directory, void* cache, bool probe, map<string, string> const& mountpoints)
     {
 #ifdef USE_BLKID
         if (cache) {
-            auto device = blkid_get_dev(static_cast<blkid_cache>(cache), part.name.c_str(), 0);
+            auto device = blkid_get_dev(static_cast<blkid_cache>(cache), part.name.c_str(), probe ? BLKID_DEV_NORMAL : 0);
             if (!device) {
                 LOG_DEBUG("blkid_get_dev failed: partition attributes are unavailable for '%1%'.", part.name);
             } else {
@@ -266,7 +381,7 @@ namespace facter { namespace facts { namespace linux {
         const int block_size = 512;
 
         // Read the size
-        string blocks = lth_file::read(device_directory + "/size");
+        string blocks = host::read(device_directory + "/size");
         boost::trim(blocks);
         if (!blocks.empty()) {
             try {
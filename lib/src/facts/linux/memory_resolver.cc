@@ -1,21 +1,23 @@
 #include <internal/facts/linux/memory_resolver.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/util/host.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
 
 using namespace std;
 
 using boost::lexical_cast;
 using boost::bad_lexical_cast;
 
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace linux {
 
     memory_resolver::data memory_resolver::collect_data(collection& facts)
     {
         data result;
-        lth_file::each_line("/proc/meminfo", [&](string& line) {
+        host::each_line("/proc/meminfo", [&](string& line) {
             uint64_t* variable = nullptr;
             if (boost::starts_with(line, "MemTotal:")) {
                 variable = &result.mem_total;
@@ -44,7 +46,54 @@ namespace facter { namespace facts { namespace linux {
             }
             return true;
         });
+
+        collect_numa_data(result, "/sys/devices/system/node");
         return result;
     }
 
+    void memory_resolver::collect_numa_data(data& result, string const& root)
+    {
+        host::each_subdirectory(root, [&](string const& directory) {
+            auto name = boost::filesystem::path(directory).filename().string();
+            if (name.size() <= 4 || !boost::starts_with(name, "node") ||
+                !all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                return true;
+            }
+
+            // Lines are in the form "Node 0 MemTotal:       32780412 kB"
+            numa_node node;
+            node.name = move(name);
+            host::each_line(directory + "/meminfo", [&](string& line) {
+                vector<boost::iterator_range<string::iterator>> parts;
+                boost::split(parts, line, boost::is_space(), boost::token_compress_on);
+                if (parts.size() < 4) {
+                    return true;
+                }
+
+                uint64_t* variable = nullptr;
+                if (parts[2] == boost::as_literal("MemTotal:")) {
+                    variable = &node.mem_total;
+                } else if (parts[2] == boost::as_literal("MemFree:") || parts[2] == boost::as_literal("FilePages:")) {
+                    variable = &node.mem_free;
+                }
+                if (!variable) {
+                    return true;
+                }
+
+                try {
+                    *variable += lexical_cast<uint64_t>(parts[3]) * 1024;
+                } catch (bad_lexical_cast&) {
+                }
+                return true;
+            });
+            // Page cache is counted as available, but never more than the node has
+            node.mem_free = min(node.mem_free, node.mem_total);
+            result.numa_nodes.emplace_back(move(node));
+            return true;
+        });
+        sort(result.numa_nodes.begin(), result.numa_nodes.end(), [](numa_node const& left, numa_node const& right) {
+            return stoi(left.name.substr(4)) < stoi(right.name.substr(4));
+        });
+    }
+
 }}}  // namespace facter::facts::linux
@@ -1,24 +1,167 @@
 #include <internal/facts/linux/networking_resolver.hpp>
 #include <internal/util/posix/scoped_descriptor.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <algorithm>
 #include <cstring>
 #include <unordered_set>
 #include <netpacket/packet.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/ethtool.h>
+#include <linux/sockios.h>
 
 using namespace std;
 using namespace facter::util::posix;
+using boost::lexical_cast;
+using boost::bad_lexical_cast;
 
-namespace lth_file = leatherman::file_util;
-namespace lth_exe  = leatherman::execution;
+namespace host = facter::util::host;
+namespace lth_exe  = facter::execution;
 
 namespace facter { namespace facts { namespace linux {
 
+    // Issues an ethtool command for an interface
+    static bool ethtool_ioctl(int sock, string const& name, void* command)
+    {
+        ifreq req;
+        memset(&req, 0, sizeof(req));
+        strncpy(req.ifr_name, name.c_str(), sizeof(req.ifr_name) - 1);
+        req.ifr_data = reinterpret_cast<char*>(command);
+        return ioctl(sock, SIOCETHTOOL, &req) == 0;
+    }
+
+    // The ethtool structures end in variable-length arrays, so they are placed in suitably aligned buffers
+    template <typename T>
+    static T* ethtool_buffer(vector<uint64_t>& buffer, size_t extra)
+    {
+        buffer.assign((sizeof(T) + extra + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+        return reinterpret_cast<T*>(buffer.data());
+    }
+
+    // The positions of the offload features in the kernel's feature set, which is the same for every interface
+    struct offload_features
+    {
+        offload_features() :
+            loaded(false),
+            count(0),
+            tso(-1),
+            gro(-1),
+            lro(-1)
+        {
+        }
+
+        // Loading is retried with the next interface until it succeeds, as some drivers do not report their features
+        bool load(int sock, string const& name)
+        {
+            vector<uint64_t> buffer;
+            auto info = ethtool_buffer<ethtool_sset_info>(buffer, sizeof(uint32_t));
+            info->cmd = ETHTOOL_GSSET_INFO;
+            info->sset_mask = 1ull << ETH_SS_FEATURES;
+            if (!ethtool_ioctl(sock, name, info) || !(info->sset_mask & (1ull << ETH_SS_FEATURES))) {
+                return false;
+            }
+            count = info->data[0];
+
+            auto strings = ethtool_buffer<ethtool_gstrings>(buffer, count * ETH_GSTRING_LEN);
+            strings->cmd = ETHTOOL_GSTRINGS;
+            strings->string_set = ETH_SS_FEATURES;
+            strings->len = count;
+            if (!ethtool_ioctl(sock, name, strings)) {
+                count = 0;
+                return false;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                auto feature = reinterpret_cast<char const*>(strings->data + i * ETH_GSTRING_LEN);
+                if (strncmp(feature, "tx-tcp-segmentation", ETH_GSTRING_LEN) == 0) {
+                    tso = static_cast<int>(i);
+                } else if (strncmp(feature, "rx-gro", ETH_GSTRING_LEN) == 0) {
+                    gro = static_cast<int>(i);
+                } else if (strncmp(feature, "rx-lro", ETH_GSTRING_LEN) == 0) {
+                    lro = static_cast<int>(i);
+                }
+            }
+            loaded = true;
+            return true;
+        }
+
+        bool loaded;
+        uint32_t count;
+        int tso;
+        int gro;
+        int lro;
+    };
+
+    static void get_link_settings(int sock, string const& name, boost::optional<uint64_t>& link_speed, string& link_duplex)
+    {
+        uint32_t speed = 0;
+        uint8_t duplex = DUPLEX_UNKNOWN;
+#ifdef ETHTOOL_GLINKSETTINGS
+        // The kernel first reports the size of its link mode masks, then fills them in
+        vector<uint64_t> buffer;
+        auto settings = ethtool_buffer<ethtool_link_settings>(buffer, 3 * 127 * sizeof(uint32_t));
+        settings->cmd = ETHTOOL_GLINKSETTINGS;
+        bool have_settings = false;
+        if (ethtool_ioctl(sock, name, settings) && settings->link_mode_masks_nwords < 0) {
+            settings->cmd = ETHTOOL_GLINKSETTINGS;
+            settings->link_mode_masks_nwords = -settings->link_mode_masks_nwords;
+            have_settings = ethtool_ioctl(sock, name, settings) && settings->link_mode_masks_nwords > 0;
+        }
+        if (have_settings) {
+            speed = settings->speed;
+            duplex = settings->duplex;
+        } else
+#endif
+        {
+            ethtool_cmd command;
+            memset(&command, 0, sizeof(command));
+            command.cmd = ETHTOOL_GSET;
+            if (!ethtool_ioctl(sock, name, &command)) {
+                return;
+            }
+            speed = ethtool_cmd_speed(&command);
+            duplex = command.duplex;
+        }
+
+        // Links that are down report an unknown speed and duplex
+        if (speed != 0 && speed != static_cast<uint32_t>(SPEED_UNKNOWN)) {
+            link_speed = speed;
+        }
+        if (duplex == DUPLEX_FULL) {
+            link_duplex = "full";
+        } else if (duplex == DUPLEX_HALF) {
+            link_duplex = "half";
+        }
+    }
+
+    static void get_offloads(int sock, string const& name, offload_features const& features, boost::optional<bool>& tso, boost::optional<bool>& gro, boost::optional<bool>& lro)
+    {
+        if (features.count == 0) {
+            return;
+        }
+        vector<uint64_t> buffer;
+        uint32_t blocks = (features.count + 31) / 32;
+        auto command = ethtool_buffer<ethtool_gfeatures>(buffer, blocks * sizeof(ethtool_get_features_block));
+        command->cmd = ETHTOOL_GFEATURES;
+        command->size = blocks;
+        if (!ethtool_ioctl(sock, name, command)) {
+            return;
+        }
+        auto active = [&](int feature) -> boost::optional<bool> {
+            if (feature < 0) {
+                return boost::none;
+            }
+            return (command->features[feature / 32].active & (1u << (feature % 32))) != 0;
+        };
+        tso = active(features.tso);
+        gro = active(features.gro);
+        lro = active(features.lro);
+    }
+
     networking_resolver::data networking_resolver::collect_data(collection& facts)
     {
         read_routing_table();
@@ -34,7 +177,7 @@ namespace facter { namespace facts { namespace linux {
             auto bond_master = get_bond_master(interface.name);
             if (!bond_master.empty()) {
                 bool in_our_block = false;
-                lth_file::each_line("/proc/net/bonding/"+bond_master, [&](string& line) {
+                host::each_line("/proc/net/bonding/"+bond_master, [&](string& line) {
                     // /proc/net/bonding files are organized into chunks for each slave
                     // interface. We want to grab the mac address for the block we're in.
                     if (line == "Slave Interface: " + interface.name) {
@@ -53,9 +196,74 @@ namespace facter { namespace facts { namespace linux {
                 });
             }
         }
+
+        collect_ethtool_data(result);
         return result;
     }
 
+    void networking_resolver::collect_ethtool_data(data& result) const
+    {
+        // The ethtool ioctls are not recorded in host snapshots, so a replayed host has no driver facts
+        if (host::snapshot_replaying()) {
+            return;
+        }
+
+        // One socket is used for every interface
+        scoped_descriptor sock(socket(AF_INET, SOCK_DGRAM, 0));
+        if (static_cast<int>(sock) < 0) {
+            LOG_DEBUG("socket failed: %1% (%2%): interface driver facts are unavailable.", strerror(errno), errno);
+            return;
+        }
+
+        offload_features features;
+        for (auto& iface : result.interfaces) {
+            // Only interfaces backed by a device have a driver and NIC attributes; virtual interfaces are skipped
+            if (access(("/sys/class/net/" + iface.name + "/device").c_str(), F_OK) != 0) {
+                continue;
+            }
+
+            ethtool_drvinfo info;
+            memset(&info, 0, sizeof(info));
+            info.cmd = ETHTOOL_GDRVINFO;
+            if (!ethtool_ioctl(sock, iface.name, &info)) {
+                LOG_DEBUG("ethtool is not supported for interface %1%: %2% (%3%).", iface.name, strerror(errno), errno);
+                continue;
+            }
+            iface.driver.assign(info.driver, strnlen(info.driver, sizeof(info.driver)));
+            iface.driver_version.assign(info.version, strnlen(info.version, sizeof(info.version)));
+            iface.firmware_version.assign(info.fw_version, strnlen(info.fw_version, sizeof(info.fw_version)));
+            if (iface.firmware_version == "N/A") {
+                iface.firmware_version.clear();
+            }
+
+            get_link_settings(sock, iface.name, iface.speed, iface.duplex);
+
+            ethtool_channels channels;
+            memset(&channels, 0, sizeof(channels));
+            channels.cmd = ETHTOOL_GCHANNELS;
+            if (ethtool_ioctl(sock, iface.name, &channels)) {
+                iface.rx_queues = channels.rx_count;
+                iface.tx_queues = channels.tx_count;
+                iface.combined_queues = channels.combined_count;
+            }
+
+            ethtool_ringparam rings;
+            memset(&rings, 0, sizeof(rings));
+            rings.cmd = ETHTOOL_GRINGPARAM;
+            if (ethtool_ioctl(sock, iface.name, &rings)) {
+                iface.rx_ring = rings.rx_pending;
+                iface.rx_ring_max = rings.rx_max_pending;
+                iface.tx_ring = rings.tx_pending;
+                iface.tx_ring_max = rings.tx_max_pending;
+            }
+
+            if (!features.loaded) {
+                features.load(sock, iface.name);
+            }
+            get_offloads(sock, iface.name, features, iface.tso, iface.gro, iface.lro);
+        }
+    }
+
     bool networking_resolver::is_link_address(sockaddr const* addr) const
     {
         return addr && addr->sa_family == AF_PACKET;
@@ -76,7 +284,20 @@ namespace facter { namespace facts { namespace linux {
     boost::optional<uint64_t> networking_resolver::get_link_mtu(string const& interface, void* data) const
     {
         // Unfortunately in Linux, the data points at interface statistics
-        // Nothing useful for us, so we need to use ioctl to query the MTU
+        // Nothing useful for us, so the MTU is read from sysfs, which host snapshots capture
+        string mtu;
+        if (host::read("/sys/class/net/" + interface + "/mtu", mtu)) {
+            boost::trim(mtu);
+            try {
+                return lexical_cast<uint64_t>(mtu);
+            } catch (bad_lexical_cast&) {
+            }
+        }
+        if (host::snapshot_replaying()) {
+            return boost::none;
+        }
+
+        // Fall back to the ioctl when sysfs is unavailable
         ifreq req;
         memset(&req, 0, sizeof(req));
         strncpy(req.ifr_name, interface.c_str(), sizeof(req.ifr_name));
@@ -107,7 +328,7 @@ namespace facter { namespace facts { namespace linux {
         // We consider the primary interface to be the one that has 0.0.0.0 as the
         // routing destination.
         string interface;
-        lth_file::each_line("/proc/net/route", [&interface](string& line) {
+        host::each_line("/proc/net/route", [&interface](string& line) {
             vector<boost::iterator_range<string::iterator>> parts;
             boost::split(parts, line, boost::is_space(), boost::token_compress_on);
             if (parts.size() > 7 && parts[1] == boost::as_literal("00000000")
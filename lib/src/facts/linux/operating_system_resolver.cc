@@ -8,10 +8,9 @@
 #include <facter/facts/scalar_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/collection.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/util/regex.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 #include <map>
 #include <vector>
@@ -19,11 +18,10 @@
 #include <memory>
 
 using namespace std;
-using namespace leatherman::execution;
-using namespace boost::filesystem;
+using namespace facter::execution;
 using namespace leatherman::util;
 
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace linux {
 
@@ -37,8 +35,7 @@ namespace facter { namespace facts { namespace linux {
             return unique_ptr<os_linux>(new os_coreos());
         } else {
             auto const& cisco = release_info["CISCO_RELEASE_INFO"];
-            boost::system::error_code ec;
-            if (!cisco.empty() && is_regular_file(cisco, ec)) {
+            if (!cisco.empty() && host::is_regular_file(cisco)) {
                 return unique_ptr<os_linux>(new os_cisco(cisco));
             }
         }
@@ -49,7 +46,7 @@ namespace facter { namespace facts { namespace linux {
     {
         static boost::regex regexp("\\S+ (\\S+) selinuxfs");
         string mountpoint;
-        lth_file::each_line("/proc/self/mounts", [&](string& line) {
+        host::each_line("/proc/self/mounts", [&](string& line) {
             if (re_search(line, regexp, &mountpoint)) {
                 return false;
             }
@@ -70,10 +67,10 @@ namespace facter { namespace facts { namespace linux {
         }
 
         // Get the policy version
-        result.policy_version = lth_file::read(mountpoint + "/policyvers");
+        result.policy_version = host::read(mountpoint + "/policyvers");
 
         // Check for enforcement
-        string enforce = lth_file::read(mountpoint + "/enforce");
+        string enforce = host::read(mountpoint + "/enforce");
         if (!enforce.empty()) {
             if (enforce == "1") {
                 result.enforced = true;
@@ -86,7 +83,7 @@ namespace facter { namespace facts { namespace linux {
         // Parse the SELinux config for mode and policy
         static boost::regex mode_regex("(?m)^SELINUX=(\\w+)$");
         static boost::regex policy_regex("(?m)^SELINUXTYPE=(\\w+)$");
-        lth_file::each_line("/etc/selinux/config", [&](string& line) {
+        host::each_line("/etc/selinux/config", [&](string& line) {
             if (re_search(line, mode_regex, &result.config_mode)) {
                 return true;
             }
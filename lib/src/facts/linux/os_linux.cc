@@ -2,20 +2,17 @@
 #include <internal/facts/resolvers/operating_system_resolver.hpp>
 #include <facter/facts/os.hpp>
 #include <facter/facts/os_family.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/util/regex.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 #include <vector>
 
 using namespace std;
-using namespace leatherman::execution;
-using namespace boost::filesystem;
+using namespace facter::execution;
 using namespace leatherman::util;
 
-namespace bs = boost::system;
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace linux {
 
@@ -24,11 +21,10 @@ namespace facter { namespace facts { namespace linux {
     map<string, string> os_linux::key_value_file(string file, set<string> const& items)
     {
         map<string, string> values;
-        bs::error_code ec;
-        if (!items.empty() && is_regular_file(file, ec)) {
+        if (!items.empty() && host::is_regular_file(file)) {
             string key, value;
-            lth_file::each_line(file, [&](string& line) {
-                if (re_search(line, boost::regex("(?m)^(\\w+)=[\"']?(.+?)[\"']?$"), &key, &value)) {
+            host::each_line(file, [&](string& line) {
+                if (parse_key_value(line, key, value)) {
                     if (items.count(key)) {
                         values.insert(make_pair(key, value));
                     }
@@ -39,18 +35,57 @@ namespace facter { namespace facts { namespace linux {
         return values;
     }
 
+    static bool is_line_separator(char c)
+    {
+        return c == '\n' || c == '\r' || c == '\f';
+    }
+
+    bool os_linux::parse_key_value(string const& line, string& key, string& value)
+    {
+        // This matches the same lines as searching for (?m)^(\w+)=["']?(.+?)["']?$ without compiling a regex per line
+        auto is_end = [&](size_t i) { return i == line.size() || is_line_separator(line[i]); };
+        auto is_quote = [](char c) { return c == '"' || c == '\''; };
+
+        for (size_t start = 0; start < line.size(); ++start) {
+            if (start > 0 && !is_line_separator(line[start - 1])) {
+                continue;
+            }
+
+            size_t equals = start;
+            while (equals < line.size() && (isalnum(static_cast<unsigned char>(line[equals])) || line[equals] == '_')) {
+                ++equals;
+            }
+            if (equals == start || equals == line.size() || line[equals] != '=') {
+                continue;
+            }
+
+            // Try skipping an opening quote first, then try without skipping it
+            size_t first = equals + 1;
+            for (size_t begin : { first + (first < line.size() && is_quote(line[first]) ? 1 : 0), first }) {
+                // The value is the shortest non-empty run ending at the end of the line or before a closing quote
+                for (size_t end = begin + 1; end <= line.size(); ++end) {
+                    if (is_end(end) || (is_quote(line[end]) && is_end(end + 1))) {
+                        key = line.substr(start, equals - start);
+                        value = line.substr(begin, end - begin);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
     os_linux::os_linux(std::set<std::string> items, std::string file) :
             _release_info(key_value_file(file, items)) {}
 
     static string check_debian_linux(string const& distro_id)
     {
         // Check for Debian variants
-        bs::error_code ec;
-        if (is_regular_file(release_file::huawei, ec)) {
+        if (host::is_regular_file(release_file::huawei)) {
           return os::huawei;
         }
 
-        if (is_regular_file(release_file::debian, ec)) {
+        if (host::is_regular_file(release_file::debian)) {
             if (distro_id == os::ubuntu || distro_id == os::linux_mint) {
                 return distro_id;
             }
@@ -61,9 +96,8 @@ namespace facter { namespace facts { namespace linux {
 
     static string check_oracle_linux()
     {
-        bs::error_code ec;
-        if (is_regular_file(release_file::oracle_enterprise_linux, ec)) {
-            if (is_regular_file(release_file::oracle_vm_linux, ec)) {
+        if (host::is_regular_file(release_file::oracle_enterprise_linux)) {
+            if (host::is_regular_file(release_file::oracle_vm_linux)) {
                 return os::oracle_vm_linux;
             }
             return os::oracle_enterprise_linux;
@@ -73,8 +107,7 @@ namespace facter { namespace facts { namespace linux {
 
     static string check_redhat_linux()
     {
-        bs::error_code ec;
-        if (is_regular_file(release_file::redhat, ec)) {
+        if (host::is_regular_file(release_file::redhat)) {
             static vector<tuple<boost::regex, string>> const regexs {
                 make_tuple(boost::regex("(?i)centos"),                        string(os::centos)),
                 make_tuple(boost::regex("(?i)scientific linux CERN"),         string(os::scientific_cern)),
@@ -87,7 +120,7 @@ namespace facter { namespace facts { namespace linux {
                 make_tuple(boost::regex("(?m)^Fedora release"),               string(os::fedora)),
             };
 
-            string contents = lth_file::read(release_file::redhat);
+            string contents = host::read(release_file::redhat);
             boost::trim(contents);
             for (auto const& regex : regexs) {
                 if (re_search(contents, get<0>(regex))) {
@@ -101,7 +134,7 @@ namespace facter { namespace facts { namespace linux {
 
     static string check_photon_linux()
     {
-        string contents = lth_file::read(release_file::lsb);
+        string contents = host::read(release_file::lsb);
         boost::trim(contents);
         if (re_search(contents, boost::regex("VMware Photon"))) {
             return string(os::photon_os);
@@ -111,15 +144,14 @@ namespace facter { namespace facts { namespace linux {
 
     static string check_suse_linux()
     {
-        bs::error_code ec;
-        if (is_regular_file(release_file::suse, ec)) {
+        if (host::is_regular_file(release_file::suse)) {
             static vector<tuple<boost::regex, string>> const regexs {
                 make_tuple(boost::regex("(?im)^SUSE LINUX Enterprise Server"),  string(os::suse_enterprise_server)),
                 make_tuple(boost::regex("(?im)^SUSE LINUX Enterprise Desktop"), string(os::suse_enterprise_desktop)),
                 make_tuple(boost::regex("(?im)^openSUSE"),                      string(os::open_suse)),
             };
 
-            string contents = lth_file::read(release_file::suse);
+            string contents = host::read(release_file::suse);
             boost::trim(contents);
             for (auto const& regex : regexs) {
                 if (re_search(contents, get<0>(regex))) {
@@ -150,8 +182,7 @@ namespace facter { namespace facts { namespace linux {
         };
 
         for (auto const& file : files) {
-            bs::error_code ec;
-            if (is_regular_file(get<0>(file), ec)) {
+            if (host::is_regular_file(get<0>(file))) {
                 return get<1>(file);
             }
         }
@@ -160,8 +191,7 @@ namespace facter { namespace facts { namespace linux {
 
     static string check_amazon()
     {
-        bs::error_code ec;
-        if (is_regular_file(release_file::amazon, ec)) {
+        if (host::is_regular_file(release_file::amazon)) {
             return os::amazon;
         }
         return {};
@@ -271,7 +301,7 @@ namespace facter { namespace facts { namespace linux {
         auto it = release_files.find(name);
         if (it != release_files.end()) {
             string contents;
-            if (lth_file::each_line(it->second, [&](string& line) {
+            if (host::each_line(it->second, [&](string& line) {
                 // We only need the first line
                 contents = move(line);
                 return false;
@@ -286,19 +316,19 @@ namespace facter { namespace facts { namespace linux {
 
         // Debian uses the entire contents of the release file as the version
         if (value.empty() && name == os::debian) {
-            value = lth_file::read(release_file::debian);
+            value = host::read(release_file::debian);
             boost::trim_right(value);
         }
 
         // Alpine uses the entire contents of the release file as the version
         if (value.empty() && name == os::alpine) {
-            value = lth_file::read(release_file::alpine);
+            value = host::read(release_file::alpine);
             boost::trim_right(value);
         }
 
         // HuaweiOS uses the entire contents of the release file as the version
         if (value.empty() && name == os::huawei) {
-            value = lth_file::read(release_file::huawei);
+            value = host::read(release_file::huawei);
             boost::trim_right(value);
         }
 
@@ -308,7 +338,7 @@ namespace facter { namespace facts { namespace linux {
                 name == os::suse_enterprise_server ||
                 name == os::suse_enterprise_desktop ||
                 name == os::open_suse)) {
-            string contents = lth_file::read(release_file::suse);
+            string contents = host::read(release_file::suse);
             string major;
             string minor;
             if (re_search(contents, boost::regex("(?m)^VERSION\\s*=\\s*(\\d+)\\.?(\\d+)?"), &major, &minor)) {
@@ -325,7 +355,7 @@ namespace facter { namespace facts { namespace linux {
         }
         if (value.empty() && name == os::photon_os) {
             string major, minor;
-            string contents = lth_file::read(release_file::lsb);
+            string contents = host::read(release_file::lsb);
             string pattern = "DISTRIB_RELEASE=\"(\\d+)\\.(\\d+)( ([a-zA-Z]+\\d+))?\"";
             if (re_search(contents, boost::regex(pattern), &major, &minor)) {
                 value = major + "." + minor;
@@ -356,7 +386,7 @@ namespace facter { namespace facts { namespace linux {
                 pattern = "Arista Networks EOS (\\d+\\.\\d+\\.\\d+[A-M]?)";
             }
             if (file) {
-                string contents = lth_file::read(file);
+                string contents = host::read(file);
                 re_search(contents, pattern, &value);
             }
         }
@@ -1,41 +1,300 @@
 #include <internal/facts/linux/processor_resolver.hpp>
+#include <internal/util/linux/sysfs.hpp>
+#include <internal/util/host.hpp>
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/os.hpp>
 #include <facter/facts/scalar_value.hpp>
-#include <leatherman/file_util/file.hpp>
-#include <leatherman/file_util/directory.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <unordered_set>
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
 
 using namespace std;
 using namespace boost::filesystem;
+using namespace facter::util::linux;
 
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace linux {
 
+    bool processor_resolver::is_cpu_directory(string const& name)
+    {
+        // Equivalent to ^cpu\d+$ without compiling a regex
+        if (name.size() <= 3 || name.compare(0, 3, "cpu") != 0) {
+            return false;
+        }
+        return all_of(name.begin() + 3, name.end(), [](char c) { return c >= '0' && c <= '9'; });
+    }
+
+    static bool is_node_directory(string const& name)
+    {
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0) {
+            return false;
+        }
+        return all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; });
+    }
+
+    // Parses a cache size attribute (e.g. "32K") into bytes
+    static uint64_t parse_cache_size(string const& value)
+    {
+        char* end = nullptr;
+        uint64_t size = strtoull(value.c_str(), &end, 10);
+        if (end == value.c_str()) {
+            return 0;
+        }
+        switch (*end) {
+            case '\0':
+                return size;
+            case 'K':
+                return size * 1024;
+            case 'M':
+                return size * 1024 * 1024;
+            case 'G':
+                return size * 1024 * 1024 * 1024;
+            default:
+                return 0;
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // The register state the OS must save for a feature to be usable
+    enum class xstate
+    {
+        none,
+        avx,
+        avx512,
+        amx
+    };
+
+    // A CPUID feature bit and the name /proc/cpuinfo uses for it
+    struct cpuid_feature
+    {
+        unsigned int leaf;
+        unsigned int subleaf;
+        int reg;
+        int bit;
+        xstate state;
+        char const* name;
+    };
+
+    enum { eax, ebx, ecx, edx };
+
+    static const cpuid_feature cpuid_features[] = {
+        { 1, 0, edx, 0, xstate::none, "fpu" },
+        { 1, 0, edx, 4, xstate::none, "tsc" },
+        { 1, 0, edx, 8, xstate::none, "cx8" },
+        { 1, 0, edx, 15, xstate::none, "cmov" },
+        { 1, 0, edx, 23, xstate::none, "mmx" },
+        { 1, 0, edx, 24, xstate::none, "fxsr" },
+        { 1, 0, edx, 25, xstate::none, "sse" },
+        { 1, 0, edx, 26, xstate::none, "sse2" },
+        { 1, 0, edx, 28, xstate::none, "ht" },
+        { 1, 0, ecx, 0, xstate::none, "pni" },
+        { 1, 0, ecx, 1, xstate::none, "pclmulqdq" },
+        { 1, 0, ecx, 9, xstate::none, "ssse3" },
+        { 1, 0, ecx, 12, xstate::avx, "fma" },
+        { 1, 0, ecx, 13, xstate::none, "cx16" },
+        { 1, 0, ecx, 19, xstate::none, "sse4_1" },
+        { 1, 0, ecx, 20, xstate::none, "sse4_2" },
+        { 1, 0, ecx, 22, xstate::none, "movbe" },
+        { 1, 0, ecx, 23, xstate::none, "popcnt" },
+        { 1, 0, ecx, 25, xstate::none, "aes" },
+        { 1, 0, ecx, 26, xstate::none, "xsave" },
+        { 1, 0, ecx, 28, xstate::avx, "avx" },
+        { 1, 0, ecx, 29, xstate::avx, "f16c" },
+        { 1, 0, ecx, 30, xstate::none, "rdrand" },
+        { 1, 0, ecx, 31, xstate::none, "hypervisor" },
+        { 7, 0, ebx, 3, xstate::none, "bmi1" },
+        { 7, 0, ebx, 5, xstate::avx, "avx2" },
+        { 7, 0, ebx, 8, xstate::none, "bmi2" },
+        { 7, 0, ebx, 16, xstate::avx512, "avx512f" },
+        { 7, 0, ebx, 17, xstate::avx512, "avx512dq" },
+        { 7, 0, ebx, 18, xstate::none, "rdseed" },
+        { 7, 0, ebx, 19, xstate::none, "adx" },
+        { 7, 0, ebx, 21, xstate::avx512, "avx512ifma" },
+        { 7, 0, ebx, 23, xstate::none, "clflushopt" },
+        { 7, 0, ebx, 26, xstate::avx512, "avx512pf" },
+        { 7, 0, ebx, 27, xstate::avx512, "avx512er" },
+        { 7, 0, ebx, 28, xstate::avx512, "avx512cd" },
+        { 7, 0, ebx, 29, xstate::none, "sha_ni" },
+        { 7, 0, ebx, 30, xstate::avx512, "avx512bw" },
+        { 7, 0, ebx, 31, xstate::avx512, "avx512vl" },
+        { 7, 0, ecx, 1, xstate::avx512, "avx512vbmi" },
+        { 7, 0, ecx, 6, xstate::avx512, "avx512_vbmi2" },
+        { 7, 0, ecx, 8, xstate::none, "gfni" },
+        { 7, 0, ecx, 9, xstate::avx, "vaes" },
+        { 7, 0, ecx, 10, xstate::avx, "vpclmulqdq" },
+        { 7, 0, ecx, 11, xstate::avx512, "avx512_vnni" },
+        { 7, 0, ecx, 12, xstate::avx512, "avx512_bitalg" },
+        { 7, 0, ecx, 14, xstate::avx512, "avx512_vpopcntdq" },
+        { 7, 0, edx, 2, xstate::avx512, "avx512_4vnniw" },
+        { 7, 0, edx, 3, xstate::avx512, "avx512_4fmaps" },
+        { 7, 0, edx, 8, xstate::avx512, "avx512_vp2intersect" },
+        { 7, 0, edx, 22, xstate::amx, "amx_bf16" },
+        { 7, 0, edx, 23, xstate::avx512, "avx512_fp16" },
+        { 7, 0, edx, 24, xstate::amx, "amx_tile" },
+        { 7, 0, edx, 25, xstate::amx, "amx_int8" },
+        { 7, 1, eax, 4, xstate::avx, "avx_vnni" },
+        { 7, 1, eax, 5, xstate::avx512, "avx512_bf16" },
+        { 0x80000001, 0, ecx, 0, xstate::none, "lahf_lm" },
+        { 0x80000001, 0, ecx, 5, xstate::none, "abm" },
+        { 0x80000001, 0, ecx, 6, xstate::none, "sse4a" },
+        { 0x80000001, 0, ecx, 16, xstate::avx, "fma4" },
+        { 0x80000001, 0, edx, 20, xstate::none, "nx" },
+        { 0x80000001, 0, edx, 29, xstate::none, "lm" },
+    };
+
+    static bool read_cpuid_features(vector<string>& features)
+    {
+        unsigned int max_leaf = __get_cpuid_max(0, nullptr);
+        if (max_leaf < 1) {
+            return false;
+        }
+        unsigned int max_extended_leaf = __get_cpuid_max(0x80000000, nullptr);
+
+        // Like the kernel, report features that need extended register state only if the OS saves that state
+        unsigned int regs[4] = {};
+        __cpuid_count(1, 0, regs[eax], regs[ebx], regs[ecx], regs[edx]);
+        uint64_t xcr0 = 0;
+        if (regs[ecx] & (1u << 27)) {
+            unsigned int low, high;
+            __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+            xcr0 = (static_cast<uint64_t>(high) << 32) | low;
+        }
+        bool avx_state = (xcr0 & 0x6) == 0x6;
+        bool avx512_state = avx_state && (xcr0 & 0xE0) == 0xE0;
+        bool amx_state = (xcr0 & 0x60000) == 0x60000;
+
+        // The table is ordered by leaf, so each leaf is queried once
+        unsigned int leaf = 0;
+        unsigned int subleaf = 0;
+        unsigned int max_subleaf = 0;
+        bool supported = false;
+        for (auto const& feature : cpuid_features) {
+            if (feature.leaf != leaf || feature.subleaf != subleaf) {
+                leaf = feature.leaf;
+                subleaf = feature.subleaf;
+                supported = (leaf < 0x80000000 ? leaf <= max_leaf : leaf <= max_extended_leaf) &&
+                            (subleaf == 0 || subleaf <= max_subleaf);
+                if (supported) {
+                    __cpuid_count(leaf, subleaf, regs[eax], regs[ebx], regs[ecx], regs[edx]);
+                    if (subleaf == 0) {
+                        // Leaf 7 reports its highest sub-leaf in EAX
+                        max_subleaf = leaf == 7 ? regs[eax] : 0;
+                    }
+                }
+            }
+            if (!supported || !(regs[feature.reg] & (1u << feature.bit))) {
+                continue;
+            }
+            if ((feature.state == xstate::avx && !avx_state) ||
+                (feature.state == xstate::avx512 && !avx512_state) ||
+                (feature.state == xstate::amx && !amx_state)) {
+                continue;
+            }
+            features.emplace_back(feature.name);
+        }
+        return !features.empty();
+    }
+#elif defined(__aarch64__)
+    // The names /proc/cpuinfo uses for the AT_HWCAP and AT_HWCAP2 bits; the bit positions are part of the kernel ABI
+    static char const* const hwcap_names[] = {
+        "fp", "asimd", "evtstrm", "aes", "pmull", "sha1", "sha2", "crc32",
+        "atomics", "fphp", "asimdhp", "cpuid", "asimdrdm", "jscvt", "fcma", "lrcpc",
+        "dcpop", "sha3", "sm3", "sm4", "asimddp", "sha512", "sve", "asimdfhm",
+        "dit", "uscat", "ilrcpc", "flagm", "ssbs", "sb", "paca", "pacg",
+    };
+
+    static char const* const hwcap2_names[] = {
+        "dcpodp", "sve2", "sveaes", "svepmull", "svebitperm", "svesha3", "svesm4", "flagm2",
+        "frint", "svei8mm", "svef32mm", "svef64mm", "svebf16", "i8mm", "bf16", "dgh",
+        "rng", "bti", "mte", "ecv", "afp", "rpres", "mte3", "sme",
+    };
+
+    static bool read_hwcap_features(vector<string>& features)
+    {
+        auto hwcap = getauxval(AT_HWCAP);
+        if (hwcap == 0) {
+            return false;
+        }
+        for (size_t bit = 0; bit < sizeof(hwcap_names) / sizeof(hwcap_names[0]); ++bit) {
+            if (hwcap & (1ul << bit)) {
+                features.emplace_back(hwcap_names[bit]);
+            }
+        }
+#ifdef AT_HWCAP2
+        auto hwcap2 = getauxval(AT_HWCAP2);
+        for (size_t bit = 0; bit < sizeof(hwcap2_names) / sizeof(hwcap2_names[0]); ++bit) {
+            if (hwcap2 & (1ul << bit)) {
+                features.emplace_back(hwcap2_names[bit]);
+            }
+        }
+#endif
+        return true;
+    }
+#endif
+
+    // The common vector extensions and the feature that indicates each
+    static const vector<pair<char const*, char const*>> vector_extension_features = {
+#if defined(__x86_64__) || defined(__i386__)
+        { "sse", "sse" },
+        { "sse2", "sse2" },
+        { "sse3", "pni" },
+        { "ssse3", "ssse3" },
+        { "sse4_1", "sse4_1" },
+        { "sse4_2", "sse4_2" },
+        { "avx", "avx" },
+        { "avx2", "avx2" },
+        { "fma", "fma" },
+        { "avx512", "avx512f" },
+#elif defined(__aarch64__)
+        { "neon", "asimd" },
+        { "sve", "sve" },
+        { "sve2", "sve2" },
+        { "sme", "sme" },
+#elif defined(__arm__)
+        { "neon", "neon" },
+#endif
+    };
+
     processor_resolver::data processor_resolver::collect_data(collection& facts)
     {
         auto result = posix::processor_resolver::collect_data(facts);
 
         unordered_set<string> cpus;
-        lth_file::each_subdirectory("/sys/devices/system/cpu", [&](string const& cpu_directory) {
+        host::each_subdirectory("/sys/devices/system/cpu", [&](string const& cpu_directory) {
+            if (!is_cpu_directory(path(cpu_directory).filename().string())) {
+                return true;
+            }
             ++result.logical_count;
-            string id = lth_file::read((path(cpu_directory) / "/topology/physical_package_id").string());
+            string id = host::read((path(cpu_directory) / "/topology/physical_package_id").string());
             boost::trim(id);
             if (id.empty() || cpus.emplace(move(id)).second) {
                 // Haven't seen this processor before
                 ++result.physical_count;
             }
             return true;
-        }, "^cpu\\d+$");
+        });
+
+        // Prefer the features reported by the processor itself; otherwise use the first processor's cpuinfo flags
+        // The processor is not part of a host snapshot, so a replay always uses the flags
+        bool have_features = !host::snapshot_replaying() && collect_isa_features(result);
+        bool first_processor = false;
 
         // To determine model information, parse /proc/cpuinfo
         bool have_counts = result.logical_count > 0;
         string id;
-        lth_file::each_line("/proc/cpuinfo", [&](string& line) {
+        host::each_line("/proc/cpuinfo", [&](string& line) {
             // Split the line on colon
             auto pos = line.find(":");
             if (pos == string::npos) {
@@ -48,6 +307,7 @@ namespace facter { namespace facts { namespace linux {
 
             if (key == "processor") {
                 // Start of a logical processor
+                first_processor = id.empty();
                 id = move(value);
                 if (!have_counts) {
                     ++result.logical_count;
@@ -58,13 +318,20 @@ namespace facter { namespace facts { namespace linux {
             } else if (!have_counts && key == "physical id" && cpus.emplace(move(value)).second) {
                 // Couldn't determine physical count from sysfs, but CPU topology is present, so use it
                 ++result.physical_count;
+            } else if (!have_features && (first_processor || id.empty()) && (key == "flags" || key == "Features")) {
+                // Every processor lists the same flags, so only the first processor's are used
+                parse_isa_features(result, value);
+                have_features = true;
             }
             return true;
         });
+        set_vector_extensions(result);
+
+        collect_topology(result, "/sys/devices/system");
 
         // Read in the max speed from the first cpu
         // The speed is in kHz
-        string speed = lth_file::read("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
+        string speed = host::read("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
         if (!speed.empty()) {
             try {
                 result.speed = stoi(speed) * static_cast<int64_t>(1000);
@@ -75,4 +342,132 @@ namespace facter { namespace facts { namespace linux {
         return result;
     }
 
+    bool processor_resolver::collect_isa_features(data& result)
+    {
+        vector<string> features;
+#if defined(__x86_64__) || defined(__i386__)
+        if (!read_cpuid_features(features)) {
+            return false;
+        }
+#elif defined(__aarch64__)
+        if (!read_hwcap_features(features)) {
+            return false;
+        }
+#else
+        return false;
+#endif
+        sort(features.begin(), features.end());
+        features.erase(unique(features.begin(), features.end()), features.end());
+        result.isa_features = move(features);
+        return true;
+    }
+
+    void processor_resolver::parse_isa_features(data& result, string const& flags)
+    {
+        auto& features = result.isa_features;
+        boost::split(features, flags, boost::is_space(), boost::token_compress_on);
+        features.erase(remove(features.begin(), features.end(), string()), features.end());
+        sort(features.begin(), features.end());
+        features.erase(unique(features.begin(), features.end()), features.end());
+    }
+
+    void processor_resolver::set_vector_extensions(data& result)
+    {
+        if (result.isa_features.empty()) {
+            return;
+        }
+        for (auto const& extension : vector_extension_features) {
+            result.vector_extensions[extension.first] =
+                binary_search(result.isa_features.begin(), result.isa_features.end(), extension.second);
+        }
+    }
+
+    void processor_resolver::collect_topology(data& result, string const& root)
+    {
+        string value;
+
+        // Offline CPUs have no cache information, so only the online CPUs are considered
+        vector<unsigned int> cpus;
+        if (read_attribute(root + "/cpu/online", value)) {
+            cpus = parse_cpu_list(value);
+        }
+
+        // Every CPU has the same cache indexes, so only list them for the first CPU
+        vector<string> indexes;
+        if (!cpus.empty()) {
+            host::each_subdirectory(root + "/cpu/cpu" + to_string(cpus.front()) + "/cache", [&](string const& directory) {
+                auto name = path(directory).filename().string();
+                if (boost::starts_with(name, "index")) {
+                    indexes.emplace_back(move(name));
+                }
+                return true;
+            });
+        }
+
+        // Count the caches of each kind, ordered by level, type, size and sharing
+        map<tuple<int, string, uint64_t, int>, int> kinds;
+        for (auto const& index : indexes) {
+            // A cache is read from the first CPU sharing it; the other CPUs in its shared list are skipped
+            vector<bool> covered;
+            for (auto cpu : cpus) {
+                if (cpu < covered.size() && covered[cpu]) {
+                    continue;
+                }
+                string directory = root + "/cpu/cpu" + to_string(cpu) + "/cache/" + index + "/";
+                if (!read_attribute(directory + "shared_cpu_list", value)) {
+                    continue;
+                }
+                auto shared = parse_cpu_list(value);
+                if (shared.empty()) {
+                    shared.push_back(cpu);
+                }
+                for (auto other : shared) {
+                    if (other >= covered.size()) {
+                        covered.resize(other + 1);
+                    }
+                    covered[other] = true;
+                }
+
+                int level = 0;
+                if (read_attribute(directory + "level", value)) {
+                    level = atoi(value.c_str());
+                }
+                string type;
+                read_attribute(directory + "type", type);
+                uint64_t size = 0;
+                if (read_attribute(directory + "size", value)) {
+                    size = parse_cache_size(value);
+                }
+                ++kinds[make_tuple(level, move(type), size, static_cast<int>(shared.size()))];
+            }
+        }
+        for (auto const& kind : kinds) {
+            cache c;
+            c.level = get<0>(kind.first);
+            c.type = get<1>(kind.first);
+            c.size = get<2>(kind.first);
+            c.shared_cpus = get<3>(kind.first);
+            c.count = kind.second;
+            result.caches.emplace_back(move(c));
+        }
+
+        // Each NUMA node lists its CPUs
+        host::each_subdirectory(root + "/node", [&](string const& directory) {
+            auto name = path(directory).filename().string();
+            if (!is_node_directory(name)) {
+                return true;
+            }
+            numa_node node;
+            node.name = move(name);
+            if (read_attribute(directory + "/cpulist", node.cpus)) {
+                node.cpu_count = static_cast<int>(parse_cpu_list(node.cpus).size());
+            }
+            result.numa_nodes.emplace_back(move(node));
+            return true;
+        });
+        sort(result.numa_nodes.begin(), result.numa_nodes.end(), [](numa_node const& left, numa_node const& right) {
+            return stoi(left.name.substr(4)) < stoi(right.name.substr(4));
+        });
+    }
+
 }}}  // namespace facter::facts::linux
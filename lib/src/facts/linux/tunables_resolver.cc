@@ -0,0 +1,126 @@
+#include <internal/facts/linux/tunables_resolver.hpp>
+#include <internal/util/linux/sysfs.hpp>
+#include <internal/util/host.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/util/string.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+
+using namespace std;
+using namespace facter::util::linux;
+using facter::util::wildcard_match;
+
+namespace host = facter::util::host;
+
+namespace facter { namespace facts { namespace linux {
+
+    static const string proc_sys = "/proc/sys/";
+
+    static string swap_separators(string name)
+    {
+        for (auto& c : name) {
+            if (c == '.') {
+                c = '/';
+            } else if (c == '/') {
+                c = '.';
+            }
+        }
+        return name;
+    }
+
+    static string sysctl_path(string const& name)
+    {
+        // Like sysctl, a name whose first separator is a slash is already a path and its dots are literal
+        // (e.g. "net/ipv4/conf/eth0.100/rp_filter"); otherwise dots separate and slashes are literal dots
+        auto separator = name.find_first_of("./");
+        if (separator != string::npos && name[separator] == '/') {
+            return name;
+        }
+        return swap_separators(name);
+    }
+
+    static void expand(string const& directory, vector<string> const& components, size_t index, vector<string>& paths)
+    {
+        if (index == components.size()) {
+            paths.push_back(directory);
+            return;
+        }
+
+        auto const& component = components[index];
+        if (component.find_first_of("*?") == string::npos) {
+            expand(directory + "/" + component, components, index + 1, paths);
+            return;
+        }
+
+        // Expand the wildcard in a stable order
+        vector<string> matches;
+        auto match = [&](string const& path) {
+            auto name = boost::filesystem::path(path).filename().string();
+            if (wildcard_match(name, component)) {
+                matches.emplace_back(move(name));
+            }
+            return true;
+        };
+        host::each_file(directory, match);
+        host::each_subdirectory(directory, match);
+        sort(matches.begin(), matches.end());
+        for (auto const& match : matches) {
+            expand(directory + "/" + match, components, index + 1, paths);
+        }
+    }
+
+    tunables_resolver::data tunables_resolver::collect_data(collection& facts)
+    {
+        data result;
+        collect_tunables(result, facts.get_option("tunables"), {});
+        return result;
+    }
+
+    void tunables_resolver::collect_tunables(data& result, vector<string> const& tunables, string const& root)
+    {
+        string buffer;
+        vector<string> paths;
+        for (auto const& tunable : tunables) {
+            bool sysctl = !boost::starts_with(tunable, "/");
+            string path = sysctl ? proc_sys + sysctl_path(tunable) : tunable;
+
+            // Only kernel tunables may be read, so reject anything that could leave /proc/sys or /sys
+            vector<string> components;
+            boost::split(components, path, boost::is_any_of("/"), boost::token_compress_on);
+            components.erase(remove(components.begin(), components.end(), string()), components.end());
+            bool allowed =
+                ((components.size() > 1 && components[0] == "sys") ||
+                 (components.size() > 2 && components[0] == "proc" && components[1] == "sys")) &&
+                none_of(components.begin(), components.end(), [](string const& component) {
+                    return component == "." || component == "..";
+                });
+            if (!allowed) {
+                LOG_WARNING("tunable %1% is not under /proc/sys or /sys and will not be collected.", tunable);
+                continue;
+            }
+
+            paths.clear();
+            expand(root, components, 0, paths);
+
+            bool found = false;
+            for (auto const& file : paths) {
+                if (!read_attribute(file, buffer)) {
+                    continue;
+                }
+                found = true;
+                auto name = file.substr(root.size());
+                if (sysctl) {
+                    // Name the tunable as sysctl does, writing dots within a component as slashes
+                    name = swap_separators(name.substr(proc_sys.size()));
+                }
+                result.values[move(name)] = buffer;
+            }
+            if (!found) {
+                LOG_DEBUG("tunable %1% could not be read.", tunable);
+            }
+        }
+    }
+
+}}}  // namespace facter::facts::linux
@@ -4,24 +4,21 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/vm.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <leatherman/util/regex.hpp>
-#include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cctype>
 #include <vector>
 #include <tuple>
 
 using namespace std;
 using namespace facter::facts;
 using namespace facter::util;
-using namespace leatherman::util;
-using namespace leatherman::execution;
-using namespace boost::filesystem;
+using namespace facter::execution;
 
-namespace bs = boost::system;
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace linux {
 
@@ -79,7 +76,7 @@ namespace facter { namespace facts { namespace linux {
     string virtualization_resolver::get_cgroup_vm()
     {
         string value;
-        lth_file::each_line("/proc/1/cgroup", [&](string& line) {
+        host::each_line("/proc/1/cgroup", [&](string& line) {
             vector<boost::iterator_range<string::iterator>> parts;
             boost::split(parts, line, boost::is_any_of(":"), boost::token_compress_on);
             if (parts.size() < 3) {
@@ -151,7 +148,7 @@ namespace facter { namespace facts { namespace linux {
     string virtualization_resolver::get_vserver_vm()
     {
         string value;
-        lth_file::each_line("/proc/self/status", [&](string& line) {
+        host::each_line("/proc/self/status", [&](string& line) {
             vector<boost::iterator_range<string::iterator>> parts;
             boost::split(parts, line, boost::is_space(), boost::token_compress_on);
             if (parts.size() != 2) {
@@ -189,14 +186,21 @@ namespace facter { namespace facts { namespace linux {
     string virtualization_resolver::get_openvz_vm()
     {
         // Detect if it's a OpenVZ without being CloudLinux
-        bs::error_code ec;
-        if (!is_directory("/proc/vz", ec) ||
-            is_regular_file("/proc/lve/list", ec) ||
-            boost::filesystem::is_empty("/proc/vz", ec)) {
+        if (!host::is_directory("/proc/vz") || host::is_regular_file("/proc/lve/list")) {
+            return {};
+        }
+        bool empty = true;
+        auto found = [&](string const&) {
+            empty = false;
+            return false;
+        };
+        host::each_file("/proc/vz", found);
+        host::each_subdirectory("/proc/vz", found);
+        if (empty) {
             return {};
         }
         string value;
-        lth_file::each_line("/proc/self/status", [&](string& line) {
+        host::each_line("/proc/self/status", [&](string& line) {
             vector<boost::iterator_range<string::iterator>> parts;
             boost::split(parts, line, boost::is_space(), boost::token_compress_on);
             if (parts.size() != 2) {
@@ -218,16 +222,13 @@ namespace facter { namespace facts { namespace linux {
     string virtualization_resolver::get_xen_vm()
     {
         // Check for a required Xen file
-        bs::error_code ec;
-        if (exists("/dev/xen/evtchn", ec) && !ec) {
+        if (host::exists("/dev/xen/evtchn")) {
             return vm::xen_privileged;
         }
-        ec.clear();
-        if (exists("/proc/xen", ec) && !ec) {
+        if (host::exists("/proc/xen")) {
             return vm::xen_unprivileged;
         }
-        ec.clear();
-        if (exists("/dev/xvda1", ec) && !ec) {
+        if (host::exists("/dev/xvda1")) {
             return vm::xen_unprivileged;
         }
         return {};
@@ -235,27 +236,41 @@ namespace facter { namespace facts { namespace linux {
 
     string virtualization_resolver::get_lspci_vm()
     {
-        static vector<tuple<boost::regex, string>> vms = {
-            make_tuple(boost::regex("VM[wW]are"),                     string(vm::vmware)),
-            make_tuple(boost::regex("VirtualBox"),                    string(vm::virtualbox)),
-            make_tuple(boost::regex("1ab8:|[Pp]arallels"),            string(vm::parallels)),
-            make_tuple(boost::regex("XenSource"),                     string(vm::xen_hardware)),
-            make_tuple(boost::regex("Microsoft Corporation Hyper-V"), string(vm::hyperv)),
-            make_tuple(boost::regex("Class 8007: Google, Inc"),       string(vm::gce)),
-            make_tuple(boost::regex("virtio", boost::regex::icase),   string(vm::kvm)),
-        };
-
         string value;
         each_line("lspci", [&](string& line) {
-            for (auto const& vm : vms) {
-                if (re_search(line, get<0>(vm))) {
-                    value = get<1>(vm);
-                    return false;
-                }
-            }
-            return true;
+            value = parse_lspci(line);
+            return value.empty();
         });
         return value;
     }
 
+    string virtualization_resolver::parse_lspci(string const& line)
+    {
+        // Each entry lists the substrings that identify a hypervisor; the first matching entry wins
+        static vector<tuple<vector<string>, string>> const vms = {
+            make_tuple(vector<string>{ "VMware", "VMWare" },              string(vm::vmware)),
+            make_tuple(vector<string>{ "VirtualBox" },                    string(vm::virtualbox)),
+            make_tuple(vector<string>{ "1ab8:", "Parallels", "parallels" }, string(vm::parallels)),
+            make_tuple(vector<string>{ "XenSource" },                     string(vm::xen_hardware)),
+            make_tuple(vector<string>{ "Microsoft Corporation Hyper-V" }, string(vm::hyperv)),
+            make_tuple(vector<string>{ "Class 8007: Google, Inc" },       string(vm::gce)),
+        };
+
+        for (auto const& vm : vms) {
+            for (auto const& text : get<0>(vm)) {
+                if (line.find(text) != string::npos) {
+                    return get<1>(vm);
+                }
+            }
+        }
+        // Equivalent to a case-insensitive search for virtio; boost::icontains compares through a locale and is much slower
+        static string const virtio = "virtio";
+        if (search(line.begin(), line.end(), virtio.begin(), virtio.end(), [](char c, char lower) {
+                return tolower(static_cast<unsigned char>(c)) == lower;
+            }) != line.end()) {
+            return vm::kvm;
+        }
+        return {};
+    }
+
 }}}  // namespace facter::facts::linux
@@ -116,4 +116,27 @@ namespace facter { namespace facts {
         return emitter;
     }
 
+    yaml_writer& map_value::write(yaml_writer& writer) const
+    {
+        writer.begin_map();
+        for (auto const& kvp : _elements) {
+            writer.key(kvp.first, needs_quotation(kvp.first));
+            kvp.second->write(writer);
+        }
+        writer.end_map();
+        return writer;
+    }
+
+    void map_value::measure(memory_usage& usage) const
+    {
+        ++usage.nodes;
+        usage.node_bytes += sizeof(*this);
+        for (auto const& kvp : _elements) {
+            // Each element is a tree node holding a color, three links and the key/value pair
+            usage.container_bytes += sizeof(kvp) + 4 * sizeof(void*);
+            usage.string_bytes += memory_usage::allocated(kvp.first);
+            kvp.second->measure(usage);
+        }
+    }
+
 }}  // namespace facter::facts
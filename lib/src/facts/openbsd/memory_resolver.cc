@@ -1,5 +1,5 @@
 #include <internal/facts/openbsd/memory_resolver.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <sys/types.h>
 #include <sys/param.h>
@@ -9,7 +9,7 @@
 #include <unistd.h>
 
 using namespace std;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace openbsd {
 
@@ -1,11 +1,11 @@
 #include <internal/facts/osx/memory_resolver.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <mach/mach.h>
 #include <sys/sysctl.h>
 
 using namespace std;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace osx {
 
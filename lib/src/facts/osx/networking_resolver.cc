@@ -2,13 +2,13 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <boost/algorithm/string.hpp>
 #include <net/if_dl.h>
 #include <net/if.h>
 
 using namespace std;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace osx {
 
@@ -52,15 +52,15 @@ namespace facter { namespace facts { namespace osx {
         return interface;
     }
 
-    map<string, string> networking_resolver::find_dhcp_servers() const
+    networking_resolver::dhcp_leases networking_resolver::find_dhcp_servers(unsigned int sources) const
     {
-        // We don't parse dhclient information on OSX
-        return map<string, string>();
+        // We don't parse lease files on OSX
+        return {};
     }
 
-    string networking_resolver::find_dhcp_server(string const& interface) const
+    string networking_resolver::find_dhcp_server(string const& interface, unsigned int sources) const
     {
-        // Use ipconfig to get the server identifier
+        // Use ipconfig to get the server identifier; it is the native source on OSX, so it does not depend on the sources
         auto exec = execute("ipconfig", { "getoption", interface, "server_identifier" });
         if (!exec.success) {
             return {};
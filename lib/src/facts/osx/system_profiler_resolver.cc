@@ -1,12 +1,12 @@
 #include <internal/facts/osx/system_profiler_resolver.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <boost/algorithm/string.hpp>
 #include <map>
 #include <functional>
 
 using namespace std;
 using namespace facter::facts;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace osx {
 
@@ -1,15 +1,153 @@
 #include <internal/facts/posix/identity_resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <internal/util/cache.hpp>
+#include <leatherman/file_util/file.hpp>
 #include <leatherman/logging/logging.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <sys/types.h>
 #include <unistd.h>
 #include <pwd.h>
 #include <grp.h>
 
 using namespace std;
+using boost::lexical_cast;
+using boost::bad_lexical_cast;
+
+namespace lth_file = leatherman::file_util;
 
 namespace facter { namespace facts { namespace posix {
 
+    // The default time to wait for the user and group lookups
+    static const chrono::milliseconds default_timeout(5000);
+
+    static chrono::milliseconds get_timeout(collection const& facts)
+    {
+        auto const& option = facts.get_option("identity-timeout");
+        if (option.empty()) {
+            return default_timeout;
+        }
+        try {
+            auto seconds = lexical_cast<double>(option.front());
+            if (seconds >= 0) {
+                return chrono::milliseconds(static_cast<int64_t>(seconds * 1000));
+            }
+        } catch (bad_lexical_cast&) {
+        }
+        LOG_WARNING("identity-timeout \"%1%\" is not a number of seconds: the default of %2% seconds is used.", option.front(), default_timeout.count() / 1000);
+        return default_timeout;
+    }
+
+    // The cache file has a "user <uid> <name>" line and a "group <gid> <name>" line
+    void identity_resolver::read_cache(string const& path, uid_t uid, gid_t gid, data& result)
+    {
+        lth_file::each_line(path, [&](string& line) {
+            istringstream stream(line);
+            string kind, name;
+            int64_t id;
+            if (!(stream >> kind >> id >> name)) {
+                return true;
+            }
+            // Only names cached for the ids being looked up are used
+            if (kind == "user" && id == static_cast<int64_t>(uid)) {
+                result.user_id = id;
+                result.user_name = move(name);
+                result.privileged = (uid == 0);
+            } else if (kind == "group" && id == static_cast<int64_t>(gid)) {
+                result.group_id = id;
+                result.group_name = move(name);
+            }
+            return true;
+        });
+    }
+
+    void identity_resolver::write_cache(string const& path, data const& result)
+    {
+        ostringstream stream;
+        if (result.user_id) {
+            stream << "user " << *result.user_id << " " << result.user_name << "\n";
+        }
+        if (result.group_id) {
+            stream << "group " << *result.group_id << " " << result.group_name << "\n";
+        }
+        auto contents = stream.str();
+        string existing;
+        if (contents.empty() || (lth_file::read(path, existing) && existing == contents)) {
+            return;
+        }
+
+        // The cache is written atomically so a partially written cache is never read
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(boost::filesystem::path(path).parent_path(), ec);
+        try {
+            lth_file::atomic_write_to_file(contents, path);
+        } catch (exception& ex) {
+            LOG_DEBUG("identity cache %1% could not be written: %2%.", path, ex.what());
+        }
+    }
+
     identity_resolver::data identity_resolver::collect_data(collection& facts)
+    {
+        // The names are cached in a file inside the identity cache directory
+        string cache_path;
+        auto directory = util::cache_directory("identity");
+        if (!directory.empty()) {
+            cache_path = (boost::filesystem::path(directory) / "names").string();
+        }
+        return collect_identity(geteuid(), getegid(), get_timeout(facts), cache_path, &identity_resolver::lookup_identity);
+    }
+
+    identity_resolver::data identity_resolver::collect_identity(uid_t uid, gid_t gid, chrono::milliseconds timeout, string const& cache_path, lookup_function lookup)
+    {
+        data result;
+        if (timeout.count() == 0) {
+            result = lookup(uid, gid);
+        } else {
+            // A lookup that missed an earlier deadline is probably still blocked, so wait on it again
+            // rather than abandoning another worker
+            static mutex pending_mutex;
+            static map<pair<uid_t, gid_t>, shared_future<data>> pending;
+            shared_future<data> future;
+            {
+                lock_guard<mutex> lock(pending_mutex);
+                auto& existing = pending[make_pair(uid, gid)];
+                if (!existing.valid() || existing.wait_for(chrono::seconds(0)) == future_status::ready) {
+                    // The worker owns everything it uses so it can be abandoned if it does not finish in time
+                    auto promise = make_shared<std::promise<data>>();
+                    existing = promise->get_future().share();
+                    thread([promise, lookup, uid, gid]() {
+                        promise->set_value(lookup(uid, gid));
+                    }).detach();
+                }
+                future = existing;
+            }
+
+            if (future.wait_for(timeout) != future_status::ready) {
+                if (cache_path.empty()) {
+                    LOG_WARNING("user and group lookups did not complete within %1%ms: identity facts are unavailable.", timeout.count());
+                    return result;
+                }
+                read_cache(cache_path, uid, gid, result);
+                LOG_WARNING("user and group lookups did not complete within %1%ms.", timeout.count());
+                LOG_DEBUG("identity facts are stale: using the user and group names cached in %1%.", cache_path);
+                return result;
+            }
+            result = future.get();
+        }
+
+        if (!cache_path.empty()) {
+            write_cache(cache_path, result);
+        }
+        return result;
+    }
+
+    identity_resolver::data identity_resolver::lookup_identity(uid_t uid, gid_t gid)
     {
         data result;
 
@@ -22,7 +160,6 @@ namespace facter { namespace facts { namespace posix {
             buffer.resize(buffer_size);
         }
 
-        uid_t uid = geteuid();
         struct passwd pwd;
         struct passwd *pwd_ptr;
         int err = getpwuid_r(uid, &pwd, buffer.data(), buffer.size(), &pwd_ptr);
@@ -45,7 +182,6 @@ namespace facter { namespace facts { namespace posix {
             buffer.resize(buffer_size);
         }
 
-        gid_t gid = getegid();
         struct group grp;
         struct group *grp_ptr;
         err = getgrgid_r(gid, &grp, buffer.data(), buffer.size(), &grp_ptr);
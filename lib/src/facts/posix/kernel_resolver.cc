@@ -1,7 +1,7 @@
 #include <internal/facts/posix/kernel_resolver.hpp>
 #include <facter/facts/collection.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <sys/utsname.h>
+#include <internal/util/posix/uname.hpp>
 
 using namespace std;
 
@@ -11,7 +11,7 @@ namespace facter { namespace facts { namespace posix {
     {
         data result;
         struct utsname name;
-        if (uname(&name) == -1) {
+        if (!util::posix::read_uname(name)) {
             LOG_WARNING("uname failed: %1% (%2%): kernel facts are unavailable.", strerror(errno), errno);
             return result;
         }
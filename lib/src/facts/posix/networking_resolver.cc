@@ -1,6 +1,6 @@
 #include <internal/facts/posix/networking_resolver.hpp>
 #include <internal/util/posix/scoped_addrinfo.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
 #include <unistd.h>
@@ -11,7 +11,7 @@
 using namespace std;
 using namespace facter::util::posix;
 
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace posix {
 
@@ -57,10 +57,8 @@ namespace facter { namespace facts { namespace posix {
         return {};
     }
 
-    networking_resolver::data networking_resolver::collect_data(collection& facts)
+    string networking_resolver::get_hostname() const
     {
-        data result;
-
         // Get the maximum size of the host name
         int size = sysconf(_SC_HOST_NAME_MAX);
         if (size <= 0) {
@@ -70,20 +68,25 @@ namespace facter { namespace facts { namespace posix {
         vector<char> name(size + 1);
         if (gethostname(name.data(), size) != 0) {
             LOG_WARNING("gethostname failed: %1% (%2%): hostname is unavailable.", strerror(errno), errno);
+            return {};
+        }
+        return name.data();
+    }
+
+    networking_resolver::data networking_resolver::collect_data(collection& facts)
+    {
+        data result;
+
+        auto name = get_hostname();
+        // Check for fully-qualified hostname
+        auto pos = name.find('.');
+        if (pos != string::npos) {
+            LOG_DEBUG("using the FQDN returned by gethostname: %1%.", name);
+            result.hostname = name.substr(0, pos);
+            result.domain = name.substr(pos + 1);
         } else {
-            // Check for fully-qualified hostname
-            auto it = find(name.begin(), name.end(), '.');
-            if (it != name.end()) {
-                LOG_DEBUG("using the FQDN returned by gethostname: %1%.", name.data());
-                result.hostname.assign(name.begin(), it);
-                if (++it != name.end()) {
-                    // Use the remainder of the string, up to the first null character
-                    result.domain = &*it;
-                }
-            } else {
-                // Not fully qualified; just set hostname
-                result.hostname = name.data();
-            }
+            // Not fully qualified; just set hostname
+            result.hostname = move(name);
         }
 
         // If the hostname was not already fully qualified, attempt to resolve it
@@ -107,7 +110,7 @@ namespace facter { namespace facts { namespace posix {
         // If no domain, look it up based on resolv.conf
         if (result.domain.empty()) {
             string search;
-            lth_file::each_line("/etc/resolv.conf", [&](string& line) {
+            host::each_line("/etc/resolv.conf", [&](string& line) {
                 vector<boost::iterator_range<string::iterator>> parts;
                 boost::split(parts, line, boost::is_space(), boost::token_compress_on);
                 if (parts.size() < 2) {
@@ -1,10 +1,10 @@
 #include <internal/facts/posix/operating_system_resolver.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <leatherman/execution/execution.hpp>
-#include <sys/utsname.h>
+#include <internal/execution/execution.hpp>
+#include <internal/util/posix/uname.hpp>
 
 using namespace std;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace posix {
 
@@ -14,8 +14,7 @@ namespace facter { namespace facts { namespace posix {
         data result = resolvers::operating_system_resolver::collect_data(facts);
 
         struct utsname name;
-        memset(&name, 0, sizeof(name));
-        if (uname(&name) == -1) {
+        if (!util::posix::read_uname(name)) {
             LOG_DEBUG("uname failed: %1% (%2%): OS hardware is unavailable.", strerror(errno), errno);
         } else {
             result.hardware = name.machine;
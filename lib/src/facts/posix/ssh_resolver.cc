@@ -1,6 +1,6 @@
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
 #include <internal/facts/posix/ssh_resolver.hpp>
-#include <leatherman/file_util/file.hpp>
+#include <internal/util/host.hpp>
 #include <facter/util/string.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
@@ -20,8 +20,7 @@ using namespace std;
 using namespace facter::util;
 using namespace boost::filesystem;
 
-namespace bs = boost::system;
-namespace lth_file = leatherman::file_util;
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace posix {
 
@@ -51,8 +50,7 @@ namespace facter { namespace facts { namespace posix {
             key_file = directory;
             key_file /= filename;
 
-            bs::error_code ec;
-            if (!is_regular_file(key_file, ec)) {
+            if (!host::is_regular_file(key_file.string())) {
                 key_file.clear();
                 continue;
             }
@@ -66,7 +64,7 @@ namespace facter { namespace facts { namespace posix {
         }
 
         // Read the file's contents
-        string contents = lth_file::read(key_file.string());
+        string contents = host::read(key_file.string());
         if (contents.empty()) {
             LOG_DEBUG("%1% could not be read.", key_file);
             return;
@@ -1,41 +1,164 @@
 #include <internal/facts/posix/uptime_resolver.hpp>
-#include <leatherman/util/regex.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
+#include <boost/lexical_cast.hpp>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <utility>
 
 using namespace std;
-using namespace leatherman::util;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace posix {
 
-    int64_t uptime_resolver::parse_uptime(string const& output)
+    /**
+     * Matches the fixed formats of uptime output without compiling regexes.
+     */
+    struct uptime_scanner
     {
-        // This regex parsing is directly ported from facter:
-        // https://github.com/puppetlabs/facter/blob/2.0.1/lib/facter/util/uptime.rb#L42-L60
+        uptime_scanner(string const& text, size_t position) :
+            _text(text),
+            _position(position),
+            _count(0)
+        {
+        }
+
+        bool literal(char const* str)
+        {
+            size_t length = strlen(str);
+            if (_text.compare(_position, length, str) != 0) {
+                return false;
+            }
+            _position += length;
+            return true;
+        }
+
+        bool optional(char c)
+        {
+            if (_position < _text.size() && _text[_position] == c) {
+                ++_position;
+            }
+            return true;
+        }
+
+        bool plural()
+        {
+            // Equivalent to (?:s|\(s\))?
+            return literal("s") || literal("(s)") || true;
+        }
+
+        bool whitespace()
+        {
+            size_t start = _position;
+            while (_position < _text.size() && isspace(static_cast<unsigned char>(_text[_position]))) {
+                ++_position;
+            }
+            return _position > start;
+        }
+
+        bool number()
+        {
+            size_t start = _position;
+            while (_position < _text.size() && isdigit(static_cast<unsigned char>(_text[_position]))) {
+                ++_position;
+            }
+            if (_position == start || _count == _numbers.size()) {
+                return false;
+            }
+            // Only record where the number is; most attempts fail, so don't copy it until the whole pattern matches
+            _numbers[_count++] = make_pair(start, _position - start);
+            return true;
+        }
+
+        size_t count() const
+        {
+            return _count;
+        }
 
-        static boost::regex days_hours_mins_pattern("(\\d+) day(?:s|\\(s\\))?,?\\s+(\\d+):-?(\\d+)");
-        static boost::regex days_hours_pattern("(\\d+) day(?:s|\\(s\\))?,\\s+(\\d+) hr(?:s|\\(s\\))?,");
-        static boost::regex days_mins_pattern("(\\d+) day(?:s|\\(s\\))?,\\s+(\\d+) min(?:s|\\(s\\))?,");
-        static boost::regex days_pattern("(\\d+) day(?:s|\\(s\\))?,");
-        static boost::regex hours_mins_pattern("up\\s+(\\d+):-?(\\d+),");
-        static boost::regex hours_pattern("(\\d+) hr(?:s|\\(s\\))?,");
-        static boost::regex mins_pattern("(\\d+) min(?:s|\\(s\\))?,");
+        string number(size_t index) const
+        {
+            return _text.substr(_numbers[index].first, _numbers[index].second);
+        }
+
+     private:
+        string const& _text;
+        size_t _position;
+        array<pair<size_t, size_t>, 3> _numbers;
+        size_t _count;
+    };
+
+    static bool search(string const& text, function<bool(uptime_scanner&)> const& pattern, initializer_list<int*> values)
+    {
+        // Find the leftmost match, as a regex search would
+        for (size_t start = 0; start < text.size(); ++start) {
+            uptime_scanner scanner(text, start);
+            if (!pattern(scanner)) {
+                continue;
+            }
+            auto value = values.begin();
+            for (size_t i = 0; i < scanner.count(); ++i) {
+                // Numbers that don't fit fail the match
+                try {
+                    **value++ = boost::lexical_cast<int>(scanner.number(i));
+                } catch (boost::bad_lexical_cast const&) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
 
+    int64_t uptime_resolver::parse_uptime(string const& output)
+    {
+        // This parsing is directly ported from the regexes used by facter:
+        // https://github.com/puppetlabs/facter/blob/2.0.1/lib/facter/util/uptime.rb#L42-L60
         int days, hours, minutes;
 
-        if (re_search(output, days_hours_mins_pattern, &days, &hours, &minutes)) {
+        // (\d+) day(?:s|\(s\))?,?\s+(\d+):-?(\d+)
+        if (search(output, [](uptime_scanner& s) {
+                return s.number() && s.literal(" day") && s.plural() && s.optional(',') && s.whitespace() &&
+                       s.number() && s.literal(":") && s.optional('-') && s.number();
+            }, { &days, &hours, &minutes })) {
             return 86400ll * days + 3600ll * hours + 60ll * minutes;
-        } else if (re_search(output, days_hours_pattern, &days, &hours)) {
+        }
+        // (\d+) day(?:s|\(s\))?,\s+(\d+) hr(?:s|\(s\))?,
+        if (search(output, [](uptime_scanner& s) {
+                return s.number() && s.literal(" day") && s.plural() && s.literal(",") && s.whitespace() &&
+                       s.number() && s.literal(" hr") && s.plural() && s.literal(",");
+            }, { &days, &hours })) {
             return 86400ll * days + 3600ll * hours;
-        } else if (re_search(output, days_mins_pattern, &days, &minutes)) {
+        }
+        // (\d+) day(?:s|\(s\))?,\s+(\d+) min(?:s|\(s\))?,
+        if (search(output, [](uptime_scanner& s) {
+                return s.number() && s.literal(" day") && s.plural() && s.literal(",") && s.whitespace() &&
+                       s.number() && s.literal(" min") && s.plural() && s.literal(",");
+            }, { &days, &minutes })) {
             return 86400ll * days + 60ll * minutes;
-        } else if (re_search(output, days_pattern, &days)) {
+        }
+        // (\d+) day(?:s|\(s\))?,
+        if (search(output, [](uptime_scanner& s) {
+                return s.number() && s.literal(" day") && s.plural() && s.literal(",");
+            }, { &days })) {
             return 86400ll * days;
-        } else if (re_search(output, hours_mins_pattern, &hours, &minutes)) {
+        }
+        // up\s+(\d+):-?(\d+),
+        if (search(output, [](uptime_scanner& s) {
+                return s.literal("up") && s.whitespace() && s.number() && s.literal(":") && s.optional('-') && s.number() && s.literal(",");
+            }, { &hours, &minutes })) {
             return 3600ll * hours + 60ll * minutes;
-        } else if (re_search(output, hours_pattern, &hours)) {
+        }
+        // (\d+) hr(?:s|\(s\))?,
+        if (search(output, [](uptime_scanner& s) {
+                return s.number() && s.literal(" hr") && s.plural() && s.literal(",");
+            }, { &hours })) {
             return 3600ll * hours;
-        } else if (re_search(output, mins_pattern, &minutes)) {
+        }
+        // (\d+) min(?:s|\(s\))?,
+        if (search(output, [](uptime_scanner& s) {
+                return s.number() && s.literal(" min") && s.plural() && s.literal(",");
+            }, { &minutes })) {
             return 60ll * minutes;
         }
         return -1;
@@ -1,13 +1,13 @@
 #include <internal/facts/posix/xen_resolver.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/util/host.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <boost/filesystem.hpp>
 
 using namespace std;
 using namespace facter::facts;
-using namespace leatherman::execution;
-using namespace boost::filesystem;
-namespace bs = boost::system;
+using namespace facter::execution;
+
+namespace host = facter::util::host;
 
 namespace facter { namespace facts { namespace posix {
 
@@ -15,8 +15,7 @@ namespace facter { namespace facts { namespace posix {
     {
         constexpr char const* xen_toolstack = "/usr/lib/xen-common/bin/xen-toolstack";
 
-        bs::error_code ec;
-        if (exists(xen_toolstack, ec) && !ec) {
+        if (host::exists(xen_toolstack)) {
             auto exec = execute(xen_toolstack);
             if (exec.success) {
                 return exec.output;
@@ -25,7 +24,7 @@ namespace facter { namespace facts { namespace posix {
                 return {};
             }
         } else {
-            LOG_TRACE("xen toolstack command not found: %1%", ec.message());
+            LOG_TRACE("xen toolstack command %1% not found.", xen_toolstack);
 
             static vector<string> xen_commands{"/usr/sbin/xl", "/usr/sbin/xm"};
             for (auto const& cmd : xen_commands) {
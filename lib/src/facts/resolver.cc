@@ -2,12 +2,155 @@
 #include <facter/facts/collection.hpp>
 #include <leatherman/util/regex.hpp>
 #include <leatherman/logging/logging.hpp>
+#include <cctype>
+#include <limits>
 
 using namespace std;
 using namespace leatherman::util;
 
 namespace facter { namespace facts {
 
+    /**
+     * A fact name pattern.
+     * Patterns are nearly always a literal prefix optionally followed by wildcards (e.g. "^processor[0-9]+$"), so
+     * that subset is matched by hand; anything else falls back to boost::regex.
+     */
+    struct resolver::pattern
+    {
+        explicit pattern(string const& expression)
+        {
+            if (!parse(expression)) {
+                _tokens.clear();
+                _regex.reset(new boost::regex(expression));
+            }
+        }
+
+        bool match(string const& name) const
+        {
+            if (_regex) {
+                return re_search(name, *_regex);
+            }
+            if (_anchored_start) {
+                return match(name, 0, 0);
+            }
+            for (size_t start = 0; start <= name.size(); ++start) {
+                if (match(name, start, 0)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+     private:
+        enum class token_type
+        {
+            literal,
+            any,
+            digit
+        };
+
+        struct token
+        {
+            token_type type;
+            char literal;
+            size_t minimum;
+            size_t maximum;
+        };
+
+        bool parse(string const& expression)
+        {
+            size_t i = 0;
+            if (i < expression.size() && expression[i] == '^') {
+                _anchored_start = true;
+                ++i;
+            }
+            while (i < expression.size()) {
+                char c = expression[i++];
+                token current { token_type::literal, c, 1, 1 };
+                if (c == '$' && i == expression.size()) {
+                    _anchored_end = true;
+                    break;
+                }
+                if (c == '.') {
+                    current.type = token_type::any;
+                } else if (c == '\\') {
+                    if (i == expression.size()) {
+                        return false;
+                    }
+                    c = expression[i++];
+                    if (c == 'd') {
+                        current.type = token_type::digit;
+                    } else if (isalnum(static_cast<unsigned char>(c)) || string("<>`'").find(c) != string::npos) {
+                        // Other escapes are character classes, anchors or special characters
+                        return false;
+                    } else {
+                        current.literal = c;
+                    }
+                } else if (expression.compare(i - 1, 5, "[0-9]") == 0) {
+                    current.type = token_type::digit;
+                    i += 4;
+                } else if (string("^$|?*+()[]{}").find(c) != string::npos) {
+                    return false;
+                }
+
+                // Apply any quantifier
+                if (i < expression.size() && (expression[i] == '*' || expression[i] == '+')) {
+                    current.minimum = expression[i] == '*' ? 0 : 1;
+                    current.maximum = numeric_limits<size_t>::max();
+                    ++i;
+                    // Lazy and possessive quantifiers are not supported
+                    if (i < expression.size() && (expression[i] == '?' || expression[i] == '+')) {
+                        return false;
+                    }
+                }
+                _tokens.push_back(current);
+            }
+            return true;
+        }
+
+        bool accepts(token const& t, char c) const
+        {
+            switch (t.type) {
+                case token_type::literal:
+                    return c == t.literal;
+                case token_type::digit:
+                    return c >= '0' && c <= '9';
+                default:
+                    return true;
+            }
+        }
+
+        bool match(string const& name, size_t position, size_t index) const
+        {
+            if (index == _tokens.size()) {
+                return !_anchored_end || position == name.size();
+            }
+
+            // Consume as many characters as allowed, then backtrack
+            auto const& t = _tokens[index];
+            size_t count = 0;
+            while (count < t.maximum && position + count < name.size() && accepts(t, name[position + count])) {
+                ++count;
+            }
+            for (;; --count) {
+                if (count < t.minimum) {
+                    return false;
+                }
+                if (match(name, position + count, index + 1)) {
+                    return true;
+                }
+                if (count == 0) {
+                    return false;
+                }
+            }
+        }
+
+        vector<token> _tokens;
+        bool _anchored_start = false;
+        bool _anchored_end = false;
+        unique_ptr<boost::regex> _regex;
+    };
+
     invalid_name_pattern_exception::invalid_name_pattern_exception(string const& message) :
         runtime_error(message)
     {
@@ -17,9 +160,9 @@ namespace facter { namespace facts {
         _name(move(name)),
         _names(move(names))
     {
-        for (auto const& pattern : patterns) {
+        for (auto const& expression : patterns) {
             try {
-                _regexes.push_back(boost::regex(pattern));
+                _patterns.emplace_back(new pattern(expression));
             } catch (boost::regex_error const& ex) {
                 throw invalid_name_pattern_exception(ex.what());
             }
@@ -41,7 +184,7 @@ namespace facter { namespace facts {
         if (this != &other) {
             _name = std::move(other._name);
             _names = std::move(other._names);
-            _regexes = std::move(other._regexes);
+            _patterns = std::move(other._patterns);
         }
         return *this;
     }
@@ -58,14 +201,14 @@ namespace facter { namespace facts {
 
     bool resolver::has_patterns() const
     {
-        return _regexes.size() > 0;
+        return _patterns.size() > 0;
     }
 
     bool resolver::is_match(string const& name) const
     {
-        // Check to see if any of our regexes match
-        for (auto const& regex : _regexes) {
-            if (re_search(name, regex)) {
+        // Check to see if any of our patterns match
+        for (auto const& p : _patterns) {
+            if (p->match(name)) {
                 return true;
             }
         }
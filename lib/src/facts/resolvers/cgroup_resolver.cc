@@ -0,0 +1,73 @@
+#include <internal/facts/resolvers/cgroup_resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/facts/fact.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include <facter/facts/computed_value.hpp>
+
+using namespace std;
+
+namespace facter { namespace facts { namespace resolvers {
+
+    cgroup_resolver::cgroup_resolver() :
+        resolver(
+            "control group",
+            {
+                fact::cgroup
+            })
+    {
+    }
+
+    void cgroup_resolver::resolve(collection& facts)
+    {
+        data result = collect_data(facts);
+        if (result.version == 0) {
+            return;
+        }
+
+        auto value = make_value<map_value>();
+        value->add("version", make_value<integer_value>(result.version));
+        if (!result.path.empty()) {
+            value->add("path", make_value<string_value>(move(result.path)));
+        }
+
+        if (result.cpu_quota && result.cpu_period && *result.cpu_period > 0) {
+            auto cpu = make_value<map_value>();
+            cpu->add("quota", make_value<integer_value>(static_cast<int64_t>(*result.cpu_quota)));
+            cpu->add("period", make_value<integer_value>(static_cast<int64_t>(*result.cpu_period)));
+            cpu->add("effective", make_value<double_value>(static_cast<double>(*result.cpu_quota) / *result.cpu_period));
+            value->add("cpu", move(cpu));
+        }
+
+        if (!result.cpuset_cpus.empty()) {
+            auto cpuset = make_value<map_value>();
+            cpuset->add("cpus", make_value<string_value>(move(result.cpuset_cpus)));
+            if (result.cpuset_count > 0) {
+                cpuset->add("count", make_value<integer_value>(result.cpuset_count));
+            }
+            value->add("cpuset", move(cpuset));
+        }
+
+        auto memory = make_value<map_value>();
+        if (result.memory_max) {
+            memory->add("max", make_value<computed_value>(computed_value::size, *result.memory_max));
+            memory->add("max_bytes", make_value<integer_value>(static_cast<int64_t>(*result.memory_max)));
+        }
+        if (result.memory_high) {
+            memory->add("high", make_value<computed_value>(computed_value::size, *result.memory_high));
+            memory->add("high_bytes", make_value<integer_value>(static_cast<int64_t>(*result.memory_high)));
+        }
+        if (!memory->empty()) {
+            value->add("memory", move(memory));
+        }
+
+        if (result.pids_max) {
+            auto pids = make_value<map_value>();
+            pids->add("max", make_value<integer_value>(static_cast<int64_t>(*result.pids_max)));
+            value->add("pids", move(pids));
+        }
+
+        facts.add(fact::cgroup, move(value));
+    }
+
+}}}  // namespace facter::facts::resolvers
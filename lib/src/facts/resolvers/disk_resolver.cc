@@ -3,10 +3,9 @@
 #include <facter/facts/fact.hpp>
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/scalar_value.hpp>
-#include <facter/util/string.hpp>
+#include <facter/facts/computed_value.hpp>
 
 using namespace std;
-using namespace facter::util;
 
 namespace facter { namespace facts { namespace resolvers {
 
@@ -47,7 +46,41 @@ namespace facter { namespace facts { namespace resolvers {
             }
             facts.add(string(fact::block_device) + "_" + disk.name + "_size" , make_value<integer_value>(static_cast<int64_t>(disk.size), true));
             value->add("size_bytes", make_value<integer_value>(disk.size));
-            value->add("size", make_value<string_value>(si_string(disk.size)));
+            value->add("size", make_value<computed_value>(computed_value::size, disk.size));
+            if (disk.rotational) {
+                value->add("rotational", make_value<boolean_value>(*disk.rotational));
+            }
+            if (disk.logical_block_size > 0) {
+                value->add("logical_block_size", make_value<integer_value>(disk.logical_block_size));
+            }
+            if (disk.physical_block_size > 0) {
+                value->add("physical_block_size", make_value<integer_value>(disk.physical_block_size));
+            }
+            if (disk.discard) {
+                value->add("discard", make_value<boolean_value>(*disk.discard));
+            }
+            if (!disk.scheduler.empty()) {
+                value->add("scheduler", make_value<string_value>(move(disk.scheduler)));
+            }
+            if (disk.nr_requests > 0) {
+                value->add("nr_requests", make_value<integer_value>(disk.nr_requests));
+            }
+            if (disk.max_sectors_kb > 0) {
+                value->add("max_sectors_kb", make_value<integer_value>(disk.max_sectors_kb));
+            }
+            if (disk.nvme_namespace > 0 || !disk.nvme_transport.empty()) {
+                auto nvme = make_value<map_value>();
+                if (disk.nvme_namespace > 0) {
+                    nvme->add("namespace", make_value<integer_value>(disk.nvme_namespace));
+                }
+                if (!disk.nvme_transport.empty()) {
+                    nvme->add("transport", make_value<string_value>(move(disk.nvme_transport)));
+                }
+                value->add("nvme", move(nvme));
+            }
+            if (disk.hardware_queues > 0) {
+                value->add("hardware_queues", make_value<integer_value>(disk.hardware_queues));
+            }
 
             if (names.tellp() != 0) {
                 names << ',';
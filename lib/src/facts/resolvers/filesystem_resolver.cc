@@ -4,11 +4,10 @@
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include <facter/facts/scalar_value.hpp>
-#include <facter/util/string.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <boost/algorithm/string.hpp>
 
 using namespace std;
-using namespace facter::util;
 
 namespace facter { namespace facts { namespace resolvers {
 
@@ -46,12 +45,12 @@ namespace facter { namespace facts { namespace resolvers {
                     value->add("device", make_value<string_value>(move(mountpoint.device)));
                 }
                 value->add("size_bytes", make_value<integer_value>(mountpoint.size));
-                value->add("size", make_value<string_value>(si_string(mountpoint.size)));
+                value->add("size", make_value<computed_value>(computed_value::size, mountpoint.size));
                 value->add("available_bytes", make_value<integer_value>(mountpoint.available));
-                value->add("available", make_value<string_value>(si_string(mountpoint.available)));
+                value->add("available", make_value<computed_value>(computed_value::size, mountpoint.available));
                 value->add("used_bytes", make_value<integer_value>(used));
-                value->add("used", make_value<string_value>(si_string(used)));
-                value->add("capacity", make_value<string_value>(percentage(used, mountpoint.size)));
+                value->add("used", make_value<computed_value>(computed_value::size, used));
+                value->add("capacity", make_value<computed_value>(computed_value::percentage, used, mountpoint.size));
 
                 if (!mountpoint.options.empty()) {
                     auto options = make_value<array_value>();
@@ -103,7 +102,7 @@ namespace facter { namespace facts { namespace resolvers {
                     value->add("backing_file", make_value<string_value>(move(partition.backing_file)));
                 }
                 value->add("size_bytes", make_value<integer_value>(partition.size));
-                value->add("size", make_value<string_value>(si_string(partition.size)));
+                value->add("size", make_value<computed_value>(computed_value::size, partition.size));
 
                 partitions->add(move(partition.name), move(value));
             }
@@ -3,10 +3,9 @@
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
 #include <facter/facts/map_value.hpp>
-#include <facter/util/string.hpp>
+#include <facter/facts/computed_value.hpp>
 
 using namespace std;
-using namespace facter::util;
 
 namespace facter { namespace facts { namespace resolvers {
 
@@ -38,19 +37,19 @@ namespace facter { namespace facts { namespace resolvers {
             uint64_t mem_used = result.mem_total - result.mem_free;
 
             auto stats = make_value<map_value>();
-            stats->add("total", make_value<string_value>(si_string(result.mem_total)));
+            stats->add("total", make_value<computed_value>(computed_value::size, result.mem_total));
             stats->add("total_bytes", make_value<integer_value>(result.mem_total));
-            stats->add("used", make_value<string_value>(si_string(mem_used)));
+            stats->add("used", make_value<computed_value>(computed_value::size, mem_used));
             stats->add("used_bytes", make_value<integer_value>(mem_used));
-            stats->add("available", make_value<string_value>(si_string(result.mem_free)));
+            stats->add("available", make_value<computed_value>(computed_value::size, result.mem_free));
             stats->add("available_bytes", make_value<integer_value>(result.mem_free));
-            stats->add("capacity", make_value<string_value>(percentage(mem_used, result.mem_total)));
+            stats->add("capacity", make_value<computed_value>(computed_value::percentage, mem_used, result.mem_total));
             value->add("system", move(stats));
 
             // Add hidden facts
-            facts.add(fact::memoryfree, make_value<string_value>(si_string(result.mem_free), true));
+            facts.add(fact::memoryfree, make_value<computed_value>(computed_value::size, result.mem_free, 0, true));
             facts.add(fact::memoryfree_mb, make_value<double_value>(result.mem_free / (1024.0 * 1024.0), true));
-            facts.add(fact::memorysize, make_value<string_value>(si_string(result.mem_total), true));
+            facts.add(fact::memorysize, make_value<computed_value>(computed_value::size, result.mem_total, 0, true));
             facts.add(fact::memorysize_mb, make_value<double_value>(result.mem_total / (1024.0 * 1024.0), true));
         }
 
@@ -58,28 +57,51 @@ namespace facter { namespace facts { namespace resolvers {
             uint64_t swap_used = result.swap_total - result.swap_free;
 
             auto stats = make_value<map_value>();
-            stats->add("total", make_value<string_value>(si_string(result.swap_total)));
+            stats->add("total", make_value<computed_value>(computed_value::size, result.swap_total));
             stats->add("total_bytes", make_value<integer_value>(result.swap_total));
-            stats->add("used", make_value<string_value>(si_string(swap_used)));
+            stats->add("used", make_value<computed_value>(computed_value::size, swap_used));
             stats->add("used_bytes", make_value<integer_value>(swap_used));
-            stats->add("available", make_value<string_value>(si_string(result.swap_free)));
+            stats->add("available", make_value<computed_value>(computed_value::size, result.swap_free));
             stats->add("available_bytes", make_value<integer_value>(result.swap_free));
-            stats->add("capacity", make_value<string_value>(percentage(swap_used, result.swap_total)));
+            stats->add("capacity", make_value<computed_value>(computed_value::percentage, swap_used, result.swap_total));
             if (result.swap_encryption != encryption_status::unknown) {
                 stats->add("encrypted", make_value<boolean_value>(result.swap_encryption == encryption_status::encrypted));
             }
             value->add("swap", move(stats));
 
             // Add hidden facts
-            facts.add(fact::swapfree, make_value<string_value>(si_string(result.swap_free), true));
+            facts.add(fact::swapfree, make_value<computed_value>(computed_value::size, result.swap_free, 0, true));
             facts.add(fact::swapfree_mb, make_value<double_value>(result.swap_free / (1024.0 * 1024.0), true));
-            facts.add(fact::swapsize, make_value<string_value>(si_string(result.swap_total), true));
+            facts.add(fact::swapsize, make_value<computed_value>(computed_value::size, result.swap_total, 0, true));
             facts.add(fact::swapsize_mb, make_value<double_value>(result.swap_total / (1024.0 * 1024.0), true));
             if (result.swap_encryption != encryption_status::unknown) {
                 facts.add(fact::swapencrypted, make_value<boolean_value>(result.swap_encryption == encryption_status::encrypted, true));
             }
         }
 
+        if (!result.numa_nodes.empty()) {
+            auto nodes = make_value<map_value>();
+            for (auto& node : result.numa_nodes) {
+                if (node.mem_total == 0) {
+                    continue;
+                }
+                uint64_t mem_used = node.mem_total - node.mem_free;
+
+                auto stats = make_value<map_value>();
+                stats->add("total", make_value<computed_value>(computed_value::size, node.mem_total));
+                stats->add("total_bytes", make_value<integer_value>(node.mem_total));
+                stats->add("used", make_value<computed_value>(computed_value::size, mem_used));
+                stats->add("used_bytes", make_value<integer_value>(mem_used));
+                stats->add("available", make_value<computed_value>(computed_value::size, node.mem_free));
+                stats->add("available_bytes", make_value<integer_value>(node.mem_free));
+                stats->add("capacity", make_value<computed_value>(computed_value::percentage, mem_used, node.mem_total));
+                nodes->add(move(node.name), move(stats));
+            }
+            if (!nodes->empty()) {
+                value->add("numa", move(nodes));
+            }
+        }
+
         if (!value->empty()) {
             facts.add(fact::memory, move(value));
         }
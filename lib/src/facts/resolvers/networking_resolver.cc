@@ -4,15 +4,31 @@
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include <facter/facts/scalar_value.hpp>
+#include <facter/util/string.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/format.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <sstream>
 
 using namespace std;
 
 namespace facter { namespace facts { namespace resolvers {
 
+    static void add_count(map_value& value, char const* name, boost::optional<uint64_t> const& count)
+    {
+        if (count) {
+            value.add(name, make_value<integer_value>(*count));
+        }
+    }
+
+    static void add_flag(map_value& value, char const* name, boost::optional<bool> const& flag)
+    {
+        if (flag) {
+            value.add(name, make_value<boolean_value>(*flag));
+        }
+    }
+
     networking_resolver::networking_resolver() :
         resolver(
             "networking",
@@ -108,6 +124,44 @@ namespace facter { namespace facts { namespace resolvers {
                 }
                 value->add("mtu", make_value<integer_value>(*interface.mtu));
             }
+            // Add the device attributes
+            if (!interface.driver.empty()) {
+                value->add("driver", make_value<string_value>(move(interface.driver)));
+            }
+            if (!interface.driver_version.empty()) {
+                value->add("driver_version", make_value<string_value>(move(interface.driver_version)));
+            }
+            if (!interface.firmware_version.empty()) {
+                value->add("firmware_version", make_value<string_value>(move(interface.firmware_version)));
+            }
+            if (interface.speed) {
+                value->add("speed", make_value<integer_value>(*interface.speed));
+            }
+            if (!interface.duplex.empty()) {
+                value->add("duplex", make_value<string_value>(move(interface.duplex)));
+            }
+            auto queues = make_value<map_value>();
+            add_count(*queues, "rx", interface.rx_queues);
+            add_count(*queues, "tx", interface.tx_queues);
+            add_count(*queues, "combined", interface.combined_queues);
+            if (!queues->empty()) {
+                value->add("queues", move(queues));
+            }
+            auto rings = make_value<map_value>();
+            add_count(*rings, "rx", interface.rx_ring);
+            add_count(*rings, "rx_max", interface.rx_ring_max);
+            add_count(*rings, "tx", interface.tx_ring);
+            add_count(*rings, "tx_max", interface.tx_ring_max);
+            if (!rings->empty()) {
+                value->add("rings", move(rings));
+            }
+            auto offloads = make_value<map_value>();
+            add_flag(*offloads, "tso", interface.tso);
+            add_flag(*offloads, "gro", interface.gro);
+            add_flag(*offloads, "lro", interface.lro);
+            if (!offloads->empty()) {
+                value->add("offloads", move(offloads));
+            }
 
             // Add the interface to the list of names
             if (interface_names.tellp() != 0) {
@@ -187,6 +241,15 @@ namespace facter { namespace facts { namespace resolvers {
         return addr.empty() || addr == "::1" || boost::starts_with(addr, "fe80");
     }
 
+    bool networking_resolver::include_interface(string const& name, vector<string> const& include, vector<string> const& exclude)
+    {
+        auto matches = [&](string const& pattern) { return util::wildcard_match(name, pattern); };
+        if (!include.empty() && none_of(include.begin(), include.end(), matches)) {
+            return false;
+        }
+        return none_of(exclude.begin(), exclude.end(), matches);
+    }
+
     networking_resolver::binding const* networking_resolver::find_default_binding(vector<binding> const& bindings, function<bool(string const&)> const& ignored)
     {
         for (auto& binding : bindings) {
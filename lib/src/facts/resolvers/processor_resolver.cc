@@ -4,10 +4,9 @@
 #include <facter/facts/scalar_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/array_value.hpp>
-#include <facter/util/string.hpp>
+#include <facter/facts/computed_value.hpp>
 
 using namespace std;
-using namespace facter::util;
 
 namespace facter { namespace facts { namespace resolvers {
 
@@ -48,7 +47,7 @@ namespace facter { namespace facts { namespace resolvers {
         }
 
         if (data.speed > 0) {
-            cpus->add("speed", make_value<string_value>(frequency(data.speed)));
+            cpus->add("speed", make_value<computed_value>(computed_value::frequency, data.speed));
         }
 
         auto models = make_value<array_value>();
@@ -62,6 +61,59 @@ namespace facter { namespace facts { namespace resolvers {
             cpus->add("models", move(models));
         }
 
+        if (!data.isa_features.empty()) {
+            auto features = make_value<array_value>();
+            for (auto& feature : data.isa_features) {
+                features->add(make_value<string_value>(move(feature)));
+            }
+            cpus->add("isa_features", move(features));
+        }
+
+        if (!data.vector_extensions.empty()) {
+            auto extensions = make_value<map_value>();
+            for (auto const& extension : data.vector_extensions) {
+                extensions->add(extension.first, make_value<boolean_value>(extension.second));
+            }
+            cpus->add("vector_extensions", move(extensions));
+        }
+
+        auto topology = make_value<map_value>();
+        if (!data.caches.empty()) {
+            auto caches = make_value<array_value>();
+            for (auto& cache : data.caches) {
+                auto value = make_value<map_value>();
+                value->add("level", make_value<integer_value>(cache.level));
+                if (!cache.type.empty()) {
+                    value->add("type", make_value<string_value>(move(cache.type)));
+                }
+                if (cache.size > 0) {
+                    value->add("size", make_value<computed_value>(computed_value::size, cache.size));
+                    value->add("size_bytes", make_value<integer_value>(static_cast<int64_t>(cache.size)));
+                }
+                if (cache.shared_cpus > 0) {
+                    value->add("shared_cpus", make_value<integer_value>(cache.shared_cpus));
+                }
+                value->add("count", make_value<integer_value>(cache.count));
+                caches->add(move(value));
+            }
+            topology->add("caches", move(caches));
+        }
+        if (!data.numa_nodes.empty()) {
+            auto nodes = make_value<map_value>();
+            for (auto& node : data.numa_nodes) {
+                auto value = make_value<map_value>();
+                if (!node.cpus.empty()) {
+                    value->add("cpus", make_value<string_value>(move(node.cpus)));
+                }
+                value->add("count", make_value<integer_value>(node.cpu_count));
+                nodes->add(move(node.name), move(value));
+            }
+            topology->add("numa_nodes", move(nodes));
+        }
+        if (!topology->empty()) {
+            cpus->add("topology", move(topology));
+        }
+
         if (!cpus->empty()) {
             facts.add(fact::processors, move(cpus));
         }
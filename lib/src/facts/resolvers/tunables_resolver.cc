@@ -0,0 +1,84 @@
+#include <internal/facts/resolvers/tunables_resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/facts/fact.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/array_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+using boost::lexical_cast;
+using boost::bad_lexical_cast;
+
+namespace facter { namespace facts { namespace resolvers {
+
+    tunables_resolver::tunables_resolver() :
+        resolver(
+            "tunables",
+            {
+                fact::tunables
+            })
+    {
+    }
+
+    void tunables_resolver::resolve(collection& facts)
+    {
+        auto result = collect_data(facts);
+        if (result.values.empty()) {
+            return;
+        }
+
+        auto value = make_value<map_value>();
+        for (auto const& kvp : result.values) {
+            value->add(kvp.first, parse_value(kvp.second));
+        }
+        facts.add(fact::tunables, move(value));
+    }
+
+    unique_ptr<value> tunables_resolver::parse_value(string const& text)
+    {
+        vector<string> tokens;
+        boost::split(tokens, text, boost::is_space(), boost::token_compress_on);
+        tokens.erase(remove(tokens.begin(), tokens.end(), string()), tokens.end());
+        if (tokens.empty()) {
+            return make_value<string_value>(text);
+        }
+
+        // An enumeration has exactly one selected option
+        string const* selected = nullptr;
+        for (auto const& token : tokens) {
+            if (token.size() > 2 && token.front() == '[' && token.back() == ']') {
+                if (selected) {
+                    selected = nullptr;
+                    break;
+                }
+                selected = &token;
+            }
+        }
+        if (selected) {
+            return make_value<string_value>(selected->substr(1, selected->size() - 2));
+        }
+
+        vector<int64_t> integers;
+        try {
+            for (auto const& token : tokens) {
+                integers.push_back(lexical_cast<int64_t>(token));
+            }
+        } catch (bad_lexical_cast&) {
+            // Not every token is an integer (or one is out of range)
+            return make_value<string_value>(text);
+        }
+        if (integers.size() == 1) {
+            return make_value<integer_value>(integers[0]);
+        }
+        auto array = make_value<array_value>();
+        for (auto integer : integers) {
+            array->add(make_value<integer_value>(integer));
+        }
+        return move(array);
+    }
+
+}}}  // namespace facter::facts::resolvers
@@ -11,6 +11,14 @@ using namespace YAML;
 
 namespace facter { namespace facts {
 
+    template <>
+    void scalar_value<string>::measure(memory_usage& usage) const
+    {
+        ++usage.nodes;
+        usage.node_bytes += sizeof(*this);
+        usage.string_bytes += memory_usage::allocated(_value);
+    }
+
     template <>
     void scalar_value<string>::to_json(json_allocator& allocator, json_value& value) const
     {
@@ -45,6 +53,13 @@ namespace facter { namespace facts {
         return emitter;
     }
 
+    template <>
+    yaml_writer& scalar_value<string>::write(yaml_writer& writer) const
+    {
+        writer.write(_value, needs_quotation(_value));
+        return writer;
+    }
+
     template <>
     ostream& scalar_value<bool>::write(ostream& os, bool quoted, unsigned int level) const
     {
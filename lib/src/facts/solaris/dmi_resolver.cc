@@ -3,13 +3,13 @@
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/util/regex.hpp>
 #include <boost/algorithm/string.hpp>
 
 using namespace std;
 using namespace leatherman::util;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace solaris {
 
@@ -4,7 +4,7 @@
 #include <leatherman/file_util/file.hpp>
 #include <facter/util/string.hpp>
 #include <leatherman/util/regex.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -80,7 +80,7 @@ namespace facter { namespace facts { namespace solaris {
     {
         // Build a list of mounted filesystems
         static boost::regex fs_re("^fs/.*/(.*)$");
-        leatherman::execution::each_line("/usr/sbin/sysdef", [&](string& line) {
+        facter::execution::each_line("/usr/sbin/sysdef", [&](string& line) {
             string fs;
             if (re_search(line, fs_re, &fs)) {
                 result.filesystems.insert(move(fs));
@@ -2,7 +2,7 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/util/regex.hpp>
 #include <facter/facts/map_value.hpp>
 #include <boost/algorithm/string.hpp>
@@ -11,7 +11,7 @@
 
 using namespace std;
 using namespace facter::facts;
-using namespace leatherman::execution;
+using namespace facter::execution;
 using namespace leatherman::util;
 
 namespace facter { namespace facts { namespace solaris {
@@ -1,6 +1,6 @@
 #include <internal/facts/solaris/memory_resolver.hpp>
 #include <internal/util/solaris/k_stat.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <leatherman/util/regex.hpp>
 #include <boost/algorithm/string.hpp>
@@ -11,7 +11,7 @@
 
 using namespace std;
 using namespace facter::util::solaris;
-using namespace leatherman::execution;
+using namespace facter::execution;
 using namespace leatherman::util;
 
 namespace facter { namespace facts { namespace solaris {
@@ -1,7 +1,7 @@
 #include <internal/facts/solaris/networking_resolver.hpp>
 #include <internal/util/posix/scoped_descriptor.hpp>
 #include <facter/util/string.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/algorithm/string.hpp>
 #include <sys/sockio.h>
@@ -10,7 +10,7 @@
 using namespace std;
 using namespace facter::util::posix;
 using namespace facter::util;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace solaris {
 
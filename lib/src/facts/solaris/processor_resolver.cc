@@ -1,7 +1,7 @@
 #include <internal/facts/solaris/processor_resolver.hpp>
 #include <internal/util/solaris/k_stat.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/util/regex.hpp>
 #include <unordered_set>
 #include <sys/processor.h>
@@ -9,7 +9,7 @@
 using namespace std;
 using namespace facter::util::solaris;
 using namespace leatherman::util;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 /*
  * https://blogs.oracle.com/mandalika/entry/solaris_show_me_the_cpu
@@ -1,13 +1,13 @@
 #include <internal/facts/solaris/zone_resolver.hpp>
 #include <facter/facts/collection.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/util/regex.hpp>
 #include <boost/algorithm/string.hpp>
 
 using namespace std;
 using namespace facter::facts;
 using namespace leatherman::util;
-using namespace leatherman::execution;
+using namespace facter::execution;
 
 namespace facter { namespace facts { namespace solaris {
 
@@ -0,0 +1,55 @@
+#include <facter/facts/value.hpp>
+#include <facter/facts/yaml_writer.hpp>
+#include <yaml-cpp/yaml.h>
+
+using namespace std;
+
+namespace facter { namespace facts {
+
+    memory_usage::memory_usage() :
+        nodes(0),
+        node_bytes(0),
+        string_bytes(0),
+        container_bytes(0)
+    {
+    }
+
+    size_t memory_usage::total() const
+    {
+        return node_bytes + string_bytes + container_bytes;
+    }
+
+    memory_usage& memory_usage::operator+=(memory_usage const& other)
+    {
+        nodes += other.nodes;
+        node_bytes += other.node_bytes;
+        string_bytes += other.string_bytes;
+        container_bytes += other.container_bytes;
+        return *this;
+    }
+
+    size_t memory_usage::allocated(string const& str)
+    {
+        // A string using the small string buffer stores its data within the object
+        auto data = reinterpret_cast<char const*>(str.data());
+        auto object = reinterpret_cast<char const*>(&str);
+        if (data >= object && data < object + sizeof(str)) {
+            return 0;
+        }
+        return str.capacity() + 1;
+    }
+
+    yaml_writer& value::write(yaml_writer& writer) const
+    {
+        YAML::Emitter emitter;
+        write(emitter);
+        writer.write_emitted(emitter.c_str());
+        return writer;
+    }
+
+    void value::measure(memory_usage& usage) const
+    {
+        ++usage.nodes;
+    }
+
+}}  // namespace facter::facts
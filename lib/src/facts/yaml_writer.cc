@@ -0,0 +1,484 @@
+#include <facter/facts/yaml_writer.hpp>
+#include <yaml-cpp/yaml.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+namespace facter { namespace facts {
+
+    // The size at which buffered output is written to the stream
+    static const size_t buffer_size = 64 * 1024;
+
+    // The indentation of nested collections
+    static const size_t indentation = 2;
+
+    // Keys longer than this are written as explicit ("? key") keys
+    static const size_t long_key_length = 1024;
+
+    static int double_precision()
+    {
+        // The emitter's default precision differs between yaml-cpp versions, so ask it once
+        static int const precision = []() {
+            YAML::Emitter emitter;
+            emitter << 1.0 / 3.0;
+            // One third is written as "0." followed by one digit per significant digit
+            size_t length = strlen(emitter.c_str());
+            return length > 2 ? static_cast<int>(length - 2) : numeric_limits<double>::max_digits10;
+        }();
+        return precision;
+    }
+
+    static bool is_blank_or_break(string const& s, size_t i)
+    {
+        if (i >= s.size()) {
+            return false;
+        }
+        char c = s[i];
+        return c == ' ' || c == '\t' || c == '\n' || (c == '\r' && i + 1 < s.size() && s[i + 1] == '\n');
+    }
+
+    static size_t break_length(string const& s, size_t i)
+    {
+        if (s[i] == '\n') {
+            return 1;
+        }
+        if (s[i] == '\r' && i + 1 < s.size() && s[i + 1] == '\n') {
+            return 2;
+        }
+        return 0;
+    }
+
+    static bool is_end(string const& s, size_t i)
+    {
+        // The end of input is indistinguishable from an EOT (0x04) character to the emitter
+        return i >= s.size() || s[i] == '\x04';
+    }
+
+    static bool is_not_printable(string const& s, size_t i)
+    {
+        auto c = static_cast<unsigned char>(s[i]);
+        if (c <= 0x08 || c == 0x0B || c == 0x0C || (c >= 0x0E && c <= 0x1F) || c == 0x7F) {
+            return true;
+        }
+        if (c == 0xC2 && i + 1 < s.size()) {
+            auto next = static_cast<unsigned char>(s[i + 1]);
+            return (next >= 0x80 && next <= 0x84) || (next >= 0x86 && next <= 0x9F);
+        }
+        return false;
+    }
+
+    static bool is_plain(string const& s)
+    {
+        // Empty and null-like strings must be quoted to round-trip
+        if (s.empty() || s == "~" || s == "null" || s == "Null" || s == "NULL") {
+            return false;
+        }
+
+        // Check for indicators at the start
+        if (is_blank_or_break(s, 0) || (s[0] && strchr(",[]{}#&*!|>'\"%@`", s[0]))) {
+            return false;
+        }
+        if ((s[0] == '-' || s[0] == '?' || s[0] == ':') && (is_blank_or_break(s, 1) || is_end(s, 1))) {
+            return false;
+        }
+
+        // Trailing spaces would not be preserved
+        if (s.back() == ' ') {
+            return false;
+        }
+
+        for (size_t i = 0; i < s.size(); ++i) {
+            char c = s[i];
+            if (c == ':' && (is_blank_or_break(s, i + 1) || is_end(s, i + 1))) {
+                return false;
+            }
+            // Tabs and breaks are never allowed, so only a space can start a comment
+            if (c == ' ' && i + 1 < s.size() && s[i + 1] == '#') {
+                return false;
+            }
+            if (c == '\t' || break_length(s, i) || is_not_printable(s, i)) {
+                return false;
+            }
+            if (c == '\xEF' && i + 2 < s.size() && s[i + 1] == '\xBB' && s[i + 2] == '\xBF') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const int replacement_character = 0xFFFD;
+
+    static int next_code_point(string const& s, size_t& i)
+    {
+        auto lead = static_cast<unsigned char>(s[i]);
+        int length;
+        switch (lead >> 4) {
+            case 12:
+            case 13:
+                length = 2;
+                break;
+            case 14:
+                length = 3;
+                break;
+            case 15:
+                length = 4;
+                break;
+            default:
+                ++i;
+                // Bytes 0x80-0xBF cannot start a sequence
+                return lead < 0x80 ? lead : replacement_character;
+        }
+
+        int code_point = lead & ~(0xFF << (7 - length));
+        ++i;
+        for (--length; length > 0; ++i, --length) {
+            if (i >= s.size() || (static_cast<unsigned char>(s[i]) & 0xC0) != 0x80) {
+                // Truncated sequence; the offending byte is decoded next
+                return replacement_character;
+            }
+            code_point = (code_point << 6) | (s[i] & 0x3F);
+        }
+
+        if (code_point > 0x10FFFF ||
+            (code_point >= 0xD800 && code_point <= 0xDFFF) ||
+            (code_point & 0xFFFE) == 0xFFFE ||
+            (code_point >= 0xFDD0 && code_point <= 0xFDEF)) {
+            return replacement_character;
+        }
+        return code_point;
+    }
+
+    yaml_writer::yaml_writer(ostream& stream) :
+        _stream(stream),
+        _column(0)
+    {
+        _buffer.reserve(buffer_size);
+    }
+
+    yaml_writer::~yaml_writer()
+    {
+        flush();
+    }
+
+    void yaml_writer::begin_map()
+    {
+        begin_group(true);
+    }
+
+    void yaml_writer::end_map()
+    {
+        end_group(true);
+    }
+
+    void yaml_writer::begin_sequence()
+    {
+        begin_group(false);
+    }
+
+    void yaml_writer::end_sequence()
+    {
+        end_group(false);
+    }
+
+    void yaml_writer::key(string const& key, bool quoted)
+    {
+        write_string(key, quoted);
+    }
+
+    void yaml_writer::write(string const& value, bool quoted)
+    {
+        write_string(value, quoted);
+    }
+
+    void yaml_writer::write(char const* value, bool quoted)
+    {
+        write_string(value ? value : "", quoted);
+    }
+
+    void yaml_writer::write(int64_t value)
+    {
+        char text[32];
+        int length = snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+        prepare(node::scalar);
+        write_scalar(text, static_cast<size_t>(length));
+    }
+
+    void yaml_writer::write(bool value)
+    {
+        prepare(node::scalar);
+        if (value) {
+            write_scalar("true", 4);
+        } else {
+            write_scalar("false", 5);
+        }
+    }
+
+    void yaml_writer::write(double value)
+    {
+        char text[32];
+        int length;
+        if (std::isnan(value)) {
+            length = snprintf(text, sizeof(text), ".nan");
+        } else if (std::isinf(value)) {
+            length = snprintf(text, sizeof(text), value < 0 ? "-.inf" : ".inf");
+        } else {
+            length = snprintf(text, sizeof(text), "%.*g", double_precision(), value);
+        }
+        prepare(node::scalar);
+        write_scalar(text, static_cast<size_t>(length));
+    }
+
+    void yaml_writer::write_emitted(string const& yaml)
+    {
+        // Empty collections and scalars are written on a single line
+        if (yaml == "{}" || yaml == "[]") {
+            begin_group(yaml == "{}");
+            end_group(yaml == "{}");
+            return;
+        }
+        if (yaml.find('\n') == string::npos) {
+            prepare(node::scalar);
+            write_scalar(yaml.data(), yaml.size());
+            return;
+        }
+
+        // Otherwise the node is a block collection; indent each of its lines to the depth of the node
+        bool sequence = yaml[0] == '-' && (yaml[1] == ' ' || yaml[1] == '\n');
+        prepare(sequence ? node::sequence : node::map);
+        started_node();
+        size_t indent = _groups.empty() ? 0 : _groups.back().indent + indentation;
+        for (size_t start = 0; start < yaml.size();) {
+            auto end = yaml.find('\n', start);
+            if (end == string::npos) {
+                end = yaml.size();
+            }
+            if (start > 0) {
+                put('\n');
+            }
+            indent_to(indent);
+            put(yaml.data() + start, end - start);
+            start = end + 1;
+        }
+    }
+
+    void yaml_writer::write_null()
+    {
+        prepare(node::scalar);
+        write_scalar("~", 1);
+    }
+
+    void yaml_writer::flush()
+    {
+        if (_buffer.empty()) {
+            return;
+        }
+        _stream.write(_buffer.data(), static_cast<streamsize>(_buffer.size()));
+        _buffer.clear();
+    }
+
+    void yaml_writer::prepare(node child)
+    {
+        // Top-level nodes need no preparation
+        if (_groups.empty()) {
+            return;
+        }
+
+        auto const& current = _groups.back();
+        if (!current.map) {
+            if (current.count > 0) {
+                put('\n');
+            }
+            indent_to(current.indent);
+            put('-');
+            if (child == node::scalar) {
+                indent_to(current.indent + indentation);
+            } else if (child == node::sequence) {
+                put('\n');
+            }
+            return;
+        }
+
+        if (current.count % 2 == 0) {
+            // Writing a key
+            if (current.count > 0) {
+                put('\n');
+            }
+            indent_to(current.indent);
+            if (current.long_key) {
+                put('?');
+                put(' ');
+            }
+            return;
+        }
+
+        // Writing a value
+        if (current.long_key) {
+            put('\n');
+            indent_to(current.indent);
+            put(':');
+            if (child == node::scalar) {
+                put(' ');
+            }
+            return;
+        }
+        put(':');
+        if (child == node::scalar) {
+            put(' ');
+            indent_to(current.indent + indentation);
+        } else {
+            put('\n');
+        }
+    }
+
+    void yaml_writer::begin_group(bool map)
+    {
+        prepare(map ? node::map : node::sequence);
+        started_node();
+        _groups.push_back({ map, _groups.empty() ? 0 : _groups.back().indent + indentation, 0, false });
+    }
+
+    void yaml_writer::end_group(bool map)
+    {
+        if (_groups.empty()) {
+            return;
+        }
+
+        // Empty collections are written in flow style
+        auto const& current = _groups.back();
+        if (current.count == 0) {
+            indent_to(current.indent);
+            if (map) {
+                put("{}", 2);
+            } else {
+                put("[]", 2);
+            }
+        }
+        _groups.pop_back();
+    }
+
+    void yaml_writer::started_node()
+    {
+        if (_groups.empty()) {
+            return;
+        }
+        auto& current = _groups.back();
+        if (++current.count % 2 == 0) {
+            current.long_key = false;
+        }
+    }
+
+    void yaml_writer::write_string(string const& value, bool quoted)
+    {
+        if (value.size() > long_key_length && !_groups.empty() && _groups.back().map && _groups.back().count % 2 == 0) {
+            _groups.back().long_key = true;
+        }
+        prepare(node::scalar);
+        if (quoted || !is_plain(value)) {
+            write_double_quoted(value);
+        } else {
+            put(value.data(), value.size());
+        }
+        started_node();
+    }
+
+    void yaml_writer::write_scalar(char const* text, size_t length)
+    {
+        put(text, length);
+        started_node();
+    }
+
+    void yaml_writer::write_double_quoted(string const& value)
+    {
+        static char const digits[] = "0123456789abcdef";
+
+        put('"');
+        for (size_t i = 0; i < value.size();) {
+            int code_point = next_code_point(value, i);
+            switch (code_point) {
+                case '"':
+                    put("\\\"", 2);
+                    continue;
+                case '\\':
+                    put("\\\\", 2);
+                    continue;
+                case '\n':
+                    put("\\n", 2);
+                    continue;
+                case '\t':
+                    put("\\t", 2);
+                    continue;
+                case '\r':
+                    put("\\r", 2);
+                    continue;
+                case '\b':
+                    put("\\b", 2);
+                    continue;
+                case '\f':
+                    put("\\f", 2);
+                    continue;
+                default:
+                    break;
+            }
+
+            if (code_point < 0x20 || (code_point >= 0x80 && code_point <= 0xA0) || code_point == 0xFEFF) {
+                // Escape control characters, non-breaking space and byte order marks
+                char escape[11] = { '\\' };
+                size_t count = 4;
+                escape[1] = 'u';
+                if (code_point < 0xFF) {
+                    count = 2;
+                    escape[1] = 'x';
+                }
+                for (size_t digit = 0; digit < count; ++digit) {
+                    escape[2 + digit] = digits[(code_point >> (4 * (count - digit - 1))) & 0xF];
+                }
+                put(escape, 2 + count);
+            } else if (code_point < 0x80) {
+                put(static_cast<char>(code_point));
+            } else if (code_point < 0x800) {
+                put(static_cast<char>(0xC0 | (code_point >> 6)));
+                put(static_cast<char>(0x80 | (code_point & 0x3F)));
+            } else if (code_point < 0x10000) {
+                put(static_cast<char>(0xE0 | (code_point >> 12)));
+                put(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                put(static_cast<char>(0x80 | (code_point & 0x3F)));
+            } else {
+                put(static_cast<char>(0xF0 | (code_point >> 18)));
+                put(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+                put(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                put(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+        }
+        put('"');
+    }
+
+    void yaml_writer::indent_to(size_t column)
+    {
+        while (_column < column) {
+            put(' ');
+        }
+    }
+
+    void yaml_writer::put(char c)
+    {
+        _buffer.push_back(c);
+        _column = c == '\n' ? 0 : _column + 1;
+        if (_buffer.size() >= buffer_size) {
+            flush();
+        }
+    }
+
+    void yaml_writer::put(char const* text, size_t length)
+    {
+        // Scalars never contain line breaks, so the column simply advances
+        _buffer.append(text, length);
+        _column += length;
+        if (_buffer.size() >= buffer_size) {
+            flush();
+        }
+    }
+
+}}  // namespace facter::facts
@@ -3,6 +3,7 @@
 #include <facter/facts/scalar_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include <facter/facts/map_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <facter/logging/logging.hpp>
 #include <facter/export.h>
 #include <boost/nowide/iostream.hpp>
@@ -53,6 +54,9 @@ static jobject to_object(JNIEnv* env, value const* val)
     if (auto ptr = dynamic_cast<string_value const*>(val)) {
         return env->NewStringUTF(ptr->value().c_str());
     }
+    if (auto ptr = dynamic_cast<computed_value const*>(val)) {
+        return env->NewStringUTF(ptr->value().c_str());
+    }
     if (auto ptr = dynamic_cast<integer_value const*>(val)) {
         return env->NewObject(long_class, long_constructor, static_cast<jlong>(ptr->value()));
     }
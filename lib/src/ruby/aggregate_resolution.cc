@@ -49,17 +49,12 @@ namespace facter { namespace ruby {
             return ruby.rb_funcall(_block, ruby.rb_intern("call"), 1, result);
         }
 
-        // Otherwise perform a default aggregation by doing a deep merge
-        volatile VALUE merged = ruby.nil_value();
+        // Otherwise perform a default aggregation by doing a deep merge of all chunks at once
+        volatile VALUE values = ruby.rb_ary_new_capa(static_cast<long>(_chunks.size()));
         for (auto& chunk : _chunks) {
-            volatile VALUE value = chunk.second.value(*this);
-            if (ruby.is_nil(merged)) {
-                merged = value;
-                continue;
-            }
-            merged = deep_merge(ruby, merged, value);
+            ruby.rb_ary_push(values, chunk.second.value(*this));
         }
-        return merged;
+        return deep_merge_all(ruby, values);
     }
 
     VALUE aggregate_resolution::find_chunk(VALUE name)
@@ -242,4 +237,89 @@ namespace facter { namespace ruby {
         return result;
     }
 
+    VALUE aggregate_resolution::deep_merge_all(api const& ruby, VALUE values)
+    {
+        // Merge all of the values in a single pass rather than folding them pairwise
+        // Folding copies the accumulated result for every value, which is quadratic in the number of values
+        long count = ruby.array_len(values);
+        long non_nil = 0;
+        long arrays = 0;
+        long hashes = 0;
+        long length = 0;
+        volatile VALUE last = ruby.nil_value();
+        for (long i = 0; i < count; ++i) {
+            VALUE value = ruby.rb_ary_entry(values, i);
+            if (ruby.is_nil(value)) {
+                continue;
+            }
+            ++non_nil;
+            last = value;
+            if (ruby.is_array(value)) {
+                ++arrays;
+                length += ruby.array_len(value);
+            } else if (ruby.is_hash(value)) {
+                ++hashes;
+            }
+        }
+
+        // Nil values are ignored, so with at most one other value there is nothing to merge
+        if (non_nil <= 1) {
+            return last;
+        }
+
+        volatile VALUE result = ruby.nil_value();
+        if (arrays == non_nil) {
+            // Append the elements of every array to a single array
+            result = ruby.rb_ary_new_capa(length);
+            for (long i = 0; i < count; ++i) {
+                VALUE value = ruby.rb_ary_entry(values, i);
+                if (ruby.is_nil(value)) {
+                    continue;
+                }
+                long size = ruby.array_len(value);
+                for (long j = 0; j < size; ++j) {
+                    ruby.rb_ary_push(result, ruby.rb_ary_entry(value, j));
+                }
+            }
+            return result;
+        }
+
+        if (hashes == non_nil) {
+            // Group the values of each key in the order the keys are first seen, then merge each group once
+            volatile VALUE groups = ruby.rb_hash_new();
+            for (long i = 0; i < count; ++i) {
+                VALUE value = ruby.rb_ary_entry(values, i);
+                if (ruby.is_nil(value)) {
+                    continue;
+                }
+                ruby.hash_for_each(value, [&](VALUE key, VALUE element) {
+                    VALUE group = ruby.rb_hash_lookup(groups, key);
+                    if (ruby.is_nil(group)) {
+                        group = ruby.rb_ary_new_capa(1);
+                        ruby.rb_hash_aset(groups, key, group);
+                    }
+                    ruby.rb_ary_push(group, element);
+                    return true;
+                });
+            }
+
+            result = ruby.rb_hash_new();
+            ruby.hash_for_each(groups, [&](VALUE key, VALUE group) {
+                ruby.rb_hash_aset(result, key, ruby.array_len(group) == 1 ? ruby.rb_ary_entry(group, 0) : deep_merge_all(ruby, group));
+                return true;
+            });
+            return result;
+        }
+
+        // The values cannot all be merged together; fold them pairwise so the failing pair is reported
+        for (long i = 0; i < count; ++i) {
+            VALUE value = ruby.rb_ary_entry(values, i);
+            if (ruby.is_nil(value)) {
+                continue;
+            }
+            result = ruby.is_nil(result) ? value : deep_merge(ruby, result, value);
+        }
+        return result;
+    }
+
 }}  // namespace facter::ruby
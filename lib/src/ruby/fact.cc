@@ -3,6 +3,7 @@
 #include <internal/ruby/module.hpp>
 #include <internal/ruby/simple_resolution.hpp>
 #include <internal/ruby/ruby_value.hpp>
+#include <internal/util/timeline.hpp>
 #include <facter/facts/collection.hpp>
 #include <leatherman/util/environment.hpp>
 #include <leatherman/logging/logging.hpp>
@@ -93,32 +94,52 @@ namespace facter { namespace ruby {
         }
 
         if (ruby.is_nil(_value)) {
-            vector<VALUE>::iterator it;
-            ruby.rescue([&]() {
-                volatile VALUE value = ruby.nil_value();
-
-                // Look through the resolutions and find the first allowed resolution that resolves
-                for (it = _resolutions.begin(); it != _resolutions.end(); ++it) {
-                    auto res = ruby.to_native<resolution>(*it);
-                    if (!res->suitable(*facter)) {
-                        continue;
+            string name = ruby.to_string(_name);
+            auto const& cache = facter->cache();
+            // The span is declared outside of the rescue so it is not skipped by a Ruby exception
+            facter::util::timeline::span span("ruby", name);
+            volatile VALUE value = ruby.nil_value();
+            VALUE cached = ruby.nil_value();
+            bool failed = false;
+
+            // Look through the resolutions and find the first allowed resolution that resolves
+            for (auto it = _resolutions.begin(); it != _resolutions.end(); ++it) {
+                auto res = ruby.to_native<resolution>(*it);
+
+                // An unexpired cached value is used without evaluating the confines or the resolution
+                // The cache creates C++ objects, so it is used outside of the rescue below
+                if (res->cache_ttl() && cache.load(name, res->cache_file(), res->cache_ttl(), cached)) {
+                    value = cached;
+                    break;
+                }
+
+                ruby.rescue([&]() {
+                    // Do not declare any C++ objects inside the rescue
+                    // Their destructors will not be invoked if there is a Ruby exception
+                    if (res->suitable(*facter)) {
+                        value = res->value();
                     }
-                    value = res->value();
-                    if (!ruby.is_nil(value)) {
-                        break;
+                    return 0;
+                }, [&](VALUE ex) {
+                    LOG_ERROR("error while resolving custom fact \"%1%\": %2%", ruby.rb_string_value_ptr(&_name), ruby.exception_to_string(ex));
+                    failed = true;
+                    return 0;
+                });
+                if (failed) {
+                    // Failed, so set to nil
+                    value = ruby.nil_value();
+                    break;
+                }
+                if (!ruby.is_nil(value)) {
+                    if (res->cache_ttl()) {
+                        cache.store(name, res->cache_file(), value);
                     }
+                    break;
                 }
+            }
 
-                // Set the value to what was resolved
-                _value = value;
-                return 0;
-            }, [&](VALUE ex) {
-                LOG_ERROR("error while resolving custom fact \"%1%\": %2%", ruby.rb_string_value_ptr(&_name), ruby.exception_to_string(ex));
-
-                // Failed, so set to nil
-                _value = ruby.nil_value();
-                return 0;
-            });
+            // Set the value to what was resolved
+            _value = value;
         }
 
         if (add) {
@@ -174,6 +195,8 @@ namespace facter { namespace ruby {
         bool aggregate = false;
         bool has_weight = false;
         size_t weight = 0;
+        bool has_cache_ttl = false;
+        size_t cache_ttl = 0;
         volatile VALUE resolution_value = ruby.nil_value();
 
         // Read the options if provided
@@ -184,6 +207,7 @@ namespace facter { namespace ruby {
             ID value_id = ruby.rb_intern("value");
             ID weight_id = ruby.rb_intern("weight");
             ID timeout_id = ruby.rb_intern("timeout");
+            ID cache_ttl_id = ruby.rb_intern("cache_ttl");
 
             if (!ruby.is_hash(options)) {
                 ruby.rb_raise(*ruby.rb_eTypeError, "expected a Hash for the options");
@@ -211,6 +235,10 @@ namespace facter { namespace ruby {
                     // Handle the weight option
                     has_weight = true;
                     weight = ruby.num2size_t(value);
+                } else if (key_id == cache_ttl_id) {
+                    // Handle the cache TTL option
+                    has_cache_ttl = true;
+                    cache_ttl = ruby.num2size_t(value);
                 } else if (key_id == timeout_id) {
                     // Ignore timeout as it isn't supported
                     static bool timeout_warning = true;
@@ -257,6 +285,9 @@ namespace facter { namespace ruby {
         if (has_weight) {
             res->weight(weight);
         }
+        if (has_cache_ttl) {
+            res->cache_ttl(static_cast<uint32_t>(cache_ttl));
+        }
 
         // Call the block if one was given
         if (ruby.rb_block_given_p()) {
@@ -279,6 +310,23 @@ namespace facter { namespace ruby {
         _value = ruby.nil_value();
     }
 
+    void fact::flush_cache()
+    {
+        auto const& ruby = api::instance();
+        auto const& cache = module::current()->cache();
+
+        // Remove the cached values of every caching resolution
+        string name = ruby.to_string(_name);
+        for (auto r : _resolutions) {
+            auto res = ruby.to_native<resolution>(r);
+            if (res->cache_ttl()) {
+                cache.remove(name, res->cache_file());
+            }
+        }
+
+        flush();
+    }
+
     VALUE fact::alloc(VALUE klass)
     {
         auto const& ruby = api::instance();
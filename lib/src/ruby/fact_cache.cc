@@ -0,0 +1,185 @@
+#include <internal/ruby/fact_cache.hpp>
+#include <internal/ruby/ruby_value.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <boost/filesystem.hpp>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <cctype>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace facter::facts;
+using namespace leatherman::ruby;
+using namespace rapidjson;
+namespace lth_file = leatherman::file_util;
+namespace fs = boost::filesystem;
+
+namespace facter { namespace ruby {
+
+    static VALUE to_ruby(api const& ruby, json_value const& json)
+    {
+        if (json.IsBool()) {
+            return json.GetBool() ? ruby.true_value() : ruby.false_value();
+        }
+        if (json.IsInt64()) {
+            return ruby.rb_int2inum(static_cast<SIGNED_VALUE>(json.GetInt64()));
+        }
+        if (json.IsNumber()) {
+            return ruby.rb_float_new_in_heap(json.GetDouble());
+        }
+        if (json.IsString()) {
+            return ruby.utf8_value(string(json.GetString(), json.GetStringLength()));
+        }
+        if (json.IsArray()) {
+            volatile VALUE array = ruby.rb_ary_new_capa(static_cast<long>(json.Size()));
+            for (auto it = json.Begin(); it != json.End(); ++it) {
+                ruby.rb_ary_push(array, to_ruby(ruby, *it));
+            }
+            return array;
+        }
+        if (json.IsObject()) {
+            volatile VALUE hash = ruby.rb_hash_new();
+            for (auto it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
+                ruby.rb_hash_aset(hash, ruby.utf8_value(string(it->name.GetString(), it->name.GetStringLength())), to_ruby(ruby, it->value));
+            }
+            return hash;
+        }
+        return ruby.nil_value();
+    }
+
+    fact_cache::fact_cache(string directory) :
+        _directory(move(directory))
+    {
+    }
+
+    string const& fact_cache::directory() const
+    {
+        return _directory;
+    }
+
+    void fact_cache::directory(string directory)
+    {
+        _directory = move(directory);
+    }
+
+    string fact_cache::path(string const& fact, string const& file) const
+    {
+        if (_directory.empty()) {
+            return {};
+        }
+
+        // Use a FNV-1a hash of the source file so resolutions of the same fact in different files don't collide
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : file) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+
+        string name = fact;
+        for (auto& c : name) {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-') {
+                c = '_';
+            }
+        }
+
+        ostringstream filename;
+        filename << name << '-' << hex << setw(16) << setfill('0') << hash << ".json";
+        return (fs::path(_directory) / filename.str()).string();
+    }
+
+    bool fact_cache::load(string const& fact, string const& file, uint32_t ttl, VALUE& value) const
+    {
+        auto entry = path(fact, file);
+        if (entry.empty()) {
+            return false;
+        }
+
+        string contents;
+        if (!lth_file::read(entry, contents)) {
+            return false;
+        }
+
+        json_document document;
+        document.Parse(contents.c_str());
+        if (document.HasParseError() || !document.IsObject() || !document.HasMember("timestamp") || !document.HasMember("value")) {
+            LOG_DEBUG("ignoring invalid custom fact cache entry %1%.", entry);
+            return false;
+        }
+
+        auto const& timestamp = document["timestamp"];
+        if (!timestamp.IsInt64()) {
+            LOG_DEBUG("ignoring invalid custom fact cache entry %1%.", entry);
+            return false;
+        }
+
+        auto age = static_cast<int64_t>(time(nullptr)) - timestamp.GetInt64();
+        if (age < 0 || age >= static_cast<int64_t>(ttl)) {
+            LOG_DEBUG("custom fact cache entry for fact \"%1%\" has expired.", fact);
+            return false;
+        }
+
+        LOG_DEBUG("using cached value for custom fact \"%1%\" from %2%.", fact, entry);
+        value = to_ruby(api::instance(), document["value"]);
+        return true;
+    }
+
+    void fact_cache::store(string const& fact, string const& file, VALUE value) const
+    {
+        auto entry = path(fact, file);
+        if (entry.empty()) {
+            return;
+        }
+
+        boost::system::error_code ec;
+        fs::create_directories(_directory, ec);
+        if (ec) {
+            LOG_DEBUG("cannot create custom fact cache directory %1%: %2%.", _directory, ec.message());
+            return;
+        }
+
+        json_document document;
+        document.SetObject();
+        json_value json;
+        ruby_value(value).to_json(document.GetAllocator(), json);
+        document.AddMember("timestamp", static_cast<int64_t>(time(nullptr)), document.GetAllocator());
+        document.AddMember("value", json, document.GetAllocator());
+
+        StringBuffer buffer;
+        Writer<StringBuffer> writer(buffer);
+        document.Accept(writer);
+
+        // Write to a temporary file and rename it so readers never see a partial entry
+        string temporary = entry + ".tmp";
+        {
+            ofstream stream(temporary, ios::binary | ios::trunc);
+            if (!stream || !(stream << buffer.GetString())) {
+                LOG_DEBUG("cannot write custom fact cache entry %1%.", entry);
+                return;
+            }
+        }
+        fs::rename(temporary, entry, ec);
+        if (ec) {
+            LOG_DEBUG("cannot write custom fact cache entry %1%: %2%.", entry, ec.message());
+            fs::remove(temporary, ec);
+        }
+    }
+
+    void fact_cache::remove(string const& fact, string const& file) const
+    {
+        auto entry = path(fact, file);
+        if (entry.empty()) {
+            return;
+        }
+
+        boost::system::error_code ec;
+        if (fs::remove(entry, ec)) {
+            LOG_DEBUG("removed custom fact cache entry for fact \"%1%\".", fact);
+        }
+    }
+
+}}  // namespace facter::ruby
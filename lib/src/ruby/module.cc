@@ -7,7 +7,7 @@
 #include <facter/version.h>
 #include <facter/export.h>
 #include <leatherman/util/environment.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 #include <leatherman/file_util/directory.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/filesystem.hpp>
@@ -19,11 +19,13 @@
 #include <facter/facts/scalar_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include <facter/facts/map_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <internal/ruby/ruby_value.hpp>
+#include <internal/util/cache.hpp>
 
 using namespace std;
 using namespace facter::facts;
-using namespace leatherman::execution;
+using namespace facter::execution;
 using namespace leatherman::file_util;
 using namespace leatherman::util;
 using namespace boost::filesystem;
@@ -163,6 +165,7 @@ namespace facter { namespace ruby {
 
     module::module(collection& facts, vector<string> const& paths, bool logging_hooks) :
         _collection(facts),
+        _cache(util::cache_directory("custom_facts")),
         _loaded_all(false)
     {
         auto const& ruby = api::instance();
@@ -221,7 +224,7 @@ namespace facter { namespace ruby {
         ruby.rb_define_singleton_method(_self, "log_exception", RUBY_METHOD_FUNC(ruby_log_exception), -1);
         ruby.rb_define_singleton_method(_self, "debugging?", RUBY_METHOD_FUNC(ruby_get_debugging), 0);
         ruby.rb_define_singleton_method(_self, "trace?", RUBY_METHOD_FUNC(ruby_get_trace), 0);
-        ruby.rb_define_singleton_method(_self, "flush", RUBY_METHOD_FUNC(ruby_flush), 0);
+        ruby.rb_define_singleton_method(_self, "flush", RUBY_METHOD_FUNC(ruby_flush), -1);
         ruby.rb_define_singleton_method(_self, "list", RUBY_METHOD_FUNC(ruby_list), 0);
         ruby.rb_define_singleton_method(_self, "to_hash", RUBY_METHOD_FUNC(ruby_to_hash), 0);
         ruby.rb_define_singleton_method(_self, "each", RUBY_METHOD_FUNC(ruby_each), 0);
@@ -375,6 +378,9 @@ namespace facter { namespace ruby {
         if (auto ptr = dynamic_cast<string_value const*>(val)) {
             return ruby.utf8_value(ptr->value());
         }
+        if (auto ptr = dynamic_cast<computed_value const*>(val)) {
+            return ruby.utf8_value(ptr->value());
+        }
         if (auto ptr = dynamic_cast<integer_value const*>(val)) {
             return ruby.rb_int2inum(static_cast<SIGNED_VALUE>(ptr->value()));
         }
@@ -433,6 +439,11 @@ namespace facter { namespace ruby {
         return _collection;
     }
 
+    fact_cache& module::cache()
+    {
+        return _cache;
+    }
+
     VALUE module::self() const
     {
         return _self;
@@ -623,12 +634,24 @@ namespace facter { namespace ruby {
         });
     }
 
-    VALUE module::ruby_flush(VALUE self)
+    VALUE module::ruby_flush(int argc, VALUE* argv, VALUE self)
     {
         return safe_eval("Facter.flush", [&]() {
             auto const& ruby = api::instance();
+            auto instance = from_self(self);
+
+            // Flushing specific facts also removes their cached values
+            if (argc > 0) {
+                for (int i = 0; i < argc; ++i) {
+                    auto it = instance->_facts.find(ruby.to_string(instance->normalize(argv[i])));
+                    if (it != instance->_facts.end()) {
+                        ruby.to_native<fact>(it->second)->flush_cache();
+                    }
+                }
+                return ruby.nil_value();
+            }
 
-            for (auto& kvp : from_self(self)->_facts)
+            for (auto& kvp : instance->_facts)
             {
                 ruby.to_native<fact>(kvp.second)->flush();
             }
@@ -696,7 +719,7 @@ namespace facter { namespace ruby {
         return safe_eval("Facter.clear", [&]() {
             auto const& ruby = api::instance();
 
-            ruby_flush(self);
+            ruby_flush(0, nullptr, self);
             ruby_reset(self);
 
             return ruby.nil_value();
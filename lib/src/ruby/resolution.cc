@@ -1,6 +1,7 @@
 #include <internal/ruby/resolution.hpp>
 #include <internal/ruby/module.hpp>
 #include <leatherman/logging/logging.hpp>
+#include <cctype>
 
 using namespace std;
 using namespace facter::facts;
@@ -10,7 +11,8 @@ namespace facter { namespace ruby {
 
     resolution::resolution() :
         _has_weight(false),
-        _weight(0)
+        _weight(0),
+        _cache_ttl(0)
     {
         auto const& ruby = api::instance();
         _name = ruby.nil_value();
@@ -56,6 +58,43 @@ namespace facter { namespace ruby {
         _value = v;
     }
 
+    uint32_t resolution::cache_ttl() const
+    {
+        return _cache_ttl;
+    }
+
+    string const& resolution::cache_file() const
+    {
+        return _cache_file;
+    }
+
+    void resolution::cache_ttl(uint32_t ttl)
+    {
+        auto const& ruby = api::instance();
+
+        _cache_ttl = ttl;
+        _cache_file.clear();
+
+        // Find the first Ruby source file on the call stack; that's the file declaring the resolution
+        volatile VALUE callers = ruby.rb_funcall(module::current()->self(), ruby.rb_intern("caller"), 0);
+        ruby.array_for_each(callers, [&](VALUE entry) {
+            string location = ruby.to_string(entry);
+
+            // Entries are of the form "file:line" or "file:line:in `method'"; skip a possible drive letter
+            for (auto pos = location.find(':', 2); pos != string::npos; pos = location.find(':', pos + 1)) {
+                if (pos + 1 < location.size() && isdigit(static_cast<unsigned char>(location[pos + 1]))) {
+                    location.resize(pos);
+                    break;
+                }
+            }
+            if (location.size() > 3 && location.compare(location.size() - 3, 3, ".rb") == 0) {
+                _cache_file = move(location);
+                return false;
+            }
+            return true;
+        });
+    }
+
     bool resolution::suitable(module& facter) const
     {
         auto const& ruby = api::instance();
@@ -150,6 +189,7 @@ namespace facter { namespace ruby {
         ruby.rb_define_method(klass, "name", RUBY_METHOD_FUNC(ruby_name), 0);
         ruby.rb_define_method(klass, "timeout=", RUBY_METHOD_FUNC(ruby_timeout), 1);
         ruby.rb_define_method(klass, "on_flush", RUBY_METHOD_FUNC(ruby_on_flush), 0);
+        ruby.rb_define_method(klass, "cache_ttl", RUBY_METHOD_FUNC(ruby_cache_ttl), 1);
     }
 
     void resolution::mark() const
@@ -218,4 +258,11 @@ namespace facter { namespace ruby {
         return self;
     }
 
+    VALUE resolution::ruby_cache_ttl(VALUE self, VALUE ttl)
+    {
+        auto const& ruby = api::instance();
+        ruby.to_native<resolution>(self)->cache_ttl(static_cast<uint32_t>(ruby.num2size_t(ttl)));
+        return self;
+    }
+
 }}  // namespace facter::ruby
@@ -1,4 +1,5 @@
 #include <internal/ruby/ruby_value.hpp>
+#include <facter/facts/yaml_writer.hpp>
 #include <facter/util/string.hpp>
 #include <rapidjson/document.h>
 #include <yaml-cpp/yaml.h>
@@ -59,6 +60,20 @@ namespace facter { namespace ruby {
         return emitter;
     }
 
+    yaml_writer& ruby_value::write(yaml_writer& writer) const
+    {
+        auto const& ruby = api::instance();
+        write(ruby, _value, writer);
+        return writer;
+    }
+
+    void ruby_value::measure(memory_usage& usage) const
+    {
+        auto const& ruby = api::instance();
+        usage.node_bytes += sizeof(*this);
+        measure(ruby, _value, usage);
+    }
+
     VALUE ruby_value::value() const
     {
         return _value;
@@ -272,6 +287,94 @@ namespace facter { namespace ruby {
         emitter << Null;
     }
 
+    void ruby_value::write(api const& ruby, VALUE value, yaml_writer& writer)
+    {
+        if (ruby.is_true(value)) {
+            writer.write(true);
+            return;
+        }
+        if (ruby.is_false(value)) {
+            writer.write(false);
+            return;
+        }
+        if (ruby.is_string(value) || ruby.is_symbol(value)) {
+            auto str = ruby.to_string(value);
+            writer.write(str, needs_quotation(str));
+            return;
+        }
+        if (ruby.is_fixednum(value) || ruby.is_bignum(value)) {
+            writer.write(static_cast<int64_t>(ruby.rb_num2ll(value)));
+            return;
+        }
+        if (ruby.is_float(value)) {
+            writer.write(ruby.rb_num2dbl(value));
+            return;
+        }
+        if (ruby.is_array(value)) {
+            writer.begin_sequence();
+            ruby.array_for_each(value, [&](VALUE element) {
+                write(ruby, element, writer);
+                return true;
+            });
+            writer.end_sequence();
+            return;
+        }
+        if (ruby.is_hash(value)) {
+            writer.begin_map();
+            ruby.hash_for_each(value, [&](VALUE key, VALUE element) {
+                writer.key(ruby.to_string(key));
+                write(ruby, element, writer);
+                return true;
+            });
+            writer.end_map();
+            return;
+        }
+
+        writer.write_null();
+    }
+
+    void ruby_value::measure(api const& ruby, VALUE value, memory_usage& usage)
+    {
+        // Estimates for a 64-bit Ruby: every heap object occupies a 40 byte slot and short strings are embedded in it
+        static const size_t object_size = 40;
+        static const size_t embedded_string_size = 23;
+
+        ++usage.nodes;
+        if (ruby.is_string(value)) {
+            usage.node_bytes += object_size;
+            auto size = ruby.to_string(value).size();
+            if (size > embedded_string_size) {
+                usage.string_bytes += size + 1;
+            }
+            return;
+        }
+        if (ruby.is_bignum(value)) {
+            usage.node_bytes += object_size;
+            return;
+        }
+        if (ruby.is_array(value)) {
+            usage.node_bytes += object_size;
+            ruby.array_for_each(value, [&](VALUE element) {
+                usage.container_bytes += sizeof(VALUE);
+                measure(ruby, element, usage);
+                return true;
+            });
+            return;
+        }
+        if (ruby.is_hash(value)) {
+            usage.node_bytes += object_size;
+            ruby.hash_for_each(value, [&](VALUE key, VALUE element) {
+                // Each entry stores the hash code, the key and the value
+                usage.container_bytes += 3 * sizeof(VALUE);
+                measure(ruby, key, usage);
+                measure(ruby, element, usage);
+                return true;
+            });
+            return;
+        }
+        // Everything else (nil, booleans, fixnums, floats and symbols) is stored in the VALUE itself
+    }
+
     ruby_value const* ruby_value::wrap_child(VALUE child, string key) const {
         return _children.emplace(move(key), std::unique_ptr<ruby_value>(new ruby_value(child))).first->second.get();
     }
@@ -1,10 +1,10 @@
 #include <internal/ruby/simple_resolution.hpp>
 #include <internal/ruby/module.hpp>
-#include <leatherman/execution/execution.hpp>
+#include <internal/execution/execution.hpp>
 
 using namespace std;
 using namespace facter::facts;
-using namespace leatherman::execution;
+using namespace facter::execution;
 using namespace leatherman::ruby;
 
 namespace facter { namespace ruby {
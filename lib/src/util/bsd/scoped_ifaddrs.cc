@@ -1,16 +1,130 @@
 #include <internal/util/bsd/scoped_ifaddrs.hpp>
+#include <internal/util/host.hpp>
+#include <facter/util/string.hpp>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <netpacket/packet.h>
+#endif
 
 using namespace std;
 using namespace leatherman::util;
 
 namespace facter { namespace util { namespace bsd {
 
+    // An interface address served from a host snapshot; the entry comes first so the list can be freed through it
+    struct replayed_address
+    {
+        ifaddrs entry;
+        char name[IFNAMSIZ];
+        sockaddr_storage address;
+        sockaddr_storage netmask;
+    };
+
+    static size_t address_length(sockaddr const* addr)
+    {
+        if (!addr) {
+            return 0;
+        }
+#ifdef __linux__
+        switch (addr->sa_family) {
+            case AF_INET:
+                return sizeof(sockaddr_in);
+            case AF_INET6:
+                return sizeof(sockaddr_in6);
+            case AF_PACKET:
+                return sizeof(sockaddr_ll);
+            default:
+                return 0;
+        }
+#else
+        return addr->sa_len;
+#endif
+    }
+
+    static string encode_address(sockaddr const* addr)
+    {
+        auto length = min(address_length(addr), sizeof(sockaddr_storage));
+        return length ? to_hex(reinterpret_cast<uint8_t const*>(addr), length) : string();
+    }
+
+    static sockaddr* decode_address(string const& hex, sockaddr_storage& storage)
+    {
+        if (hex.empty() || hex.size() % 2 != 0 || hex.size() / 2 > sizeof(storage)) {
+            return nullptr;
+        }
+        auto bytes = reinterpret_cast<uint8_t*>(&storage);
+        for (size_t i = 0; i < hex.size(); i += 2) {
+            char digits[3] = { hex[i], hex[i + 1], '\0' };
+            bytes[i / 2] = static_cast<uint8_t>(strtoul(digits, nullptr, 16));
+        }
+        return reinterpret_cast<sockaddr*>(&storage);
+    }
+
+    static string const& field(host::call_record const& record, string const& key)
+    {
+        static const string empty;
+        auto it = record.find(key);
+        return it == record.end() ? empty : it->second;
+    }
+
+    static void record_addresses(ifaddrs const* addrs)
+    {
+        // The interface data (ifa_data) is specific to the platform and is not recorded
+        vector<host::call_record> records;
+        for (auto ptr = addrs; ptr; ptr = ptr->ifa_next) {
+            records.push_back({
+                { "name", ptr->ifa_name ? ptr->ifa_name : "" },
+                { "flags", to_string(ptr->ifa_flags) },
+                { "address", encode_address(ptr->ifa_addr) },
+                { "netmask", encode_address(ptr->ifa_netmask) }
+            });
+        }
+        host::record_call("getifaddrs", move(records));
+    }
+
+    static ifaddrs* replay_addresses(vector<host::call_record> const& records)
+    {
+        ifaddrs* head = nullptr;
+        ifaddrs** next = &head;
+        for (auto const& record : records) {
+            auto address = new replayed_address();
+            strncpy(address->name, field(record, "name").c_str(), sizeof(address->name) - 1);
+            address->entry.ifa_name = address->name;
+            address->entry.ifa_flags = static_cast<unsigned int>(strtoul(field(record, "flags").c_str(), nullptr, 10));
+            address->entry.ifa_addr = decode_address(field(record, "address"), address->address);
+            address->entry.ifa_netmask = decode_address(field(record, "netmask"), address->netmask);
+            *next = &address->entry;
+            next = &address->entry.ifa_next;
+        }
+        return head;
+    }
+
     scoped_ifaddrs::scoped_ifaddrs() :
         scoped_resource(nullptr, free)
     {
+        vector<host::call_record> records;
+        if (host::replay_call("getifaddrs", records)) {
+            _resource = replay_addresses(records);
+            _deleter = free_replayed;
+            if (!_resource) {
+                // A replayed host that never listed its interfaces behaves as if the call failed
+                errno = ENOENT;
+            }
+            return;
+        }
+
         // Get the linked list of interfaces
         if (getifaddrs(&_resource) == -1) {
             _resource = nullptr;
+            return;
+        }
+        if (host::snapshot_active()) {
+            record_addresses(_resource);
         }
     }
 
@@ -26,4 +140,13 @@ namespace facter { namespace util { namespace bsd {
         }
     }
 
+    void scoped_ifaddrs::free_replayed(ifaddrs* addrs)
+    {
+        while (addrs) {
+            auto next = addrs->ifa_next;
+            delete reinterpret_cast<replayed_address*>(addrs);
+            addrs = next;
+        }
+    }
+
 }}}  // namespace facter::util::bsd
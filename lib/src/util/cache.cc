@@ -0,0 +1,30 @@
+#include <internal/util/cache.hpp>
+#include <leatherman/util/environment.hpp>
+#include <boost/filesystem.hpp>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace leatherman::util;
+using namespace boost::filesystem;
+
+namespace facter { namespace util {
+
+    string cache_directory(string const& name)
+    {
+#ifndef _WIN32
+        // Root keeps its cache with the system's Facter data
+        if (!getuid()) {
+            return (path("/opt/puppetlabs/facter/cache") / name).string();
+        }
+#endif
+        // Caching is disabled without a home directory
+        string home;
+        if (!environment::get("HOME", home) || home.empty()) {
+            return {};
+        }
+        return (path(home) / ".puppetlabs" / "opt" / "facter" / "cache" / name).string();
+    }
+
+}}  // namespace facter::util
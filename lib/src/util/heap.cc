@@ -0,0 +1,33 @@
+#include <internal/util/heap.hpp>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+namespace facter { namespace util {
+
+    bool heap_allocated(uint64_t& bytes)
+    {
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+        // Count both the chunks allocated from the arenas and the blocks mapped for large allocations
+        auto info = mallinfo2();
+        bytes = static_cast<uint64_t>(info.uordblks) + static_cast<uint64_t>(info.hblkhd);
+        return true;
+#else
+        // The int fields of mallinfo wrap past 2 GiB, which is when the counts matter most, so don't report them
+        bytes = 0;
+        return false;
+#endif
+#elif defined(__APPLE__)
+        bytes = mstats().bytes_used;
+        return true;
+#else
+        bytes = 0;
+        return false;
+#endif
+    }
+
+}}  // namespace facter::util
@@ -0,0 +1,711 @@
+#include <internal/util/host.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/file_util/directory.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/regex.hpp>
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+namespace fs = boost::filesystem;
+namespace lth_file = leatherman::file_util;
+
+namespace facter { namespace util {
+
+    snapshot_exception::snapshot_exception(string const& message) :
+        runtime_error(message)
+    {
+    }
+
+    enum class snapshot_mode
+    {
+        live,
+        record,
+        replay
+    };
+
+    enum class path_type
+    {
+        missing,
+        file,
+        directory,
+        other
+    };
+
+    // What is known about a path on the recorded host
+    struct path_entry
+    {
+        path_entry() :
+            type(path_type::missing),
+            readable(false),
+            listed(false)
+        {
+        }
+
+        path_type type;
+        bool readable;
+        string contents;
+        bool listed;
+        vector<string> files;
+        vector<string> subdirectories;
+    };
+
+    struct snapshot_state
+    {
+        snapshot_state() :
+            mode(snapshot_mode::live)
+        {
+        }
+
+        atomic<snapshot_mode> mode;
+        mutex lock;
+        string path;
+        map<string, path_entry> paths;
+        map<vector<string>, host::command_output> commands;
+        map<string, string> programs;
+        map<string, vector<host::call_record>> calls;
+    };
+
+    static snapshot_state& state()
+    {
+        static snapshot_state instance;
+        return instance;
+    }
+
+    static char const* type_name(path_type type)
+    {
+        switch (type) {
+            case path_type::file:
+                return "file";
+            case path_type::directory:
+                return "directory";
+            case path_type::other:
+                return "other";
+            default:
+                return "missing";
+        }
+    }
+
+    static path_type parse_type(string const& name)
+    {
+        if (name == "file") {
+            return path_type::file;
+        }
+        if (name == "directory") {
+            return path_type::directory;
+        }
+        if (name == "other") {
+            return path_type::other;
+        }
+        return path_type::missing;
+    }
+
+    static path_type live_type(string const& path)
+    {
+        boost::system::error_code ec;
+        auto status = fs::status(path, ec);
+        if (ec || !fs::exists(status)) {
+            return path_type::missing;
+        }
+        if (fs::is_regular_file(status)) {
+            return path_type::file;
+        }
+        if (fs::is_directory(status)) {
+            return path_type::directory;
+        }
+        return path_type::other;
+    }
+
+    // Returns the entry for a path being recorded; the caller must hold the lock
+    static path_entry& record_entry(snapshot_state& snapshot, string const& path)
+    {
+        auto it = snapshot.paths.find(path);
+        if (it == snapshot.paths.end()) {
+            it = snapshot.paths.emplace(path, path_entry()).first;
+            it->second.type = live_type(path);
+        }
+        return it->second;
+    }
+
+    // Returns the entry for a path being replayed; unrecorded paths do not exist
+    static path_entry const& replay_entry(snapshot_state& snapshot, string const& path)
+    {
+        static const path_entry missing;
+        auto it = snapshot.paths.find(path);
+        return it == snapshot.paths.end() ? missing : it->second;
+    }
+
+    static path_type snapshot_type(string const& path)
+    {
+        auto& snapshot = state();
+        lock_guard<mutex> guard(snapshot.lock);
+        if (snapshot.mode == snapshot_mode::record) {
+            return record_entry(snapshot, path).type;
+        }
+        return replay_entry(snapshot, path).type;
+    }
+
+    static bool snapshot_read(string const& path, string& contents)
+    {
+        auto& snapshot = state();
+        if (snapshot.mode == snapshot_mode::record) {
+            bool readable = lth_file::read(path, contents);
+            lock_guard<mutex> guard(snapshot.lock);
+            auto& entry = record_entry(snapshot, path);
+            if (readable) {
+                entry.readable = true;
+                entry.contents = contents;
+            }
+            return readable;
+        }
+
+        lock_guard<mutex> guard(snapshot.lock);
+        auto const& entry = replay_entry(snapshot, path);
+        if (!entry.readable) {
+            return false;
+        }
+        contents = entry.contents;
+        return true;
+    }
+
+    static void snapshot_each_entry(string const& directory, function<bool(string const&)> const& callback, string const& pattern, bool files)
+    {
+        auto& snapshot = state();
+        vector<string> names;
+        {
+            lock_guard<mutex> guard(snapshot.lock);
+            if (snapshot.mode == snapshot_mode::record) {
+                // The whole directory is recorded so a replay can use a different pattern or stop at a different entry
+                auto& entry = record_entry(snapshot, directory);
+                if (!entry.listed && entry.type == path_type::directory) {
+                    boost::system::error_code ec;
+                    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+                        boost::system::error_code status_ec;
+                        auto status = it->status(status_ec);
+                        auto name = it->path().filename().string();
+                        if (fs::is_regular_file(status)) {
+                            entry.files.emplace_back(move(name));
+                        } else if (fs::is_directory(status)) {
+                            entry.subdirectories.emplace_back(move(name));
+                        }
+                    }
+                    entry.listed = true;
+                }
+                names = files ? entry.files : entry.subdirectories;
+            } else {
+                auto const& entry = replay_entry(snapshot, directory);
+                names = files ? entry.files : entry.subdirectories;
+            }
+        }
+
+        boost::regex regex;
+        if (!pattern.empty()) {
+            regex = boost::regex(pattern);
+        }
+        for (auto const& name : names) {
+            if (!pattern.empty() && !boost::regex_search(name, regex)) {
+                continue;
+            }
+            if (!callback((fs::path(directory) / name).string())) {
+                break;
+            }
+        }
+    }
+
+    void record_snapshot(string const& path)
+    {
+        finish_snapshot();
+
+        auto& snapshot = state();
+        lock_guard<mutex> guard(snapshot.lock);
+        snapshot.path = path;
+        snapshot.mode = snapshot_mode::record;
+        LOG_DEBUG("recording a host snapshot to %1%.", path);
+    }
+
+    void replay_snapshot(string const& path)
+    {
+        finish_snapshot();
+
+        map<string, path_entry> paths;
+        map<vector<string>, host::command_output> commands;
+        map<string, string> programs;
+        map<string, vector<host::call_record>> calls;
+        try {
+            auto root = YAML::LoadFile(path);
+            for (auto const& node : root["paths"]) {
+                path_entry entry;
+                auto const& value = node.second;
+                entry.type = parse_type(value["type"].as<string>());
+                if (value["contents"]) {
+                    entry.readable = true;
+                    entry.contents = value["contents"].as<string>();
+                }
+                if (value["files"] || value["subdirectories"]) {
+                    entry.listed = true;
+                    for (auto const& name : value["files"]) {
+                        entry.files.push_back(name.as<string>());
+                    }
+                    for (auto const& name : value["subdirectories"]) {
+                        entry.subdirectories.push_back(name.as<string>());
+                    }
+                }
+                paths.emplace(node.first.as<string>(), move(entry));
+            }
+            for (auto const& value : root["commands"]) {
+                host::command_output output;
+                output.found = value["found"].as<bool>();
+                output.timed_out = value["timed_out"] && value["timed_out"].as<bool>();
+                output.signaled = value["signaled"] && value["signaled"].as<bool>();
+                output.exit_code = value["exit_code"].as<int>();
+                if (value["output"]) {
+                    output.output = value["output"].as<string>();
+                }
+                if (value["error"]) {
+                    output.error = value["error"].as<string>();
+                }
+                commands.emplace(value["command"].as<vector<string>>(), move(output));
+            }
+            for (auto const& node : root["programs"]) {
+                programs.emplace(node.first.as<string>(), node.second.as<string>());
+            }
+            for (auto const& node : root["calls"]) {
+                auto& records = calls[node.first.as<string>()];
+                for (auto const& value : node.second) {
+                    records.emplace_back(value.as<host::call_record>());
+                }
+            }
+        } catch (YAML::Exception& ex) {
+            throw snapshot_exception("host snapshot " + path + " could not be loaded: " + ex.what());
+        }
+
+        auto& snapshot = state();
+        lock_guard<mutex> guard(snapshot.lock);
+        snapshot.path = path;
+        snapshot.paths = move(paths);
+        snapshot.commands = move(commands);
+        snapshot.programs = move(programs);
+        snapshot.calls = move(calls);
+        snapshot.mode = snapshot_mode::replay;
+        LOG_DEBUG("replaying the host snapshot in %1%.", path);
+    }
+
+    void finish_snapshot()
+    {
+        auto& snapshot = state();
+        lock_guard<mutex> guard(snapshot.lock);
+        auto mode = snapshot.mode.exchange(snapshot_mode::live);
+        auto paths = move(snapshot.paths);
+        auto commands = move(snapshot.commands);
+        auto programs = move(snapshot.programs);
+        auto calls = move(snapshot.calls);
+        snapshot.paths.clear();
+        snapshot.commands.clear();
+        snapshot.programs.clear();
+        snapshot.calls.clear();
+        if (mode != snapshot_mode::record) {
+            return;
+        }
+
+        YAML::Emitter emitter;
+        emitter << YAML::BeginMap;
+        emitter << YAML::Key << "paths" << YAML::Value << YAML::BeginMap;
+        for (auto const& kvp : paths) {
+            auto const& entry = kvp.second;
+            emitter << YAML::Key << kvp.first << YAML::Value << YAML::BeginMap;
+            emitter << YAML::Key << "type" << YAML::Value << type_name(entry.type);
+            if (entry.readable) {
+                emitter << YAML::Key << "contents" << YAML::Value << YAML::DoubleQuoted << entry.contents;
+            }
+            if (entry.listed) {
+                emitter << YAML::Key << "files" << YAML::Value << YAML::Flow << entry.files;
+                emitter << YAML::Key << "subdirectories" << YAML::Value << YAML::Flow << entry.subdirectories;
+            }
+            emitter << YAML::EndMap;
+        }
+        emitter << YAML::EndMap;
+        emitter << YAML::Key << "commands" << YAML::Value << YAML::BeginSeq;
+        for (auto const& kvp : commands) {
+            auto const& output = kvp.second;
+            emitter << YAML::BeginMap;
+            emitter << YAML::Key << "command" << YAML::Value << YAML::Flow << kvp.first;
+            emitter << YAML::Key << "found" << YAML::Value << output.found;
+            if (output.timed_out) {
+                emitter << YAML::Key << "timed_out" << YAML::Value << true;
+            }
+            if (output.signaled) {
+                emitter << YAML::Key << "signaled" << YAML::Value << true;
+            }
+            emitter << YAML::Key << "exit_code" << YAML::Value << output.exit_code;
+            emitter << YAML::Key << "output" << YAML::Value << YAML::DoubleQuoted << output.output;
+            emitter << YAML::Key << "error" << YAML::Value << YAML::DoubleQuoted << output.error;
+            emitter << YAML::EndMap;
+        }
+        emitter << YAML::EndSeq;
+        emitter << YAML::Key << "programs" << YAML::Value << YAML::BeginMap;
+        for (auto const& kvp : programs) {
+            emitter << YAML::Key << kvp.first << YAML::Value << kvp.second;
+        }
+        emitter << YAML::EndMap;
+        emitter << YAML::Key << "calls" << YAML::Value << YAML::BeginMap;
+        for (auto const& kvp : calls) {
+            emitter << YAML::Key << kvp.first << YAML::Value << YAML::BeginSeq;
+            for (auto const& record : kvp.second) {
+                emitter << YAML::Flow << YAML::BeginMap;
+                for (auto const& field : record) {
+                    emitter << YAML::Key << field.first << YAML::Value << YAML::DoubleQuoted << field.second;
+                }
+                emitter << YAML::EndMap;
+            }
+            emitter << YAML::EndSeq;
+        }
+        emitter << YAML::EndMap;
+        emitter << YAML::EndMap;
+
+        try {
+            lth_file::atomic_write_to_file(string(emitter.c_str()) + "\n", snapshot.path);
+        } catch (exception& ex) {
+            throw snapshot_exception("host snapshot " + snapshot.path + " could not be written: " + ex.what());
+        }
+        LOG_DEBUG("recorded %1% paths, %2% commands and %3% system calls to the host snapshot %4%.", paths.size(), commands.size(), calls.size(), snapshot.path);
+    }
+
+    namespace host {
+
+        // Each thread counts against its own scopes, so resolvers running concurrently are counted separately
+        static thread_local io_scope* current_scope = nullptr;
+
+        io_counters::io_counters() :
+            opens(0),
+            bytes_read(0),
+            stats(0),
+            scans(0),
+            entries(0)
+        {
+        }
+
+        io_scope::io_scope() :
+            _previous(current_scope)
+        {
+            current_scope = this;
+        }
+
+        io_scope::~io_scope()
+        {
+            current_scope = _previous;
+        }
+
+        io_counters io_scope::counters() const
+        {
+            return _counters;
+        }
+
+        void io_scope::add(uint64_t io_counters::*counter, uint64_t amount)
+        {
+            if (current_scope) {
+                current_scope->_counters.*counter += amount;
+            }
+        }
+
+#ifdef FACTER_FAULT_INJECTION
+        struct fault_state
+        {
+            fault_state() :
+                active(false),
+                releases(0)
+            {
+            }
+
+            atomic<bool> active;
+            mutex lock;
+            condition_variable released;
+            function<fault(access, string const&)> injector;
+            // Counts the releases so a hang can tell it was released
+            uint64_t releases;
+        };
+
+        static fault_state& faults()
+        {
+            static fault_state instance;
+            return instance;
+        }
+
+        void inject_faults(function<fault(access, string const&)> injector)
+        {
+            auto& injection = faults();
+            {
+                lock_guard<mutex> guard(injection.lock);
+                injection.injector = move(injector);
+                injection.active = static_cast<bool>(injection.injector);
+            }
+            release_hangs();
+        }
+
+        void release_hangs()
+        {
+            auto& injection = faults();
+            {
+                lock_guard<mutex> guard(injection.lock);
+                ++injection.releases;
+            }
+            injection.released.notify_all();
+        }
+
+        fault inject_fault(access kind, string const& target, chrono::milliseconds timeout)
+        {
+            auto& injection = faults();
+            if (!injection.active) {
+                return fault::none;
+            }
+
+            function<fault(access, string const&)> injector;
+            uint64_t releases;
+            {
+                lock_guard<mutex> guard(injection.lock);
+                injector = injection.injector;
+                releases = injection.releases;
+            }
+            // The injector is called without the lock so it can block to inject latency
+            auto result = injector ? injector(kind, target) : fault::none;
+            if (result != fault::hang) {
+                return result;
+            }
+
+            // A release between calling the injector and waiting here still ends the hang
+            unique_lock<mutex> guard(injection.lock);
+            auto released = [&]() { return injection.releases != releases; };
+            if (timeout.count() == 0) {
+                injection.released.wait(guard, released);
+                return fault::error;
+            }
+            return injection.released.wait_for(guard, timeout, released) ? fault::error : fault::hang;
+        }
+#endif  // FACTER_FAULT_INJECTION
+
+        // Wraps a directory callback to count the entries passed to it
+        static function<bool(string const&)> count_entries(function<bool(string const&)> callback, uint64_t& entries)
+        {
+            return [callback, &entries](string const& path) {
+                ++entries;
+                return callback(path);
+            };
+        }
+
+        bool snapshot_active()
+        {
+            return state().mode != snapshot_mode::live;
+        }
+
+        bool snapshot_replaying()
+        {
+            return state().mode == snapshot_mode::replay;
+        }
+
+        bool read(string const& path, string& contents)
+        {
+            io_scope::add(&io_counters::opens);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::file, path) != fault::none) {
+                return false;
+            }
+#endif
+            bool result = snapshot_active() ? snapshot_read(path, contents) : lth_file::read(path, contents);
+            if (result) {
+                io_scope::add(&io_counters::bytes_read, contents.size());
+            }
+            return result;
+        }
+
+        string read(string const& path)
+        {
+            string contents;
+            read(path, contents);
+            return contents;
+        }
+
+        bool each_line(string const& path, function<bool(string&)> callback)
+        {
+            io_scope::add(&io_counters::opens);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::file, path) != fault::none) {
+                return false;
+            }
+#endif
+            if (!snapshot_active()) {
+                // Count the bytes of each line and its newline as they are read
+                uint64_t bytes = 0;
+                bool result = lth_file::each_line(path, [&](string& line) {
+                    bytes += line.size() + 1;
+                    return callback(line);
+                });
+                io_scope::add(&io_counters::bytes_read, bytes);
+                return result;
+            }
+            string contents;
+            if (!snapshot_read(path, contents)) {
+                return false;
+            }
+            io_scope::add(&io_counters::bytes_read, contents.size());
+            istringstream stream(contents);
+            string line;
+            while (getline(stream, line)) {
+                if (!callback(line)) {
+                    break;
+                }
+            }
+            return true;
+        }
+
+        void each_file(string const& directory, function<bool(string const&)> callback, string const& pattern)
+        {
+            io_scope::add(&io_counters::scans);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::directory, directory) != fault::none) {
+                return;
+            }
+#endif
+            uint64_t entries = 0;
+            if (!snapshot_active()) {
+                lth_file::each_file(directory, count_entries(move(callback), entries), pattern);
+            } else {
+                snapshot_each_entry(directory, count_entries(move(callback), entries), pattern, true);
+            }
+            io_scope::add(&io_counters::entries, entries);
+        }
+
+        void each_subdirectory(string const& directory, function<bool(string const&)> callback, string const& pattern)
+        {
+            io_scope::add(&io_counters::scans);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::directory, directory) != fault::none) {
+                return;
+            }
+#endif
+            uint64_t entries = 0;
+            if (!snapshot_active()) {
+                lth_file::each_subdirectory(directory, count_entries(move(callback), entries), pattern);
+            } else {
+                snapshot_each_entry(directory, count_entries(move(callback), entries), pattern, false);
+            }
+            io_scope::add(&io_counters::entries, entries);
+        }
+
+        bool exists(string const& path)
+        {
+            io_scope::add(&io_counters::stats);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::stat, path) != fault::none) {
+                return false;
+            }
+#endif
+            if (!snapshot_active()) {
+                boost::system::error_code ec;
+                return fs::exists(path, ec) && !ec;
+            }
+            return snapshot_type(path) != path_type::missing;
+        }
+
+        bool is_directory(string const& path)
+        {
+            io_scope::add(&io_counters::stats);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::stat, path) != fault::none) {
+                return false;
+            }
+#endif
+            if (!snapshot_active()) {
+                boost::system::error_code ec;
+                return fs::is_directory(path, ec);
+            }
+            return snapshot_type(path) == path_type::directory;
+        }
+
+        bool is_regular_file(string const& path)
+        {
+            io_scope::add(&io_counters::stats);
+#ifdef FACTER_FAULT_INJECTION
+            if (inject_fault(access::stat, path) != fault::none) {
+                return false;
+            }
+#endif
+            if (!snapshot_active()) {
+                boost::system::error_code ec;
+                return fs::is_regular_file(path, ec);
+            }
+            return snapshot_type(path) == path_type::file;
+        }
+
+        bool replay_command(vector<string> const& command, command_output& output)
+        {
+            auto& snapshot = state();
+            if (snapshot.mode != snapshot_mode::replay) {
+                return false;
+            }
+            lock_guard<mutex> guard(snapshot.lock);
+            auto it = snapshot.commands.find(command);
+            output = it == snapshot.commands.end() ? command_output() : it->second;
+            return true;
+        }
+
+        void record_command(vector<string> const& command, command_output output)
+        {
+            auto& snapshot = state();
+            if (snapshot.mode != snapshot_mode::record) {
+                return;
+            }
+            lock_guard<mutex> guard(snapshot.lock);
+            snapshot.commands[command] = move(output);
+        }
+
+        bool replay_program(string const& program, string& path)
+        {
+            auto& snapshot = state();
+            if (snapshot.mode != snapshot_mode::replay) {
+                return false;
+            }
+            lock_guard<mutex> guard(snapshot.lock);
+            auto it = snapshot.programs.find(program);
+            path = it == snapshot.programs.end() ? string() : it->second;
+            return true;
+        }
+
+        void record_program(string const& program, string const& path)
+        {
+            auto& snapshot = state();
+            if (snapshot.mode != snapshot_mode::record) {
+                return;
+            }
+            lock_guard<mutex> guard(snapshot.lock);
+            snapshot.programs[program] = path;
+        }
+
+        bool replay_call(string const& call, vector<call_record>& records)
+        {
+            auto& snapshot = state();
+            if (snapshot.mode != snapshot_mode::replay) {
+                return false;
+            }
+            lock_guard<mutex> guard(snapshot.lock);
+            auto it = snapshot.calls.find(call);
+            records = it == snapshot.calls.end() ? vector<call_record>() : it->second;
+            return true;
+        }
+
+        void record_call(string const& call, vector<call_record> records)
+        {
+            auto& snapshot = state();
+            if (snapshot.mode != snapshot_mode::record) {
+                return;
+            }
+            lock_guard<mutex> guard(snapshot.lock);
+            snapshot.calls[call] = move(records);
+        }
+
+    }  // namespace host
+
+}}  // namespace facter::util
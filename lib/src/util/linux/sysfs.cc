@@ -0,0 +1,103 @@
+#include <internal/util/linux/sysfs.hpp>
+#include <internal/util/host.hpp>
+#include <internal/util/posix/scoped_descriptor.hpp>
+#include <cctype>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace facter::util::posix;
+
+namespace facter { namespace util { namespace linux {
+
+    bool read_attribute(string const& path, string& value)
+    {
+        // Attributes are read through the host snapshot while one is being recorded or replayed
+        if (host::snapshot_active()) {
+            if (!host::read(path, value)) {
+                return false;
+            }
+            while (!value.empty() && isspace(static_cast<unsigned char>(value.back()))) {
+                value.pop_back();
+            }
+            return true;
+        }
+
+        host::io_scope::add(&host::io_counters::opens);
+#ifdef FACTER_FAULT_INJECTION
+        if (host::inject_fault(host::access::file, path) != host::fault::none) {
+            return false;
+        }
+#endif
+        scoped_descriptor descriptor(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (static_cast<int>(descriptor) < 0) {
+            return false;
+        }
+
+        // sysfs attributes are at most a page, so a single read returns the whole value
+        char buffer[4096];
+        ssize_t count;
+        do {
+            count = read(descriptor, buffer, sizeof(buffer));
+        } while (count < 0 && errno == EINTR);
+        if (count < 0) {
+            return false;
+        }
+        host::io_scope::add(&host::io_counters::bytes_read, static_cast<uint64_t>(count));
+
+        while (count > 0 && isspace(static_cast<unsigned char>(buffer[count - 1]))) {
+            --count;
+        }
+        value.assign(buffer, static_cast<size_t>(count));
+        return true;
+    }
+
+    // Guards against overflow and allocating for a corrupt list
+    static const unsigned int max_cpu = 1 << 20;
+
+    static bool parse_cpu(string const& list, size_t& pos, unsigned int& cpu)
+    {
+        if (pos >= list.size() || !isdigit(static_cast<unsigned char>(list[pos]))) {
+            return false;
+        }
+        cpu = 0;
+        for (; pos < list.size() && isdigit(static_cast<unsigned char>(list[pos])); ++pos) {
+            cpu = cpu * 10 + static_cast<unsigned int>(list[pos] - '0');
+            if (cpu > max_cpu) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    vector<unsigned int> parse_cpu_list(string const& list)
+    {
+        vector<unsigned int> cpus;
+        size_t pos = 0;
+        while (pos < list.size()) {
+            unsigned int first, last;
+            if (!parse_cpu(list, pos, first)) {
+                return {};
+            }
+            last = first;
+            if (pos < list.size() && list[pos] == '-') {
+                ++pos;
+                if (!parse_cpu(list, pos, last) || last < first) {
+                    return {};
+                }
+            }
+            for (auto cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+            if (pos < list.size()) {
+                if (list[pos] != ',') {
+                    return {};
+                }
+                ++pos;
+            }
+        }
+        return cpus;
+    }
+
+}}}  // namespace facter::util::linux
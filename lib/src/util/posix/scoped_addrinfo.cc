@@ -1,4 +1,5 @@
 #include <internal/util/posix/scoped_addrinfo.hpp>
+#include <internal/util/host.hpp>
 
 using namespace std;
 using namespace leatherman::util;
@@ -14,6 +15,15 @@ namespace facter { namespace util { namespace posix {
         hints.ai_socktype = SOCK_STREAM;
         hints.ai_flags = AI_CANONNAME;
 
+#ifdef FACTER_FAULT_INJECTION
+        // An injected fault fails the lookup as a temporary failure in name resolution
+        if (host::inject_fault(host::access::dns, hostname) != host::fault::none) {
+            _resource = nullptr;
+            _result = EAI_AGAIN;
+            return;
+        }
+#endif
+
         _result = getaddrinfo(hostname.c_str(), nullptr, &hints, &_resource);
         if (_result != 0) {
             _resource = nullptr;
@@ -0,0 +1,52 @@
+#include <internal/util/posix/uname.hpp>
+#include <internal/util/host.hpp>
+#include <cerrno>
+#include <cstring>
+
+using namespace std;
+
+namespace facter { namespace util { namespace posix {
+
+    template <size_t N>
+    static void copy_field(char (&field)[N], host::call_record const& record, string const& key)
+    {
+        auto it = record.find(key);
+        if (it != record.end()) {
+            strncpy(field, it->second.c_str(), N - 1);
+        }
+    }
+
+    bool read_uname(utsname& name)
+    {
+        memset(&name, 0, sizeof(name));
+
+        vector<host::call_record> records;
+        if (host::replay_call("uname", records)) {
+            // A replayed host that never called uname behaves as if the call failed
+            if (records.empty()) {
+                errno = ENOENT;
+                return false;
+            }
+            auto const& record = records.front();
+            copy_field(name.sysname, record, "sysname");
+            copy_field(name.nodename, record, "nodename");
+            copy_field(name.release, record, "release");
+            copy_field(name.version, record, "version");
+            copy_field(name.machine, record, "machine");
+            return true;
+        }
+
+        if (uname(&name) == -1) {
+            return false;
+        }
+        host::record_call("uname", { {
+            { "sysname", name.sysname },
+            { "nodename", name.nodename },
+            { "release", name.release },
+            { "version", name.version },
+            { "machine", name.machine }
+        } });
+        return true;
+    }
+
+}}}  // namespace facter::util::posix
@@ -1,5 +1,4 @@
 #include <facter/util/string.hpp>
-#include <boost/regex.hpp>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -117,9 +116,16 @@ namespace facter { namespace util {
 
         // Taken from http://yaml.org/type/bool.html.
         // The string would be interpreted as a boolean, so quote it.
-        static boost::regex yaml_bool("y|Y|yes|Yes|YES|n|N|no|No|NO|true|True|TRUE|false|False|FALSE|on|On|ON|off|Off|OFF");
-        if (boost::regex_match(str, yaml_bool)) {
-            return true;
+        static char const* const yaml_bools[] = {
+            "y", "Y", "yes", "Yes", "YES", "n", "N", "no", "No", "NO",
+            "true", "True", "TRUE", "false", "False", "FALSE", "on", "On", "ON", "off", "Off", "OFF"
+        };
+        if (str.size() <= 5) {
+            for (auto yaml_bool : yaml_bools) {
+                if (str == yaml_bool) {
+                    return true;
+                }
+            }
         }
 
         // A string starting with the ':' special character interferes with parsing.
@@ -160,4 +166,29 @@ namespace facter { namespace util {
         return true;
     }
 
+    bool wildcard_match(string const& str, string const& pattern)
+    {
+        // Match greedily, backtracking to the most recent '*' on a mismatch
+        size_t s = 0, p = 0;
+        size_t star = string::npos, resume = 0;
+        while (s < str.size()) {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
+                ++s;
+                ++p;
+            } else if (p < pattern.size() && pattern[p] == '*') {
+                star = p++;
+                resume = s;
+            } else if (star != string::npos) {
+                p = star + 1;
+                s = ++resume;
+            } else {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*') {
+            ++p;
+        }
+        return p == pattern.size();
+    }
+
 }}  // namespace facter::util
@@ -0,0 +1,191 @@
+#include <internal/util/timeline.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace rapidjson;
+namespace lth_file = leatherman::file_util;
+
+namespace facter { namespace util {
+
+    // A completed span on a thread of the run
+    struct timeline_event
+    {
+        char const* category;
+        string name;
+        string detail;
+        double start;
+        double duration;
+        unsigned int thread;
+    };
+
+    struct timeline_state
+    {
+        timeline_state() :
+            enabled(false)
+        {
+        }
+
+        atomic<bool> enabled;
+        mutex lock;
+        string path;
+        chrono::steady_clock::time_point origin;
+        vector<timeline_event> events;
+        map<thread::id, unsigned int> threads;
+    };
+
+    static timeline_state& state()
+    {
+        static timeline_state instance;
+        return instance;
+    }
+
+    static double microseconds(chrono::steady_clock::duration duration)
+    {
+        return chrono::duration<double, micro>(duration).count();
+    }
+
+    static void write_string(Writer<StringBuffer>& writer, string const& value)
+    {
+        writer.String(value.c_str(), static_cast<SizeType>(value.size()));
+    }
+
+    void start_timeline(string const& path)
+    {
+        auto& timeline = state();
+        lock_guard<mutex> guard(timeline.lock);
+        timeline.path = path;
+        timeline.origin = chrono::steady_clock::now();
+        timeline.events.clear();
+        timeline.threads.clear();
+        // The thread starting the timeline is always the first
+        timeline.threads.emplace(this_thread::get_id(), 1);
+        timeline.enabled = true;
+    }
+
+    bool finish_timeline()
+    {
+        auto& timeline = state();
+        lock_guard<mutex> guard(timeline.lock);
+        if (!timeline.enabled.exchange(false)) {
+            return true;
+        }
+        auto events = move(timeline.events);
+        timeline.events.clear();
+
+        StringBuffer buffer;
+        Writer<StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("traceEvents");
+        writer.StartArray();
+        for (auto const& kvp : timeline.threads) {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String("thread_name");
+            writer.Key("ph");
+            writer.String("M");
+            writer.Key("pid");
+            writer.Uint(1);
+            writer.Key("tid");
+            writer.Uint(kvp.second);
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key("name");
+            write_string(writer, kvp.second == 1 ? "main" : "thread " + to_string(kvp.second));
+            writer.EndObject();
+            writer.EndObject();
+        }
+        for (auto const& event : events) {
+            writer.StartObject();
+            writer.Key("name");
+            write_string(writer, event.name);
+            writer.Key("cat");
+            writer.String(event.category);
+            writer.Key("ph");
+            writer.String("X");
+            writer.Key("ts");
+            writer.Double(event.start);
+            writer.Key("dur");
+            writer.Double(event.duration);
+            writer.Key("pid");
+            writer.Uint(1);
+            writer.Key("tid");
+            writer.Uint(event.thread);
+            if (!event.detail.empty()) {
+                writer.Key("args");
+                writer.StartObject();
+                writer.Key("detail");
+                write_string(writer, event.detail);
+                writer.EndObject();
+            }
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.Key("displayTimeUnit");
+        writer.String("ms");
+        writer.EndObject();
+
+        try {
+            lth_file::atomic_write_to_file(string(buffer.GetString(), buffer.GetSize()) + "\n", timeline.path);
+        } catch (exception& ex) {
+            LOG_ERROR("timeline %1% could not be written: %2%.", timeline.path, ex.what());
+            return false;
+        }
+        LOG_DEBUG("wrote %1% spans to the timeline %2%.", events.size(), timeline.path);
+        return true;
+    }
+
+    namespace timeline {
+
+        bool enabled()
+        {
+            return state().enabled;
+        }
+
+        span::span(char const* category, string const& name, string const& detail) :
+            _enabled(enabled()),
+            _category(category)
+        {
+            // Avoid copying the strings or reading the clock unless a timeline is being recorded
+            if (!_enabled) {
+                return;
+            }
+            _name = name;
+            _detail = detail;
+            _start = chrono::steady_clock::now();
+        }
+
+        span::~span()
+        {
+            if (!_enabled) {
+                return;
+            }
+            auto end = chrono::steady_clock::now();
+
+            auto& timeline = state();
+            lock_guard<mutex> guard(timeline.lock);
+            // Drop spans that outlive the timeline they were started in
+            if (!timeline.enabled || _start < timeline.origin) {
+                return;
+            }
+            auto result = timeline.threads.emplace(this_thread::get_id(), static_cast<unsigned int>(timeline.threads.size() + 1));
+            timeline.events.push_back(timeline_event{
+                _category,
+                move(_name),
+                move(_detail),
+                microseconds(_start - timeline.origin),
+                microseconds(end - _start),
+                result.first->second
+            });
+        }
+
+    }  // namespace timeline
+
+}}  // namespace facter::util
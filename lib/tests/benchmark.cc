@@ -0,0 +1,66 @@
+/*
+ * Measures how long the built-in facts take to resolve against recorded host snapshots.
+ * Snapshots are recorded with `facter --record-snapshot <file>`; a sample is in fixtures/snapshots/linux.yaml.
+ */
+#include <facter/facts/collection.hpp>
+#include <facter/logging/logging.hpp>
+#include <facter/util/snapshot.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::logging;
+
+int main(int argc, char** argv)
+{
+    setup_logging(cerr);
+    set_level(level::none);
+
+    unsigned int iterations = 10;
+    vector<string> snapshots;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned int>(max(1, atoi(argv[++i])));
+        } else {
+            snapshots.emplace_back(move(argument));
+        }
+    }
+    if (snapshots.empty()) {
+        cerr << "usage: " << argv[0] << " [--iterations <count>] <snapshot>..." << endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        for (auto const& snapshot : snapshots) {
+            facter::util::replay_snapshot(snapshot);
+
+            size_t count = 0;
+            vector<double> times;
+            for (unsigned int i = 0; i < iterations; ++i) {
+                auto start = chrono::steady_clock::now();
+                collection facts;
+                facts.add_default_facts(false);
+                facts.resolve_facts();
+                times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+                count = facts.size();
+            }
+            facter::util::finish_snapshot();
+
+            sort(times.begin(), times.end());
+            cout << snapshot << ": " << count << " facts in "
+                 << times.front() << " ms min, "
+                 << times[times.size() / 2] << " ms median, "
+                 << times.back() << " ms max over " << iterations << " iterations" << endl;
+        }
+    } catch (exception& ex) {
+        cerr << "error: " << ex.what() << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
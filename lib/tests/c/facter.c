@@ -0,0 +1,116 @@
+/*
+ * Exercises the libfacter C API from a C program.
+ */
+#include <facter/c/facter.h>
+#include <facter/version.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures; \
+        } \
+    } while (0)
+
+static int count_facts(char const* name, facter_value const* value, void* context)
+{
+    CHECK(name != NULL);
+    ++*(size_t*)context;
+    return 1;
+}
+
+static int stop_after_first(char const* name, facter_value const* value, void* context)
+{
+    ++*(size_t*)context;
+    return 0;
+}
+
+int main(void)
+{
+    facter_collection* facts = facter_collection_create();
+    CHECK(facts != NULL);
+    if (!facts) {
+        return EXIT_FAILURE;
+    }
+
+    CHECK(facter_collection_add_default_facts(facts) == FACTER_OK);
+    CHECK(facter_collection_add_external_facts(facts, NULL, 0) == FACTER_OK);
+    CHECK(facter_collection_add_external_facts(NULL, NULL, 0) == FACTER_ERROR_INVALID_ARGUMENT);
+
+    CHECK(facter_collection_enable_concurrency(facts) == FACTER_OK);
+    CHECK(facter_collection_enable_concurrency(NULL) == FACTER_ERROR_INVALID_ARGUMENT);
+
+    /* Querying resolves only what is needed */
+    {
+        size_t length = 0;
+        facter_value const* version = facter_collection_query(facts, "facterversion");
+        CHECK(version != NULL);
+        CHECK(facter_value_get_type(version) == FACTER_VALUE_STRING);
+        CHECK(strcmp(facter_value_get_string(version, &length), LIBFACTER_VERSION) == 0);
+        CHECK(length == strlen(LIBFACTER_VERSION));
+        CHECK(facter_value_get_integer(version) == 0);
+        CHECK(facter_collection_query(facts, "not_a_real_fact") == NULL);
+    }
+
+    /* Structured values can be walked without copying */
+    {
+        facter_value const* os = facter_collection_query(facts, "os");
+        CHECK(os != NULL);
+        CHECK(facter_value_get_type(os) == FACTER_VALUE_MAP);
+        CHECK(facter_value_get_size(os) > 0);
+        CHECK(facter_value_get_element(os, "family") == facter_collection_query(facts, "os.family"));
+
+        size_t count = 0;
+        CHECK(facter_value_each(os, count_facts, &count) == FACTER_OK);
+        CHECK(count == facter_value_get_size(os));
+        CHECK(facter_value_each(facter_collection_query(facts, "facterversion"), count_facts, &count) == FACTER_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* Enumerate everything */
+    {
+        size_t count = 0;
+        CHECK(facter_collection_resolve(facts) == FACTER_OK);
+        CHECK(facter_collection_each(facts, count_facts, &count) == FACTER_OK);
+        CHECK(count > 0);
+
+        count = 0;
+        CHECK(facter_collection_each(facts, stop_after_first, &count) == FACTER_OK);
+        CHECK(count == 1);
+    }
+
+    /* Serialize into a caller-provided buffer */
+    {
+        char const* queries[] = { "facterversion" };
+        char small[4];
+        size_t size = sizeof(small);
+        CHECK(facter_collection_write(facts, FACTER_FORMAT_JSON, queries, 1, small, &size) == FACTER_ERROR_BUFFER_TOO_SMALL);
+        CHECK(size > sizeof(small));
+
+        char* buffer = malloc(size);
+        CHECK(buffer != NULL);
+        if (buffer) {
+            CHECK(facter_collection_write(facts, FACTER_FORMAT_JSON, queries, 1, buffer, &size) == FACTER_OK);
+            CHECK(size == strlen(buffer) + 1);
+            CHECK(buffer[0] == '{');
+            CHECK(strstr(buffer, LIBFACTER_VERSION) != NULL);
+            free(buffer);
+        }
+
+        size = 0;
+        CHECK(facter_collection_write(facts, FACTER_FORMAT_YAML, NULL, 0, NULL, &size) == FACTER_ERROR_BUFFER_TOO_SMALL);
+        CHECK(size > 1);
+    }
+
+    facter_collection_free(facts);
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed.\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
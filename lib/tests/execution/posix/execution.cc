@@ -0,0 +1,204 @@
+#include <catch.hpp>
+#include <internal/execution/execution.hpp>
+#include <facter/util/snapshot.hpp>
+#include "../../fault_injection.hpp"
+#include <leatherman/util/scope_exit.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace facter::execution;
+
+SCENARIO("executing commands with posix_spawn") {
+    GIVEN("a command that writes to stdout") {
+        THEN("the output is returned") {
+            auto exec = execute("sh", { "-c", "echo hello; echo world" });
+            REQUIRE(exec.success);
+            REQUIRE(exec.exit_code == 0);
+            REQUIRE(exec.output == "hello\nworld");
+            REQUIRE(exec.pid != 0u);
+        }
+        THEN("each line is passed to the callback") {
+            vector<string> lines;
+            REQUIRE(each_line("sh", { "-c", "echo one; echo two; echo three" }, [&](string& line) {
+                lines.push_back(line);
+                return true;
+            }));
+            REQUIRE(lines == vector<string>({ "one", "two", "three" }));
+        }
+        THEN("the callback can stop reading") {
+            vector<string> lines;
+            each_line("sh", { "-c", "echo one; echo two; echo three" }, [&](string& line) {
+                lines.push_back(line);
+                return false;
+            });
+            REQUIRE(lines == vector<string>({ "one" }));
+        }
+    }
+    GIVEN("a command that writes to stderr") {
+        THEN("stderr is discarded by default") {
+            auto exec = execute("sh", { "-c", "echo error >&2; echo output" });
+            REQUIRE(exec.output == "output");
+            REQUIRE(exec.error.empty());
+        }
+        THEN("stderr can be redirected to stdout") {
+            auto exec = execute("sh", { "-c", "echo error >&2" }, 0, { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_stdout });
+            REQUIRE(exec.output == "error");
+        }
+        THEN("stderr lines are passed to the stderr callback") {
+            vector<string> errors;
+            each_line("sh", { "-c", "echo error >&2" }, [](string&) { return true; }, [&](string& line) {
+                errors.push_back(line);
+                return true;
+            });
+            REQUIRE(errors == vector<string>({ "error" }));
+        }
+    }
+    GIVEN("a command that fails") {
+        THEN("the exit code is returned") {
+            auto exec = execute("sh", { "-c", "exit 3" });
+            REQUIRE_FALSE(exec.success);
+            REQUIRE(exec.exit_code == 3);
+        }
+        THEN("an exception is thrown when requested") {
+            REQUIRE_THROWS_AS(execute("sh", { "-c", "exit 3" }, 0, { execution_options::merge_environment, execution_options::throw_on_nonzero_exit }), child_exit_exception);
+        }
+    }
+    GIVEN("a command that does not exist") {
+        THEN("execution fails") {
+            auto exec = execute("not_a_real_command_for_facter");
+            REQUIRE_FALSE(exec.success);
+            REQUIRE(exec.exit_code == 127);
+        }
+    }
+    GIVEN("a command that exceeds the timeout") {
+        THEN("a timeout exception is thrown") {
+            REQUIRE_THROWS_AS(execute("sh", { "-c", "sleep 10" }, 1), timeout_exception);
+        }
+    }
+    GIVEN("the environment") {
+        THEN("the C locale is used") {
+            auto exec = execute("sh", { "-c", "echo $LC_ALL $LANG" });
+            REQUIRE(exec.output == "C C");
+        }
+    }
+    GIVEN("a command that closes its output but keeps running") {
+        THEN("a timeout exception is thrown") {
+            REQUIRE_THROWS_AS(execute("sh", { "-c", "exec >/dev/null 2>&1; sleep 10" }, 1), timeout_exception);
+        }
+    }
+    GIVEN("a callback that stops reading") {
+        THEN("the child is killed rather than waited on") {
+            auto start = chrono::steady_clock::now();
+            vector<string> lines;
+            each_line("sh", { "-c", "echo first; exec >/dev/null; sleep 30" }, [&](string& line) {
+                lines.push_back(line);
+                return false;
+            });
+            REQUIRE(lines == vector<string> { "first" });
+            REQUIRE(chrono::steady_clock::now() - start < chrono::seconds(10));
+        }
+    }
+    GIVEN("a request to inherit the locale") {
+        char const* previous = getenv("LC_ALL");
+        string saved = previous ? previous : "";
+        setenv("LC_ALL", "facter_test_locale", 1);
+        leatherman::util::scope_exit restore([&]() {
+            if (previous) {
+                setenv("LC_ALL", saved.c_str(), 1);
+            } else {
+                unsetenv("LC_ALL");
+            }
+        });
+        THEN("the locale of the parent is used") {
+            auto exec = execute("sh", { "-c", "echo $LC_ALL" }, 0, { execution_options::trim_output, execution_options::inherit_locale });
+            REQUIRE(exec.output == "facter_test_locale");
+        }
+        THEN("the C locale is used otherwise") {
+            auto exec = execute("sh", { "-c", "echo $LC_ALL" });
+            REQUIRE(exec.output == "C");
+        }
+    }
+}
+
+SCENARIO("replaying commands from a host snapshot") {
+    auto snapshot = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("facter-snapshot-%%%%-%%%%-%%%%.yaml")).string();
+    leatherman::util::scope_exit cleanup([&]() {
+        facter::util::finish_snapshot();
+        boost::filesystem::remove(snapshot);
+    });
+
+    facter::util::record_snapshot(snapshot);
+    auto recorded_path = which("sh");
+    REQUIRE(execute("sh", { "-c", "echo hello; echo world; echo error >&2" }).output == "hello\nworld");
+    REQUIRE(execute("sh", { "-c", "exit 3" }).exit_code == 3);
+    REQUIRE(execute("not_a_real_command").exit_code == 127);
+    facter::util::finish_snapshot();
+
+    facter::util::replay_snapshot(snapshot);
+    GIVEN("a recorded command") {
+        THEN("the recorded output is returned without running it") {
+            auto exec = execute("sh", { "-c", "echo hello; echo world; echo error >&2" });
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "hello\nworld");
+            REQUIRE(exec.error.empty());
+        }
+        THEN("each recorded line is passed to the callback") {
+            vector<string> lines;
+            vector<string> errors;
+            REQUIRE(each_line("sh", { "-c", "echo hello; echo world; echo error >&2" }, [&](string& line) {
+                lines.push_back(line);
+                return true;
+            }, [&](string& line) {
+                errors.push_back(line);
+                return true;
+            }));
+            REQUIRE(lines == vector<string>({ "hello", "world" }));
+            REQUIRE(errors.empty());
+        }
+        THEN("the recorded exit code is returned") {
+            auto exec = execute("sh", { "-c", "exit 3" });
+            REQUIRE_FALSE(exec.success);
+            REQUIRE(exec.exit_code == 3);
+            REQUIRE_THROWS_AS(execute("sh", { "-c", "exit 3" }, 0, { execution_options::throw_on_nonzero_exit }), child_exit_exception);
+        }
+        THEN("the recorded program location is returned") {
+            REQUIRE(which("sh") == recorded_path);
+        }
+    }
+    GIVEN("a command that was not recorded") {
+        THEN("it is not found") {
+            REQUIRE(execute("sh", { "-c", "echo other" }).exit_code == 127);
+            REQUIRE(execute("not_a_real_command").exit_code == 127);
+            REQUIRE(which("true").empty());
+        }
+    }
+}
+
+SCENARIO("injecting faults into commands") {
+    facter::testing::fault_injection faults;
+    using facter::util::host::access;
+
+    GIVEN("a command that hangs") {
+        faults.hang(access::command, "^sh -c echo hung$");
+        THEN("a command with a timeout times out without waiting for a release") {
+            REQUIRE_THROWS_AS(execute("sh", { "-c", "echo hung" }, 1), timeout_exception);
+        }
+        THEN("other commands still run") {
+            auto exec = execute("sh", { "-c", "echo ok" });
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "ok");
+        }
+    }
+    GIVEN("a command that fails") {
+        faults.fail(access::command, "^sh ");
+        THEN("the command is not found") {
+            auto exec = execute("sh", { "-c", "echo hidden" });
+            REQUIRE_FALSE(exec.success);
+            REQUIRE(exec.exit_code == 127);
+            REQUIRE(faults.hits("^sh ") == 1u);
+        }
+    }
+}
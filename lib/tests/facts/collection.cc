@@ -7,6 +7,9 @@
 #include <leatherman/util/environment.hpp>
 #include "../fixtures.hpp"
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 using namespace std;
 using namespace facter::facts;
@@ -38,6 +41,119 @@ struct multi_resolver : facter::facts::resolver
     }
 };
 
+struct counting_resolver : facter::facts::resolver
+{
+    counting_resolver() : resolver("counting", { "counted_1", "counted_2" }, { "^counted_pattern_.*$" })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        ++count;
+        // Widen the window for concurrent lookups to race with resolution
+        this_thread::sleep_for(chrono::milliseconds(10));
+        facts.add("counted_1", make_value<string_value>("one"));
+        facts.add("counted_2", make_value<integer_value>(2));
+        facts.add("counted_pattern_3", make_value<string_value>("three"));
+    }
+
+    atomic<int> count { 0 };
+};
+
+struct dependent_resolver : facter::facts::resolver
+{
+    dependent_resolver() : resolver("dependent", { "dependent" })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        ++count;
+        auto fact = facts.get<string_value>("counted_1");
+        facts.add("dependent", make_value<string_value>(fact ? fact->value() + "!" : ""));
+    }
+
+    atomic<int> count { 0 };
+};
+
+struct indexed_resolver : facter::facts::resolver
+{
+    explicit indexed_resolver(int index) : resolver("indexed", { "indexed_" + to_string(index) }), _index(index)
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        facts.add("indexed_" + to_string(_index), make_value<integer_value>(_index));
+    }
+
+ private:
+    int _index;
+};
+
+struct allocating_resolver : facter::facts::resolver
+{
+    allocating_resolver() : resolver("allocating", { "allocated" })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        facts.add("allocated", make_value<string_value>(string(1024 * 1024, 'x')));
+    }
+};
+
+struct lookup_resolver : facter::facts::resolver
+{
+    lookup_resolver() : resolver("lookup", { "looked_up" })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        auto fact = facts.get<string_value>("allocated");
+        facts.add("looked_up", make_value<integer_value>(fact ? fact->value().size() : 0));
+    }
+};
+
+// A value that does not measure itself
+struct unmeasured_value : value
+{
+    virtual void to_json(json_allocator& allocator, json_value& value) const override
+    {
+    }
+
+    virtual ostream& write(ostream& os, bool quoted = true, unsigned int level = 1) const override
+    {
+        return os;
+    }
+
+    virtual YAML::Emitter& write(YAML::Emitter& emitter) const override
+    {
+        return emitter;
+    }
+
+    using value::write;
+};
+
+// A string value that counts how many instances have been destroyed
+struct counted_value : string_value
+{
+    explicit counted_value(string value) :
+        string_value(move(value))
+    {
+    }
+
+    ~counted_value()
+    {
+        ++destroyed;
+    }
+
+    static atomic<int> destroyed;
+};
+
+atomic<int> counted_value::destroyed { 0 };
+
 struct temp_variable
 {
     temp_variable(string name, string const& value) :
@@ -66,6 +182,21 @@ SCENARIO("using the fact collection") {
             REQUIRE_FALSE(facts.empty());
         }
     }
+    GIVEN("resolver options") {
+        facts.set_option("interfaces-exclude", { "veth*", "cali*" });
+        THEN("they should be returned") {
+            REQUIRE(facts.get_option("interfaces-exclude") == (vector<string>{ "veth*", "cali*" }));
+        }
+        THEN("options that are not set should be empty") {
+            REQUIRE(facts.get_option("interfaces-include").empty());
+        }
+        WHEN("an option is set again") {
+            facts.set_option("interfaces-exclude", { "tap*" });
+            THEN("it should be replaced") {
+                REQUIRE(facts.get_option("interfaces-exclude") == (vector<string>{ "tap*" }));
+            }
+        }
+    }
     GIVEN("a hidden fact and a revealed fact") {
         facts.add("foo", make_value<string_value>("bar"));
         facts.add("hidden_foo", make_value<string_value>("hidden_bar", true));
@@ -479,3 +610,191 @@ SCENARIO("using the fact collection with a default external fact path") {
         }
     }
 }
+
+SCENARIO("using the fact collection concurrently") {
+    collection_fixture facts;
+    auto counting = make_shared<counting_resolver>();
+    auto dependent = make_shared<dependent_resolver>();
+    facts.add(counting);
+    facts.add(dependent);
+    facts.add("static", make_value<string_value>("value"));
+    facts.enable_concurrency();
+    REQUIRE(facts.concurrent());
+
+    GIVEN("many threads looking up the same facts") {
+        atomic<int> failures { 0 };
+        vector<thread> threads;
+        for (int i = 0; i < 16; ++i) {
+            threads.emplace_back([&, i]() {
+                for (int j = 0; j < 200; ++j) {
+                    // Start threads at different facts so resolution is triggered from all of them
+                    switch ((i + j) % 5) {
+                        case 0: {
+                            auto value = facts.get<string_value>("counted_1");
+                            failures += !value || value->value() != "one";
+                            break;
+                        }
+                        case 1: {
+                            auto value = facts.get<integer_value>("counted_2");
+                            failures += !value || value->value() != 2;
+                            break;
+                        }
+                        case 2: {
+                            auto value = facts.query<string_value>("counted_pattern_3");
+                            failures += !value || value->value() != "three";
+                            break;
+                        }
+                        case 3: {
+                            auto value = facts.get<string_value>("dependent");
+                            failures += !value || value->value() != "one!";
+                            break;
+                        }
+                        default: {
+                            ostringstream ss;
+                            facts.write(ss, format::json);
+                            failures += ss.str().find("\"dependent\": \"one!\"") == string::npos;
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        THEN("each resolver should run exactly once") {
+            REQUIRE(counting->count == 1);
+            REQUIRE(dependent->count == 1);
+        }
+        THEN("every lookup should see the resolved values") {
+            REQUIRE(failures == 0);
+            REQUIRE(facts.size() == 5u);
+        }
+    }
+    GIVEN("a fact replaced while other threads are reading it") {
+        facts.resolve_facts();
+        counted_value::destroyed = 0;
+        atomic<bool> done { false };
+        atomic<int> failures { 0 };
+        thread reader([&]() {
+            while (!done) {
+                // Iterating holds the snapshot, so replaced values stay alive until the iteration finishes
+                facts.each([&](string const& name, value const* val) {
+                    if (name == "static") {
+                        auto str = dynamic_cast<string_value const*>(val);
+                        failures += !str || (str->value() != "value" && str->value() != "updated");
+                    }
+                    return true;
+                });
+            }
+        });
+        for (int i = 0; i < 100; ++i) {
+            facts.add("static", unique_ptr<value>(new counted_value(i % 2 ? "value" : "updated")));
+        }
+        done = true;
+        reader.join();
+        THEN("readers should only see complete values") {
+            REQUIRE(failures == 0);
+        }
+        THEN("replaced values should be reclaimed once no reader can see them") {
+            facts.get<string_value>("static");
+            REQUIRE(counted_value::destroyed == 99);
+        }
+    }
+    GIVEN("lookups of facts that do not exist") {
+        facts.resolve_facts();
+        auto before = facts.size();
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE_FALSE(facts.get<string_value>("missing_" + to_string(i)));
+            REQUIRE_FALSE(facts.query<string_value>("static.missing_" + to_string(i)));
+        }
+        THEN("the lookups should not change the collection") {
+            REQUIRE(facts.size() == before);
+        }
+    }
+    GIVEN("many facts resolved one lookup at a time") {
+        for (int i = 0; i < 100; ++i) {
+            facts.add(make_shared<indexed_resolver>(i));
+        }
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(facts.get<integer_value>("indexed_" + to_string(i)));
+        }
+        facts.add("indexed_10", make_value<integer_value>(-10));
+        facts.remove("indexed_20");
+        atomic<int> failures { 0 };
+        size_t seen = 0;
+        thread reader([&]() {
+            for (int i = 0; i < 100; ++i) {
+                auto value = facts.get_resolved<integer_value>("indexed_" + to_string(i));
+                if (i == 20) {
+                    failures += value != nullptr;
+                } else {
+                    failures += !value || value->value() != (i == 10 ? -10 : i);
+                }
+            }
+            facts.each([&](string const& name, value const*) {
+                seen += name.compare(0, 8, "indexed_") == 0;
+                return true;
+            });
+        });
+        reader.join();
+        THEN("other threads should see every settled fact in the published snapshot") {
+            REQUIRE(failures == 0);
+            REQUIRE(seen == 99u);
+        }
+    }
+    GIVEN("a resolver added after a fact was resolved") {
+        REQUIRE(facts.get<string_value>("counted_1")->value() == "one");
+        facts.add(make_shared<simple_resolver>());
+        THEN("the new resolver should run on the next lookup") {
+            REQUIRE(facts.get<string_value>("foo"));
+            REQUIRE(facts.get<string_value>("foo")->value() == "bar");
+        }
+    }
+}
+
+SCENARIO("measuring the memory used by the fact collection") {
+    collection_fixture facts;
+    facts.add(make_shared<allocating_resolver>());
+    facts.add(make_shared<lookup_resolver>());
+    facts.enable_memory_accounting();
+
+    GIVEN("facts that have not been resolved") {
+        THEN("nothing is measured or accounted") {
+            REQUIRE(facts.measure().empty());
+            REQUIRE(facts.resolver_allocations().empty());
+        }
+    }
+    GIVEN("a resolver that looks up a fact from another resolver") {
+        REQUIRE(facts.get<integer_value>("looked_up"));
+        REQUIRE(facts.get<integer_value>("looked_up")->value() == 1024 * 1024);
+        THEN("each fact is measured") {
+            auto usage = facts.measure();
+            REQUIRE(usage.size() == 2u);
+            REQUIRE(usage["allocated"].nodes == 1u);
+            REQUIRE(usage["allocated"].string_bytes >= 1024u * 1024u);
+            REQUIRE(usage["allocated"].container_bytes > 0u);
+            REQUIRE(usage["looked_up"].nodes == 1u);
+            REQUIRE(usage["looked_up"].string_bytes < 1024u);
+        }
+        THEN("the memory allocated by the other resolver is not counted against the resolver") {
+            auto allocations = facts.resolver_allocations();
+            // Accounting is not available with every allocator
+            if (!allocations.empty()) {
+                REQUIRE(allocations.size() == 2u);
+                REQUIRE(allocations["allocating"] >= 1024 * 1024);
+                REQUIRE(allocations["lookup"] < 1024 * 1024);
+            }
+        }
+    }
+    GIVEN("a fact whose value does not measure itself") {
+        facts.add("unmeasured", make_value<unmeasured_value>());
+        THEN("the value is counted as a node without a size") {
+            memory_usage usage;
+            facts.get<unmeasured_value>("unmeasured")->measure(usage);
+            REQUIRE(usage.nodes == 1u);
+            REQUIRE(usage.total() == 0u);
+            REQUIRE(facts.measure()["unmeasured"].nodes == 1u);
+        }
+    }
+}
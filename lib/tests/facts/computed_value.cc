@@ -0,0 +1,163 @@
+#include <catch.hpp>
+#include <facter/facts/computed_value.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/yaml_writer.hpp>
+#include <rapidjson/document.h>
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace facter::facts;
+using namespace rapidjson;
+using namespace YAML;
+
+static atomic<int> format_count(0);
+
+static string counting_format(uint64_t value, uint64_t total)
+{
+    ++format_count;
+    return to_string(value) + "/" + to_string(total);
+}
+
+SCENARIO("using a computed fact value") {
+    GIVEN("a size") {
+        computed_value value(computed_value::size, 4294967296ull);
+        REQUIRE(value.source() == 4294967296ull);
+        REQUIRE(value.value() == "4.00 GiB");
+    }
+    GIVEN("a percentage") {
+        computed_value value(computed_value::percentage, 1, 3);
+        REQUIRE(value.value() == "33.33%");
+    }
+    GIVEN("a frequency") {
+        computed_value value(computed_value::frequency, 1240000000);
+        REQUIRE(value.value() == "1.24 GHz");
+    }
+    GIVEN("the size of a value") {
+        THEN("it should be no larger than a string value") {
+            REQUIRE(sizeof(computed_value) <= sizeof(string_value));
+        }
+    }
+    GIVEN("a value that is never looked up") {
+        format_count = 0;
+        {
+            computed_value value(counting_format, 1, 2);
+        }
+        THEN("it should not be formatted") {
+            REQUIRE(format_count == 0);
+        }
+    }
+    GIVEN("a value that is measured") {
+        format_count = 0;
+        computed_value value(counting_format, 1, 2);
+        memory_usage usage;
+        value.measure(usage);
+        THEN("it should be measured without being formatted") {
+            REQUIRE(format_count == 0);
+            REQUIRE(usage.nodes == 1u);
+            REQUIRE(usage.node_bytes == sizeof(computed_value));
+            REQUIRE(usage.string_bytes == 0u);
+        }
+        WHEN("it has been formatted") {
+            REQUIRE(value.value() == "1/2");
+            memory_usage formatted;
+            value.measure(formatted);
+            THEN("the formatted string should be counted") {
+                REQUIRE(format_count == 1);
+                REQUIRE(formatted.string_bytes >= sizeof(string));
+            }
+        }
+    }
+    GIVEN("a value that is looked up more than once") {
+        format_count = 0;
+        computed_value value(counting_format, 1, 2);
+        REQUIRE(value.value() == "1/2");
+        REQUIRE(value.value() == "1/2");
+        THEN("it should be formatted once") {
+            REQUIRE(format_count == 1);
+        }
+    }
+    GIVEN("a value that is looked up from multiple threads") {
+        format_count = 0;
+        computed_value value(counting_format, 3, 4);
+        vector<thread> threads;
+        atomic<int> matches(0);
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&]() {
+                if (value.value() == "3/4") {
+                    ++matches;
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        THEN("it should be formatted once") {
+            REQUIRE(matches == 8);
+            REQUIRE(format_count == 1);
+        }
+    }
+    GIVEN("a value to move") {
+        computed_value other(computed_value::size, 1024);
+        computed_value value(std::move(other));
+        THEN("the formatted string should be moved") {
+            REQUIRE(value.source() == 1024u);
+            REQUIRE(value.value() == "1.00 KiB");
+        }
+    }
+    GIVEN("a formatted value to move") {
+        format_count = 0;
+        computed_value other(counting_format, 5, 6);
+        REQUIRE(other.value() == "5/6");
+        computed_value value(counting_format, 1, 2);
+        value = std::move(other);
+        THEN("the formatted string should be moved without formatting again") {
+            REQUIRE(value.source() == 5u);
+            REQUIRE(value.value() == "5/6");
+            REQUIRE(format_count == 1);
+        }
+    }
+    GIVEN("a value to serialize") {
+        computed_value value(computed_value::size, 10485760);
+        WHEN("serialized to JSON") {
+            THEN("it should be a string") {
+                json_value json;
+                json_allocator allocator;
+                value.to_json(allocator, json);
+                REQUIRE(json.IsString());
+                REQUIRE(json.GetString() == string("10.00 MiB"));
+            }
+        }
+        WHEN("serialized to YAML") {
+            THEN("it should have the same value") {
+                Emitter emitter;
+                value.write(emitter);
+                REQUIRE(string(emitter.c_str()) == "10.00 MiB");
+
+                ostringstream stream;
+                {
+                    yaml_writer writer(stream);
+                    value.write(writer);
+                }
+                REQUIRE(stream.str() == "10.00 MiB");
+            }
+        }
+        WHEN("serialized to text with quotes") {
+            THEN("it should be quoted") {
+                ostringstream stream;
+                value.write(stream);
+                REQUIRE(stream.str() == "\"10.00 MiB\"");
+            }
+        }
+        WHEN("serialized to text without quotes") {
+            THEN("it should not be quoted") {
+                ostringstream stream;
+                value.write(stream, false);
+                REQUIRE(stream.str() == "10.00 MiB");
+            }
+        }
+    }
+}
@@ -59,4 +59,25 @@ SCENARIO("resolving external JSON facts") {
             REQUIRE(facts.get<string_value>("json_fact7")->value() == "bar");
         }
     }
+    GIVEN("JSON with nested string values") {
+        resolver.resolve(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/external/json_inventory/inventory.json", facts);
+        THEN("top-level string facts should be string values") {
+            REQUIRE(facts.get<string_value>("location"));
+            REQUIRE(facts.get<string_value>("location")->value() == "datacenter");
+        }
+        THEN("nested string values should be string values") {
+            auto inventory = facts.get<map_value>("inventory");
+            REQUIRE(inventory);
+            auto owner = inventory->get<string_value>("owner");
+            REQUIRE(owner);
+            REQUIRE(owner->value() == "foo");
+            auto racks = inventory->get<array_value>("racks");
+            REQUIRE(racks);
+            REQUIRE(racks->size() == 2u);
+            REQUIRE(racks->get<string_value>(0));
+            REQUIRE(racks->get<string_value>(0)->value() == "bar");
+            REQUIRE(racks->get<string_value>(1));
+            REQUIRE(racks->get<string_value>(1)->value() == "baz");
+        }
+    }
 }
@@ -0,0 +1,79 @@
+#include <catch.hpp>
+#include <internal/facts/linux/cgroup_resolver.hpp>
+#include "../../fixtures.hpp"
+
+using namespace std;
+using namespace facter::facts;
+
+struct cgroup_limits_resolver : linux::cgroup_resolver
+{
+    static data collect(string const& directory)
+    {
+        data result;
+        collect_limits(result, directory + "/cgroup", directory + "/mountinfo", directory);
+        return result;
+    }
+};
+
+SCENARIO("collecting control group limits") {
+    GIVEN("a process in a v2 control group") {
+        auto result = cgroup_limits_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/cgroup/v2");
+        THEN("the control group should be found") {
+            REQUIRE(result.version == 2u);
+            REQUIRE(result.path == "/system.slice/app.service");
+        }
+        THEN("the CPU quota should be collected") {
+            REQUIRE(result.cpu_quota.is_initialized());
+            REQUIRE(*result.cpu_quota == 150000u);
+            REQUIRE(result.cpu_period.is_initialized());
+            REQUIRE(*result.cpu_period == 100000u);
+        }
+        THEN("the effective CPU set should be collected") {
+            REQUIRE(result.cpuset_cpus == "0-3");
+            REQUIRE(result.cpuset_count == 4u);
+        }
+        THEN("the lowest memory limits of the control group and its ancestors should be collected") {
+            REQUIRE(result.memory_max.is_initialized());
+            REQUIRE(*result.memory_max == 1024ull * 1024 * 1024);
+            REQUIRE(result.memory_high.is_initialized());
+            REQUIRE(*result.memory_high == 768ull * 1024 * 1024);
+        }
+        THEN("the process limit should be collected") {
+            REQUIRE(result.pids_max.is_initialized());
+            REQUIRE(*result.pids_max == 512u);
+        }
+    }
+    GIVEN("a process in v1 control groups") {
+        auto result = cgroup_limits_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/cgroup/v1");
+        THEN("the control group should be found") {
+            REQUIRE(result.version == 1u);
+            REQUIRE(result.path == "/docker/abc");
+        }
+        THEN("unlimited ancestors should not affect the CPU quota") {
+            REQUIRE(result.cpu_quota.is_initialized());
+            REQUIRE(*result.cpu_quota == 50000u);
+            REQUIRE(result.cpu_period.is_initialized());
+            REQUIRE(*result.cpu_period == 100000u);
+        }
+        THEN("the CPU set should be collected") {
+            REQUIRE(result.cpuset_cpus == "0-1");
+            REQUIRE(result.cpuset_count == 2u);
+        }
+        THEN("the memory limit should be collected without a throttling limit") {
+            REQUIRE(result.memory_max.is_initialized());
+            REQUIRE(*result.memory_max == 512ull * 1024 * 1024);
+            REQUIRE_FALSE(result.memory_high.is_initialized());
+        }
+        THEN("the process limit should be read from a mount of the control group itself") {
+            REQUIRE(result.pids_max.is_initialized());
+            REQUIRE(*result.pids_max == 256u);
+        }
+    }
+    GIVEN("a missing control group file") {
+        auto result = cgroup_limits_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/does_not_exist");
+        THEN("no control group should be found") {
+            REQUIRE(result.version == 0u);
+            REQUIRE_FALSE(result.memory_max.is_initialized());
+        }
+    }
+}
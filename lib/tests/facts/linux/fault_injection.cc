@@ -0,0 +1,160 @@
+#include <catch.hpp>
+#include <facter/facts/fact.hpp>
+#include <facter/facts/map_value.hpp>
+#include <facter/facts/resolver.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <internal/execution/execution.hpp>
+#include <internal/facts/linux/kernel_resolver.hpp>
+#include <internal/facts/linux/memory_resolver.hpp>
+#include <internal/facts/linux/networking_resolver.hpp>
+#include <internal/facts/linux/processor_resolver.hpp>
+#include "../../collection_fixture.hpp"
+#include "../../fault_injection.hpp"
+#include "../../log_capture.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::testing;
+using facter::util::host::access;
+
+// Resolves a fact from a command run with a timeout, as the Solaris resolvers run prtdiag
+struct timed_command_resolver : resolver
+{
+    timed_command_resolver() : resolver("timed command", { "timed_command" })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        try {
+            auto exec = facter::execution::execute("uname", { "-s" }, 1);
+            if (exec.success) {
+                facts.add("timed_command", make_value<string_value>(exec.output));
+            }
+        } catch (facter::execution::timeout_exception const&) {
+            ++timeouts;
+        }
+    }
+
+    atomic<int> timeouts { 0 };
+};
+
+// Always looks up an unqualified hostname, so the FQDN is resolved through getaddrinfo whatever the host's name is
+struct unqualified_networking_resolver : linux::networking_resolver
+{
+ protected:
+    virtual string get_hostname() const override
+    {
+        return "facter-fault-host";
+    }
+};
+
+// The time resolution is given before it is considered stalled; far longer than any scenario takes when it works
+static const chrono::seconds watchdog_limit(30);
+
+// Resolves the facts on a worker thread and returns whether resolution finished before the watchdog limit
+// If it did not, any hung access is released so the worker can be joined
+static bool resolve_with_watchdog(collection_fixture& facts, fault_injection& faults)
+{
+    promise<void> finished;
+    auto future = finished.get_future();
+    thread worker([&]() {
+        facts.resolve_facts();
+        finished.set_value();
+    });
+    bool completed = future.wait_for(watchdog_limit) == future_status::ready;
+    if (!completed) {
+        faults.release();
+    }
+    worker.join();
+    return completed;
+}
+
+SCENARIO("resolving facts from a stalling host") {
+    collection_fixture facts;
+    facts.add(make_shared<linux::kernel_resolver>());
+    facts.add(make_shared<linux::memory_resolver>());
+    facts.add(make_shared<linux::processor_resolver>());
+    fault_injection faults;
+
+    GIVEN("a slow /proc/meminfo") {
+        auto delay = chrono::milliseconds(250);
+        faults.delay(access::file, "^/proc/meminfo$", delay);
+        auto start = chrono::steady_clock::now();
+        bool completed = resolve_with_watchdog(facts, faults);
+        auto elapsed = chrono::steady_clock::now() - start;
+        THEN("the latency is only paid once and resolution completes") {
+            REQUIRE(completed);
+            REQUIRE(faults.hits("^/proc/meminfo$") == 1u);
+            REQUIRE(elapsed >= delay);
+            REQUIRE(facts.get<map_value>(fact::memory));
+            REQUIRE(facts.get<string_value>(fact::kernel));
+            REQUIRE(facts.get<map_value>(fact::processors));
+        }
+    }
+    GIVEN("an unreadable /proc") {
+        faults.fail(access::file, "^/proc/");
+        faults.fail(access::directory, "^/proc/");
+        faults.fail(access::stat, "^/proc/");
+        facts.resolve_facts();
+        THEN("facts from other sources still resolve") {
+            REQUIRE(faults.hits("^/proc/") > 0u);
+            REQUIRE(facts.get<string_value>(fact::kernel));
+            REQUIRE(facts.get<string_value>(fact::kernel_release));
+        }
+    }
+    GIVEN("a /proc/cpuinfo that hangs until released") {
+        faults.hang(access::file, "^/proc/cpuinfo$");
+        thread releaser([&]() {
+            // Only release once the read is blocked; a release before the hang is reached would not end it
+            while (faults.hits("^/proc/cpuinfo$") == 0) {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+            faults.release();
+        });
+        facts.resolve_facts();
+        releaser.join();
+        THEN("resolution waits for the read, as file reads have no deadline, and resumes once it is released") {
+            REQUIRE(faults.hits("^/proc/cpuinfo$") == 1u);
+            REQUIRE(facts.get<map_value>(fact::memory));
+            REQUIRE(facts.get<string_value>(fact::kernel));
+        }
+    }
+    GIVEN("a command run with a timeout that hangs and is never released") {
+        auto timed = make_shared<timed_command_resolver>();
+        facts.add(timed);
+        faults.hang(access::command, "^uname -s$");
+        bool completed = resolve_with_watchdog(facts, faults);
+        THEN("the command times out on its own and the other facts still resolve") {
+            REQUIRE(completed);
+            REQUIRE(faults.hits("^uname -s$") == 1u);
+            REQUIRE(timed->timeouts == 1);
+            REQUIRE_FALSE(facts.get<string_value>("timed_command"));
+            REQUIRE(facts.get<map_value>(fact::memory));
+            REQUIRE(facts.get<string_value>(fact::kernel));
+            REQUIRE(facts.get<map_value>(fact::processors));
+        }
+    }
+    GIVEN("hostname lookups that fail with a temporary DNS failure") {
+        facts.add(make_shared<unqualified_networking_resolver>());
+        faults.fail(access::dns, ".*");
+        log_capture capture(facter::logging::level::error);
+        facts.resolve_facts();
+        THEN("the failure is logged and the other facts still resolve") {
+            REQUIRE(faults.hits("^facter-fault-host$") == 1u);
+            auto output = capture.result();
+            CAPTURE(output);
+            REQUIRE(output.find("getaddrinfo failed") != string::npos);
+            auto hostname = facts.get<string_value>(fact::hostname);
+            REQUIRE(hostname);
+            REQUIRE(hostname->value() == "facter-fault-host");
+            REQUIRE(facts.get<map_value>(fact::memory));
+            REQUIRE(facts.get<string_value>(fact::kernel));
+            REQUIRE(facts.get<map_value>(fact::processors));
+        }
+    }
+}
@@ -1,8 +1,22 @@
 #include <catch.hpp>
 #include <internal/facts/linux/filesystem_resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <internal/util/host.hpp>
+#include "../../collection_fixture.hpp"
+#include "../../fixtures.hpp"
+#include <leatherman/util/scope_exit.hpp>
+#include <algorithm>
 
 using namespace std;
 using namespace facter::facts::linux;
+using namespace facter::testing;
+using leatherman::util::scope_exit;
+
+struct exposed_filesystem_resolver : filesystem_resolver
+{
+    using filesystem_resolver::partition;
+    using filesystem_resolver::collect_data;
+};
 
 SCENARIO("blkid output with non-printable ASCII characters") {
     REQUIRE(filesystem_resolver::safe_convert("") == "");
@@ -11,3 +25,76 @@ SCENARIO("blkid output with non-printable ASCII characters") {
     REQUIRE(filesystem_resolver::safe_convert("\\hello\\") == "\\\\hello\\\\");
     REQUIRE(filesystem_resolver::safe_convert("i am \xE0\xB2\xA0\x5F\xE0\xB2\xA0") == "i am M-`M-2M- _M-`M-2M- ");
 }
+
+SCENARIO("filtering mountpoints and partitions") {
+    collection_fixture facts;
+    GIVEN("no filters") {
+        filesystem_resolver::filters filter(facts);
+        THEN("nothing should be excluded") {
+            REQUIRE_FALSE(filter.filters_partitions());
+            REQUIRE_FALSE(filter.exclude_mountpoint("/", "/dev/sda1", "ext4"));
+            REQUIRE_FALSE(filter.exclude_partition("/dev/loop0"));
+        }
+    }
+    GIVEN("file system type filters") {
+        facts.set_option("mountpoints-exclude-types", { "overlay", "fuse.*" });
+        filesystem_resolver::filters filter(facts);
+        THEN("mountpoints of matching types should be excluded") {
+            REQUIRE(filter.exclude_mountpoint("/var/lib/docker/overlay2/1/merged", "/dev/sda1", "overlay"));
+            REQUIRE(filter.exclude_mountpoint("/mnt/remote", "/dev/fuse", "fuse.sshfs"));
+            REQUIRE_FALSE(filter.exclude_mountpoint("/", "/dev/sda1", "ext4"));
+        }
+    }
+    GIVEN("path filters") {
+        facts.set_option("mountpoints-exclude-paths", { "/var/lib/kubelet/", "/run" });
+        filesystem_resolver::filters filter(facts);
+        THEN("mountpoints at or beneath the paths should be excluded") {
+            REQUIRE(filter.exclude_mountpoint("/var/lib/kubelet", "/dev/sdb1", "xfs"));
+            REQUIRE(filter.exclude_mountpoint("/var/lib/kubelet/pods/1/volumes/secret", "/dev/sdb1", "xfs"));
+            REQUIRE(filter.exclude_mountpoint("/run/netns/cni-1", "/dev/sdb1", "xfs"));
+        }
+        THEN("mountpoints that only share a prefix should not be excluded") {
+            REQUIRE_FALSE(filter.exclude_mountpoint("/var/lib/kubelet2", "/dev/sdb1", "xfs"));
+            REQUIRE_FALSE(filter.exclude_mountpoint("/running", "/dev/sdb1", "xfs"));
+            REQUIRE_FALSE(filter.exclude_mountpoint("/", "/dev/sda1", "ext4"));
+        }
+    }
+    GIVEN("mountpoint device filters") {
+        facts.set_option("mountpoints-exclude-devices", { "/dev/loop*" });
+        filesystem_resolver::filters filter(facts);
+        THEN("mountpoints of matching devices should be excluded") {
+            REQUIRE(filter.exclude_mountpoint("/snap/core/1", "/dev/loop3", "squashfs"));
+            REQUIRE_FALSE(filter.exclude_mountpoint("/", "/dev/sda1", "ext4"));
+        }
+        THEN("partitions should not be excluded") {
+            REQUIRE_FALSE(filter.filters_partitions());
+            REQUIRE_FALSE(filter.exclude_partition("/dev/loop3"));
+        }
+    }
+    GIVEN("partition device filters") {
+        facts.set_option("partitions-exclude-devices", { "/dev/loop*", "/dev/mapper/docker-*" });
+        filesystem_resolver::filters filter(facts);
+        THEN("matching partitions should be excluded") {
+            REQUIRE(filter.filters_partitions());
+            REQUIRE(filter.exclude_partition("/dev/loop12"));
+            REQUIRE(filter.exclude_partition("/dev/mapper/docker-253:0-1-pool"));
+            REQUIRE_FALSE(filter.exclude_partition("/dev/sda1"));
+            REQUIRE_FALSE(filter.exclude_partition("/dev/mapper/vg-root"));
+        }
+    }
+    GIVEN("a host whose root file system is mounted on an excluded path") {
+        facter::util::replay_snapshot(LIBFACTER_TESTS_DIRECTORY "/fixtures/snapshots/linux.yaml");
+        scope_exit finish([]() { facter::util::finish_snapshot(); });
+        facts.set_option("mountpoints-exclude-paths", { "/" });
+        exposed_filesystem_resolver resolver;
+        auto result = resolver.collect_data(facts);
+        THEN("the mountpoint should be excluded but its partition should still report where it is mounted") {
+            REQUIRE(result.mountpoints.empty());
+            auto partition = find_if(result.partitions.begin(), result.partitions.end(), [](exposed_filesystem_resolver::partition const& part) {
+                return part.name == "/dev/sda1";
+            });
+            REQUIRE(partition != result.partitions.end());
+            REQUIRE(partition->mount == "/");
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#include <catch.hpp>
+#include <internal/facts/linux/memory_resolver.hpp>
+#include "../../fixtures.hpp"
+
+using namespace std;
+using namespace facter::facts;
+
+struct numa_memory_resolver : linux::memory_resolver
+{
+    static data collect(string const& root)
+    {
+        data result;
+        collect_numa_data(result, root);
+        return result;
+    }
+};
+
+SCENARIO("collecting NUMA node memory from sysfs") {
+    GIVEN("a sysfs tree with NUMA nodes") {
+        auto result = numa_memory_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/sysfs/node");
+        THEN("the memory of each node should be collected") {
+            REQUIRE(result.numa_nodes.size() == 2u);
+            REQUIRE(result.numa_nodes[0].name == "node0");
+            REQUIRE(result.numa_nodes[0].mem_total == 8ull * 1024 * 1024 * 1024);
+            REQUIRE(result.numa_nodes[0].mem_free == 5ull * 1024 * 1024 * 1024);
+            REQUIRE(result.numa_nodes[1].name == "node1");
+            REQUIRE(result.numa_nodes[1].mem_total == 8ull * 1024 * 1024 * 1024);
+            REQUIRE(result.numa_nodes[1].mem_free == 2ull * 1024 * 1024 * 1024);
+        }
+    }
+    GIVEN("a missing sysfs tree") {
+        auto result = numa_memory_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/does_not_exist");
+        THEN("no nodes should be collected") {
+            REQUIRE(result.numa_nodes.empty());
+        }
+    }
+}
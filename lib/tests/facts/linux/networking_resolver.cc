@@ -0,0 +1,73 @@
+#include <catch.hpp>
+#include <internal/facts/linux/networking_resolver.hpp>
+#include "../../fixtures.hpp"
+
+using namespace std;
+using namespace facter::facts;
+
+struct dhcp_lease_resolver : linux::networking_resolver
+{
+    using networking_resolver::parse_dhcp_sources;
+
+    static dhcp_leases scan(unsigned int sources)
+    {
+        return scan_dhcp_leases(sources, LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/dhcp");
+    }
+};
+
+SCENARIO("parsing DHCP lease sources") {
+    GIVEN("no sources") {
+        THEN("every lease file source should be used, but not dhcpcd") {
+            auto sources = dhcp_lease_resolver::parse_dhcp_sources({});
+            REQUIRE(sources == (linux::networking_resolver::dhclient | linux::networking_resolver::networkd | linux::networking_resolver::networkmanager));
+        }
+    }
+    GIVEN("dhcpcd") {
+        THEN("only dhcpcd should be used") {
+            REQUIRE(dhcp_lease_resolver::parse_dhcp_sources({ "dhcpcd" }) == linux::networking_resolver::dhcpcd);
+        }
+    }
+    GIVEN("all or none") {
+        THEN("every source or no source should be used") {
+            REQUIRE(dhcp_lease_resolver::parse_dhcp_sources({ "all" }) == 15u);
+            REQUIRE(dhcp_lease_resolver::parse_dhcp_sources({ "none" }) == linux::networking_resolver::no_sources);
+            REQUIRE(dhcp_lease_resolver::parse_dhcp_sources({ "unknown" }) == linux::networking_resolver::no_sources);
+        }
+    }
+}
+
+SCENARIO("scanning DHCP lease files") {
+    GIVEN("every lease file source") {
+        auto leases = dhcp_lease_resolver::scan(dhcp_lease_resolver::parse_dhcp_sources({}));
+        THEN("dhclient leases should be found by interface name") {
+            REQUIRE(leases.by_name["eth1"] == "172.16.0.1");
+        }
+        THEN("the last dhclient lease for an interface should be used") {
+            REQUIRE(leases.by_name["eth0"] == "10.0.0.2");
+        }
+        THEN("NetworkManager leases should be found by interface name") {
+            REQUIRE(leases.by_name["wlan0"] == "192.168.1.1");
+            REQUIRE(leases.by_name["enp1s0"] == "192.168.50.1");
+        }
+        THEN("systemd-networkd leases should be found by interface index") {
+            REQUIRE(leases.by_index.size() == 1u);
+            REQUIRE(leases.by_index[3] == "10.1.0.1");
+        }
+    }
+    GIVEN("only the dhclient source") {
+        auto leases = dhcp_lease_resolver::scan(linux::networking_resolver::dhclient);
+        THEN("only dhclient leases should be found") {
+            REQUIRE(leases.by_name.size() == 2u);
+            REQUIRE(leases.by_name.count("eth0") == 1u);
+            REQUIRE(leases.by_name.count("eth1") == 1u);
+            REQUIRE(leases.by_index.empty());
+        }
+    }
+    GIVEN("no sources") {
+        auto leases = dhcp_lease_resolver::scan(linux::networking_resolver::no_sources);
+        THEN("no leases should be found") {
+            REQUIRE(leases.by_name.empty());
+            REQUIRE(leases.by_index.empty());
+        }
+    }
+}
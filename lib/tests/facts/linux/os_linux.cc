@@ -0,0 +1,77 @@
+#include <catch.hpp>
+#include <internal/facts/linux/os_linux.hpp>
+#include <boost/regex.hpp>
+
+using namespace std;
+using namespace facter::facts::linux;
+
+SCENARIO("parsing key-value lines from release files") {
+    GIVEN("typical os-release lines") {
+        THEN("the key and unquoted value should be returned") {
+            string key, value;
+            REQUIRE(os_linux::parse_key_value("NAME=\"Ubuntu\"", key, value));
+            REQUIRE(key == "NAME");
+            REQUIRE(value == "Ubuntu");
+            REQUIRE(os_linux::parse_key_value("VERSION_ID='16.04'", key, value));
+            REQUIRE(key == "VERSION_ID");
+            REQUIRE(value == "16.04");
+            REQUIRE(os_linux::parse_key_value("ID=ubuntu", key, value));
+            REQUIRE(key == "ID");
+            REQUIRE(value == "ubuntu");
+            REQUIRE(os_linux::parse_key_value("PRETTY_NAME=\"Ubuntu 16.04 LTS\"\r", key, value));
+            REQUIRE(key == "PRETTY_NAME");
+            REQUIRE(value == "Ubuntu 16.04 LTS");
+        }
+    }
+    GIVEN("lines that are not key-value pairs") {
+        THEN("they should not be parsed") {
+            string key, value;
+            REQUIRE_FALSE(os_linux::parse_key_value("", key, value));
+            REQUIRE_FALSE(os_linux::parse_key_value("# comment", key, value));
+            REQUIRE_FALSE(os_linux::parse_key_value("NAME=", key, value));
+            REQUIRE_FALSE(os_linux::parse_key_value("=value", key, value));
+            REQUIRE_FALSE(os_linux::parse_key_value(" NAME=value", key, value));
+            REQUIRE_FALSE(os_linux::parse_key_value("NAME-2=value", key, value));
+        }
+    }
+    GIVEN("a corpus of lines") {
+        static const vector<string> lines = {
+            "A=b",
+            "A=\"b\"",
+            "A='b'",
+            "A=\"b'",
+            "A=\"",
+            "A='",
+            "A=\"\"",
+            "A=''",
+            "A=\"\"\"",
+            "A=b\"c\"",
+            "A=b c",
+            "A= b ",
+            "A==b",
+            "A=b=c",
+            "A_1=x\r",
+            "A=\"x\"\r",
+            "A=\r",
+            "A=x\ry",
+            "junk\rA=b",
+            "\fA='b'\f",
+            "a b=c",
+            "9=9",
+        };
+        THEN("the results should be the same as the regex previously used") {
+            boost::regex pattern("(?m)^(\\w+)=[\"']?(.+?)[\"']?$");
+            for (auto const& line : lines) {
+                CAPTURE(line);
+                string key, value;
+                boost::smatch match;
+                bool matched = boost::regex_search(line, match, pattern);
+                REQUIRE(os_linux::parse_key_value(line, key, value) == matched);
+                if (matched) {
+                    REQUIRE(key == match[1].str());
+                    REQUIRE(value == match[2].str());
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include <catch.hpp>
+#include <internal/facts/linux/processor_resolver.hpp>
+#include <internal/util/host.hpp>
+#include "../../fixtures.hpp"
+#include <leatherman/util/scope_exit.hpp>
+#include <algorithm>
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::testing;
+using leatherman::util::scope_exit;
+
+struct exposed_processor_resolver : linux::processor_resolver
+{
+    using linux::processor_resolver::cache;
+    using linux::processor_resolver::numa_node;
+
+    static data collect(string const& root)
+    {
+        data result;
+        collect_topology(result, root);
+        return result;
+    }
+
+    static data parse_features(string const& flags)
+    {
+        data result;
+        parse_isa_features(result, flags);
+        set_vector_extensions(result);
+        return result;
+    }
+
+    data collect_all(collection& facts)
+    {
+        return collect_data(facts);
+    }
+
+    static data collect_features(bool& collected)
+    {
+        data result;
+        collected = collect_isa_features(result);
+        return result;
+    }
+};
+
+SCENARIO("collecting the processor topology from sysfs") {
+    GIVEN("a sysfs tree with caches and NUMA nodes") {
+        auto result = exposed_processor_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/sysfs");
+        THEN("identical caches should be counted once per instance") {
+            REQUIRE(result.caches.size() == 4u);
+
+            auto const& l1d = result.caches[0];
+            REQUIRE(l1d.level == 1);
+            REQUIRE(l1d.type == "Data");
+            REQUIRE(l1d.size == 32 * 1024u);
+            REQUIRE(l1d.shared_cpus == 2);
+            REQUIRE(l1d.count == 2);
+
+            auto const& l1i = result.caches[1];
+            REQUIRE(l1i.level == 1);
+            REQUIRE(l1i.type == "Instruction");
+            REQUIRE(l1i.count == 2);
+
+            auto const& l2 = result.caches[2];
+            REQUIRE(l2.level == 2);
+            REQUIRE(l2.type == "Unified");
+            REQUIRE(l2.size == 1024 * 1024u);
+            REQUIRE(l2.shared_cpus == 2);
+            REQUIRE(l2.count == 2);
+
+            auto const& l3 = result.caches[3];
+            REQUIRE(l3.level == 3);
+            REQUIRE(l3.size == 16 * 1024 * 1024u);
+            REQUIRE(l3.shared_cpus == 4);
+            REQUIRE(l3.count == 1);
+        }
+        THEN("the NUMA nodes should be collected in order") {
+            REQUIRE(result.numa_nodes.size() == 2u);
+            REQUIRE(result.numa_nodes[0].name == "node0");
+            REQUIRE(result.numa_nodes[0].cpus == "0-1");
+            REQUIRE(result.numa_nodes[0].cpu_count == 2);
+            REQUIRE(result.numa_nodes[1].name == "node1");
+            REQUIRE(result.numa_nodes[1].cpus == "2-3");
+            REQUIRE(result.numa_nodes[1].cpu_count == 2);
+        }
+    }
+    GIVEN("a missing sysfs tree") {
+        auto result = exposed_processor_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/does_not_exist");
+        THEN("no topology should be collected") {
+            REQUIRE(result.caches.empty());
+            REQUIRE(result.numa_nodes.empty());
+        }
+    }
+    GIVEN("the sysfs tree is read with I/O accounting") {
+        facter::util::host::io_scope io;
+        exposed_processor_resolver::collect(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/sysfs");
+        auto counters = io.counters();
+        THEN("the number of files opened should not grow") {
+            // The bounds are the opens of the fixture host today; raise them only for a deliberate new read
+            REQUIRE(counters.opens <= 31u);
+            REQUIRE(counters.scans <= 2u);
+            REQUIRE(counters.bytes_read > 0u);
+        }
+    }
+}
+
+SCENARIO("collecting the processor instruction set features") {
+    GIVEN("the flags of a processor in /proc/cpuinfo") {
+        auto result = exposed_processor_resolver::parse_features("fpu sse2  sse avx2 asimd avx sse2 pni avx512f sve\t");
+        THEN("the features should be sorted without duplicates") {
+            REQUIRE(result.isa_features == (vector<string>{ "asimd", "avx", "avx2", "avx512f", "fpu", "pni", "sse", "sse2", "sve" }));
+        }
+        THEN("the vector extensions of the architecture should be summarized") {
+#if defined(__x86_64__) || defined(__i386__)
+            REQUIRE(result.vector_extensions.size() == 10u);
+            REQUIRE(result.vector_extensions["sse2"]);
+            REQUIRE(result.vector_extensions["sse3"]);
+            REQUIRE_FALSE(result.vector_extensions["ssse3"]);
+            REQUIRE(result.vector_extensions["avx2"]);
+            REQUIRE(result.vector_extensions["avx512"]);
+            REQUIRE_FALSE(result.vector_extensions["fma"]);
+#elif defined(__aarch64__)
+            REQUIRE(result.vector_extensions.size() == 4u);
+            REQUIRE(result.vector_extensions["neon"]);
+            REQUIRE(result.vector_extensions["sve"]);
+            REQUIRE_FALSE(result.vector_extensions["sve2"]);
+#endif
+        }
+    }
+    GIVEN("no flags") {
+        auto result = exposed_processor_resolver::parse_features("");
+        THEN("no features or vector extensions should be collected") {
+            REQUIRE(result.isa_features.empty());
+            REQUIRE(result.vector_extensions.empty());
+        }
+    }
+    GIVEN("a replayed host whose /proc/cpuinfo lists flags") {
+        facter::util::replay_snapshot(LIBFACTER_TESTS_DIRECTORY "/fixtures/snapshots/linux.yaml");
+        scope_exit finish([]() { facter::util::finish_snapshot(); });
+        collection_fixture facts;
+        exposed_processor_resolver resolver;
+        auto result = resolver.collect_all(facts);
+        THEN("the flags should be reported, as the processor running the replay is not the recorded one") {
+            REQUIRE(result.isa_features == (vector<string>{ "aes", "avx", "avx2", "fpu", "hypervisor", "sse", "sse2", "sse4_1", "sse4_2", "ssse3" }));
+        }
+    }
+#if defined(__x86_64__)
+    GIVEN("an x86-64 processor") {
+        bool collected = false;
+        auto result = exposed_processor_resolver::collect_features(collected);
+        THEN("the features should be collected from CPUID") {
+            REQUIRE(collected);
+            REQUIRE(is_sorted(result.isa_features.begin(), result.isa_features.end()));
+            REQUIRE(find(result.isa_features.begin(), result.isa_features.end(), "sse2") != result.isa_features.end());
+            REQUIRE(find(result.isa_features.begin(), result.isa_features.end(), "lm") != result.isa_features.end());
+        }
+    }
+#endif
+}
@@ -0,0 +1,86 @@
+#include <catch.hpp>
+#include <internal/facts/linux/tunables_resolver.hpp>
+#include "../../fixtures.hpp"
+
+using namespace std;
+using namespace facter::facts;
+
+struct tunables_fixture_resolver : linux::tunables_resolver
+{
+    static data collect(vector<string> const& tunables)
+    {
+        data result;
+        collect_tunables(result, tunables, LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/tunables");
+        return result;
+    }
+};
+
+SCENARIO("collecting kernel tunables") {
+    GIVEN("no tunables") {
+        auto result = tunables_fixture_resolver::collect({});
+        THEN("nothing should be collected") {
+            REQUIRE(result.values.empty());
+        }
+    }
+    GIVEN("sysctl names") {
+        auto result = tunables_fixture_resolver::collect({ "vm.swappiness", "net.core.somaxconn", "kernel.numa_balancing" });
+        THEN("the values should be keyed by sysctl name") {
+            REQUIRE(result.values.size() == 3u);
+            REQUIRE(result.values["vm.swappiness"] == "10");
+            REQUIRE(result.values["net.core.somaxconn"] == "4096");
+            REQUIRE(result.values["kernel.numa_balancing"] == "1");
+        }
+    }
+    GIVEN("paths") {
+        auto result = tunables_fixture_resolver::collect({ "/sys/kernel/mm/transparent_hugepage/enabled", "/proc/sys/vm/overcommit_memory" });
+        THEN("the values should be keyed by path") {
+            REQUIRE(result.values.size() == 2u);
+            REQUIRE(result.values["/sys/kernel/mm/transparent_hugepage/enabled"] == "always [madvise] never");
+            REQUIRE(result.values["/proc/sys/vm/overcommit_memory"] == "1");
+        }
+    }
+    GIVEN("tunables with wildcards") {
+        auto result = tunables_fixture_resolver::collect({
+            "/sys/kernel/mm/hugepages/*/nr_hugepages",
+            "/sys/devices/system/cpu/cpufreq/policy*/scaling_governor",
+            "net.ipv4.conf.*.rp_filter"
+        });
+        THEN("each matching tunable should be collected") {
+            REQUIRE(result.values.size() == 7u);
+            REQUIRE(result.values["/sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages"] == "512");
+            REQUIRE(result.values["/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages"] == "2");
+            REQUIRE(result.values["/sys/devices/system/cpu/cpufreq/policy0/scaling_governor"] == "performance");
+            REQUIRE(result.values["/sys/devices/system/cpu/cpufreq/policy1/scaling_governor"] == "powersave");
+            REQUIRE(result.values["net.ipv4.conf.all.rp_filter"] == "0");
+            REQUIRE(result.values["net.ipv4.conf.eth0.rp_filter"] == "2");
+            REQUIRE(result.values["net.ipv4.conf.eth0/100.rp_filter"] == "1");
+        }
+    }
+    GIVEN("sysctl names with a dot in a component") {
+        auto dotted = tunables_fixture_resolver::collect({ "net.ipv4.conf.eth0/100.rp_filter" });
+        auto slashed = tunables_fixture_resolver::collect({ "net/ipv4/conf/eth0.100/rp_filter" });
+        THEN("the values should be keyed by sysctl name with the dot written as a slash") {
+            REQUIRE(dotted.values.size() == 1u);
+            REQUIRE(dotted.values["net.ipv4.conf.eth0/100.rp_filter"] == "1");
+            REQUIRE(slashed.values == dotted.values);
+        }
+    }
+    GIVEN("tunables that do not exist") {
+        auto result = tunables_fixture_resolver::collect({ "vm.does_not_exist", "/sys/kernel/mm/hugepages/*/does_not_exist" });
+        THEN("nothing should be collected") {
+            REQUIRE(result.values.empty());
+        }
+    }
+    GIVEN("paths outside of /proc/sys and /sys") {
+        auto result = tunables_fixture_resolver::collect({
+            "/proc/self/environ",
+            "/etc/shadow",
+            "/sys/../proc/sys/vm/swappiness",
+            "vm/../../../etc/shadow",
+            "/sys"
+        });
+        THEN("nothing should be collected") {
+            REQUIRE(result.values.empty());
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#include <catch.hpp>
+#include <internal/facts/linux/virtualization_resolver.hpp>
+#include <facter/facts/vm.hpp>
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::facts::linux;
+
+SCENARIO("determining the hypervisor from lspci output") {
+    static const vector<pair<string, string>> lines = {
+        { "00:0f.0 VGA compatible controller: VMware SVGA II Adapter",                              string(vm::vmware) },
+        { "00:0f.0 VGA compatible controller: VMWare SVGA II Adapter",                              string(vm::vmware) },
+        { "00:02.0 VGA compatible controller: InnoTek Systemberatung GmbH VirtualBox Graphics Adapter", string(vm::virtualbox) },
+        { "00:03.0 Unassigned class [ff00]: Parallels, Inc. Virtual Machine Communication Interface", string(vm::parallels) },
+        { "00:03.0 Unassigned class [ff00]: parallels virtual device",                             string(vm::parallels) },
+        { "00:05.0 Class 0000: 1ab8:4000",                                                          string(vm::parallels) },
+        { "00:03.0 Unassigned class [ff80]: XenSource, Inc. Xen Platform Device (rev 01)",          string(vm::xen_hardware) },
+        { "00:08.0 VGA compatible controller: Microsoft Corporation Hyper-V virtual VGA",            string(vm::hyperv) },
+        { "00:01.0 Class 8007: Google, Inc. Device 6442",                                           string(vm::gce) },
+        { "00:03.0 Ethernet controller: Red Hat, Inc Virtio network device",                        string(vm::kvm) },
+        { "00:04.0 SCSI storage controller: Red Hat, Inc VIRTIO block device",                      string(vm::kvm) },
+        { "00:00.0 Host bridge: Intel Corporation 440FX - 82441FX PMC [Natoma] (rev 02)",           string() },
+        { "00:0f.0 VGA compatible controller: Vmware SVGA II Adapter",                              string() },
+        { "",                                                                                       string() },
+    };
+
+    for (auto const& line : lines) {
+        CAPTURE(line.first);
+        REQUIRE(virtualization_resolver::parse_lspci(line.first) == line.second);
+    }
+}
@@ -77,6 +77,16 @@ SCENARIO("using a map fact value") {
                 return true;
             });
         }
+        WHEN("measured") {
+            THEN("it should count every value and element") {
+                memory_usage usage;
+                value.measure(usage);
+                REQUIRE(usage.nodes == 8u);
+                REQUIRE(usage.node_bytes >= sizeof(map_value) * 2 + sizeof(array_value));
+                REQUIRE(usage.container_bytes > 0u);
+                REQUIRE(usage.total() == usage.node_bytes + usage.string_bytes + usage.container_bytes);
+            }
+        }
         WHEN("serialized to JSON") {
             THEN("it should contain the same values") {
                 json_value json;
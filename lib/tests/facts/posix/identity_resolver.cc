@@ -0,0 +1,147 @@
+#include <catch.hpp>
+#include <internal/facts/posix/identity_resolver.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+using namespace facter::facts;
+namespace lth_file = leatherman::file_util;
+
+struct test_identity_resolver : posix::identity_resolver
+{
+    static data collect(chrono::milliseconds timeout, string const& cache_path, lookup_function lookup)
+    {
+        return collect_identity(1000, 100, timeout, cache_path, lookup);
+    }
+
+    static data collect(uid_t uid, gid_t gid, chrono::milliseconds timeout, lookup_function lookup)
+    {
+        return collect_identity(uid, gid, timeout, {}, lookup);
+    }
+
+    static data lookup(uid_t uid, gid_t gid)
+    {
+        data result;
+        result.user_id = uid;
+        result.user_name = "alice";
+        result.privileged = false;
+        result.group_id = gid;
+        result.group_name = "staff";
+        return result;
+    }
+
+    static lookup_function blocked(shared_ptr<struct blocked_lookup> const& lookup);
+
+    static lookup_function counted(shared_ptr<struct blocked_lookup> const& lookup, shared_ptr<atomic<int>> const& calls);
+};
+
+// Blocks lookups until released, like NSS does when a directory service is unreachable
+struct blocked_lookup
+{
+    void wait()
+    {
+        unique_lock<mutex> lock(_mutex);
+        _released.wait(lock, [this] { return _done; });
+    }
+
+    void release()
+    {
+        lock_guard<mutex> lock(_mutex);
+        _done = true;
+        _released.notify_all();
+    }
+
+ private:
+    mutex _mutex;
+    condition_variable _released;
+    bool _done = false;
+};
+
+test_identity_resolver::lookup_function test_identity_resolver::blocked(shared_ptr<blocked_lookup> const& lookup)
+{
+    return [lookup](uid_t, gid_t) {
+        lookup->wait();
+        return data();
+    };
+}
+
+test_identity_resolver::lookup_function test_identity_resolver::counted(shared_ptr<blocked_lookup> const& lookup, shared_ptr<atomic<int>> const& calls)
+{
+    return [lookup, calls](uid_t, gid_t) {
+        ++*calls;
+        lookup->wait();
+        return data();
+    };
+}
+
+SCENARIO("looking up the user and group with a deadline") {
+    auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("facter-identity-%%%%-%%%%-%%%%");
+    auto cache_path = (directory / "identity").string();
+    auto blocked = make_shared<blocked_lookup>();
+    auto never_returns = test_identity_resolver::blocked(blocked);
+
+    GIVEN("a lookup that completes") {
+        auto result = test_identity_resolver::collect(chrono::milliseconds(5000), cache_path, &test_identity_resolver::lookup);
+        THEN("the looked up names should be used") {
+            REQUIRE(result.user_name == "alice");
+            REQUIRE(result.group_name == "staff");
+        }
+        THEN("the names should be cached") {
+            REQUIRE(lth_file::read(cache_path) == "user 1000 alice\ngroup 100 staff\n");
+        }
+        AND_WHEN("a later lookup does not complete in time") {
+            auto stale = test_identity_resolver::collect(chrono::milliseconds(10), cache_path, never_returns);
+            THEN("the cached names should be used") {
+                REQUIRE(stale.user_id.is_initialized());
+                REQUIRE(*stale.user_id == 1000);
+                REQUIRE(stale.user_name == "alice");
+                REQUIRE(stale.privileged.is_initialized());
+                REQUIRE_FALSE(*stale.privileged);
+                REQUIRE(stale.group_id.is_initialized());
+                REQUIRE(*stale.group_id == 100);
+                REQUIRE(stale.group_name == "staff");
+            }
+        }
+    }
+    GIVEN("a lookup that does not complete in time without a cache") {
+        auto result = test_identity_resolver::collect(chrono::milliseconds(10), cache_path, never_returns);
+        THEN("no identity should be collected") {
+            REQUIRE_FALSE(result.user_id.is_initialized());
+            REQUIRE(result.user_name.empty());
+            REQUIRE_FALSE(result.group_id.is_initialized());
+        }
+    }
+    GIVEN("a cache for a different user and group") {
+        boost::filesystem::create_directories(directory);
+        lth_file::atomic_write_to_file("user 0 root\ngroup 0 root\n", cache_path);
+        auto result = test_identity_resolver::collect(chrono::milliseconds(10), cache_path, never_returns);
+        THEN("the cached names should not be used") {
+            REQUIRE_FALSE(result.user_id.is_initialized());
+            REQUIRE_FALSE(result.group_id.is_initialized());
+        }
+    }
+    GIVEN("lookups that keep missing the deadline") {
+        auto calls = make_shared<atomic<int>>(0);
+        auto counted = test_identity_resolver::counted(blocked, calls);
+        for (int i = 0; i < 3; ++i) {
+            test_identity_resolver::collect(2000, 200, chrono::milliseconds(10), counted);
+        }
+        THEN("the blocked lookup should be waited on rather than started again") {
+            REQUIRE(*calls <= 1);
+        }
+    }
+    GIVEN("no deadline") {
+        auto result = test_identity_resolver::collect(chrono::milliseconds(0), {}, &test_identity_resolver::lookup);
+        THEN("the lookup should be done directly") {
+            REQUIRE(result.user_name == "alice");
+            REQUIRE(result.group_name == "staff");
+        }
+    }
+
+    blocked->release();
+    boost::system::error_code ec;
+    boost::filesystem::remove_all(directory, ec);
+}
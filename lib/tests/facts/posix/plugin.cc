@@ -0,0 +1,56 @@
+#include <catch.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/facts/map_value.hpp>
+#include <facter/facts/plugin.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <leatherman/util/regex.hpp>
+#include "../../fixtures.hpp"
+#include "../../log_capture.hpp"
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::logging;
+using namespace facter::testing;
+using namespace leatherman::util;
+
+SCENARIO("loading native fact plugins") {
+    collection_fixture facts;
+
+    GIVEN("a directory containing the example plugin") {
+        facts.add_plugin_facts({ LIBFACTER_TESTS_PLUGIN_DIRECTORY });
+        THEN("facts for the plugin's names are resolved") {
+            auto plugin = facts.get<map_value>("example_plugin");
+            REQUIRE(plugin);
+            auto native = plugin->get<boolean_value>("native");
+            REQUIRE(native);
+            REQUIRE(native->value());
+            auto version = plugin->get<integer_value>("api_version");
+            REQUIRE(version);
+            REQUIRE(version->value() == static_cast<int64_t>(FACTER_PLUGIN_API_VERSION));
+        }
+        THEN("facts matching the plugin's patterns are resolved") {
+            auto greeting = facts.get<string_value>("example_plugin_greeting");
+            REQUIRE(greeting);
+            REQUIRE(greeting->value() == "hello from a native plugin");
+        }
+    }
+#ifndef __APPLE__
+    // Plugins on OSX use the .dylib extension, so the fixture is only considered elsewhere
+    GIVEN("a directory containing a file that is not a plugin") {
+        log_capture capture(level::warning);
+        facts.add_plugin_facts({ LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/plugins/invalid" });
+        THEN("a warning is logged and no facts are added") {
+            REQUIRE(facts.size() == 0u);
+            auto output = capture.result();
+            CAPTURE(output);
+            REQUIRE(re_search(output, boost::regex("WARN  puppetlabs\\.facter - native fact plugin \".*not_a_plugin\\.so\" could not be loaded\\.")));
+        }
+    }
+#endif
+    GIVEN("a directory that does not exist") {
+        facts.add_plugin_facts({ LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/plugins/does_not_exist" });
+        THEN("no facts are added") {
+            REQUIRE(facts.size() == 0u);
+        }
+    }
+}
@@ -41,7 +41,12 @@ SCENARIO("parsing uptime formats") {
             {" 13:36:05 up 118 days,  1:15,  1 user,  load average: 0.00, 0.00, 0.00",        118*24*60*60 +  1*60*60 + 15*60},
             {"10:27am  up 1 day  7:26,  1 user,  load average: 0.00, 0.00, 0.00",               1*24*60*60 +  7*60*60 + 26*60},
             {"22:45pm up 0:-6, 1 user, load average: 0.00, 0.00, 0.00",                                                  6*60},
-            {"22:45pm up 1 day 0:-6, 1 user, load average: 0.00, 0.00, 0.00",                   1*24*60*60 +             6*60}
+            {"22:45pm up 1 day 0:-6, 1 user, load average: 0.00, 0.00, 0.00",                   1*24*60*60 +             6*60},
+            {"  9:01pm  up 00001:047,  0 users",                                                  1*60*60 + 47*60},
+            {"up 99999999999 days, 1 hr, 0 users",                                                          1*60*60        },
+            {"  9:01pm  up 3 days 4 hrs  0 users",                                                                      -1},
+            {"not uptime output",                                                                                       -1},
+            {"",                                                                                                        -1}
         };
         THEN("it parses each format correctly") {
             for (auto const& t : test_cases) {
@@ -0,0 +1,90 @@
+#include <catch.hpp>
+#include <facter/facts/resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <boost/regex.hpp>
+
+using namespace std;
+using namespace facter::facts;
+
+struct pattern_resolver : resolver
+{
+    explicit pattern_resolver(string const& pattern) :
+        resolver("test", {}, { pattern })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+    }
+};
+
+SCENARIO("matching fact names against resolver patterns") {
+    static const vector<string> patterns = {
+        "^ipaddress_",
+        "^processor[0-9]+$",
+        "^zone_.+_id$",
+        "^example_plugin_.*$",
+        "^a\\.b$",
+        "^\\d+$",
+        "_1$",
+        "b[0-9]*c",
+        "^a.*a.*b$",
+        "^$",
+        // These are not simple patterns and are matched with a regex
+        "^(foo|bar)_.*$",
+        "^foo.{2}$",
+        "^foo.+?bar$",
+        "\\bfoo\\b",
+        "(?i)^FOO$",
+    };
+    static const vector<string> names = {
+        "",
+        "ipaddress",
+        "ipaddress_eth0",
+        "myipaddress_eth0",
+        "processor",
+        "processor0",
+        "processor12",
+        "processor1a",
+        "processors",
+        "zone__id",
+        "zone_global_id",
+        "zone_a_b_id",
+        "zone_global_id_",
+        "example_plugin_",
+        "example_plugin_foo",
+        "a.b",
+        "axb",
+        "123",
+        "12a",
+        "foo_1",
+        "foo_12",
+        "bc",
+        "b99c",
+        "ab9c",
+        "aab",
+        "abab",
+        "abba",
+        "foo_bar",
+        "bar_foo",
+        "fooxx",
+        "fooxbar",
+        "foo bar",
+        "FOO",
+    };
+
+    for (auto const& pattern : patterns) {
+        pattern_resolver res(pattern);
+        boost::regex regex(pattern);
+        for (auto const& name : names) {
+            CAPTURE(pattern);
+            CAPTURE(name);
+            REQUIRE(res.is_match(name) == boost::regex_search(name, regex));
+        }
+    }
+}
+
+SCENARIO("constructing a resolver with an invalid pattern") {
+    REQUIRE_THROWS_AS(pattern_resolver("^foo(bar$"), invalid_name_pattern_exception);
+    REQUIRE_THROWS_AS(pattern_resolver("^foo\\"), invalid_name_pattern_exception);
+}
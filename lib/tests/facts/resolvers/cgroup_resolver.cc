@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include <internal/facts/resolvers/cgroup_resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/facts/fact.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/computed_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include "../../collection_fixture.hpp"
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::facts::resolvers;
+using namespace facter::testing;
+
+struct empty_cgroup_resolver : cgroup_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        return {};
+    }
+};
+
+struct unlimited_cgroup_resolver : cgroup_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        result.version = 2;
+        result.path = "/";
+        return result;
+    }
+};
+
+struct test_cgroup_resolver : cgroup_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        result.version = 2;
+        result.path = "/system.slice/app.service";
+        result.cpu_quota = 150000;
+        result.cpu_period = 100000;
+        result.cpuset_cpus = "0-3";
+        result.cpuset_count = 4;
+        result.memory_max = 1024 * 1024 * 1024;
+        result.memory_high = 768 * 1024 * 1024;
+        result.pids_max = 512;
+        return result;
+    }
+};
+
+SCENARIO("using the control group resolver") {
+    collection_fixture facts;
+    WHEN("data is not present") {
+        facts.add(make_shared<empty_cgroup_resolver>());
+        THEN("facts should not be added") {
+            REQUIRE(facts.size() == 0u);
+        }
+    }
+    WHEN("the control group is unlimited") {
+        facts.add(make_shared<unlimited_cgroup_resolver>());
+        THEN("only the version and path should be added") {
+            REQUIRE(facts.size() == 1u);
+            auto cgroup = facts.get<map_value>(fact::cgroup);
+            REQUIRE(cgroup);
+            REQUIRE(cgroup->size() == 2u);
+            auto version = cgroup->get<integer_value>("version");
+            REQUIRE(version);
+            REQUIRE(version->value() == 2);
+            auto path = cgroup->get<string_value>("path");
+            REQUIRE(path);
+            REQUIRE(path->value() == "/");
+        }
+    }
+    WHEN("the control group has limits") {
+        facts.add(make_shared<test_cgroup_resolver>());
+        THEN("a structured fact is added") {
+            REQUIRE(facts.size() == 1u);
+            auto cgroup = facts.get<map_value>(fact::cgroup);
+            REQUIRE(cgroup);
+            REQUIRE(cgroup->size() == 6u);
+
+            auto cpu = cgroup->get<map_value>("cpu");
+            REQUIRE(cpu);
+            auto quota = cpu->get<integer_value>("quota");
+            REQUIRE(quota);
+            REQUIRE(quota->value() == 150000);
+            auto period = cpu->get<integer_value>("period");
+            REQUIRE(period);
+            REQUIRE(period->value() == 100000);
+            auto effective = cpu->get<double_value>("effective");
+            REQUIRE(effective);
+            REQUIRE(effective->value() == Approx(1.5));
+
+            auto cpuset = cgroup->get<map_value>("cpuset");
+            REQUIRE(cpuset);
+            auto cpus = cpuset->get<string_value>("cpus");
+            REQUIRE(cpus);
+            REQUIRE(cpus->value() == "0-3");
+            auto count = cpuset->get<integer_value>("count");
+            REQUIRE(count);
+            REQUIRE(count->value() == 4);
+
+            auto memory = cgroup->get<map_value>("memory");
+            REQUIRE(memory);
+            REQUIRE(memory->size() == 4u);
+            auto max = memory->get<computed_value>("max");
+            REQUIRE(max);
+            REQUIRE(max->value() == "1.00 GiB");
+            auto max_bytes = memory->get<integer_value>("max_bytes");
+            REQUIRE(max_bytes);
+            REQUIRE(max_bytes->value() == 1073741824);
+            auto high = memory->get<computed_value>("high");
+            REQUIRE(high);
+            REQUIRE(high->value() == "768.00 MiB");
+            auto high_bytes = memory->get<integer_value>("high_bytes");
+            REQUIRE(high_bytes);
+            REQUIRE(high_bytes->value() == 805306368);
+
+            auto pids = cgroup->get<map_value>("pids");
+            REQUIRE(pids);
+            auto pids_max = pids->get<integer_value>("max");
+            REQUIRE(pids_max);
+            REQUIRE(pids_max->value() == 512);
+        }
+    }
+}
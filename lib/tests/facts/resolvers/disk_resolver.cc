@@ -3,6 +3,7 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include "../../collection_fixture.hpp"
 
@@ -24,6 +25,24 @@ struct test_disk_resolver : disk_resolver
         disks.emplace_back(move(d));
     }
 
+    void add_nvme_disk(string name)
+    {
+        disk d;
+        d.name = move(name);
+        d.size = 1024;
+        d.rotational = false;
+        d.logical_block_size = 512;
+        d.physical_block_size = 4096;
+        d.discard = true;
+        d.scheduler = "none";
+        d.nr_requests = 1023;
+        d.max_sectors_kb = 128;
+        d.nvme_namespace = 1;
+        d.nvme_transport = "pcie";
+        d.hardware_queues = 8;
+        disks.emplace_back(move(d));
+    }
+
  protected:
     virtual data collect_data(collection& facts) override
     {
@@ -71,7 +90,7 @@ SCENARIO("using the disk resolver") {
                 REQUIRE(product);
                 REQUIRE(product->value() == "product" + num);
 
-                auto size = disk->get<string_value>("size");
+                auto size = disk->get<computed_value>("size");
                 REQUIRE(size);
                 REQUIRE(size->value() == "12.06 KiB");
 
@@ -111,4 +130,26 @@ SCENARIO("using the disk resolver") {
             REQUIRE(devices->value() == names);
         }
     }
+    GIVEN("a disk with queue attributes") {
+        resolver->add_nvme_disk("nvme0n1");
+        THEN("the attributes should be added to the structured fact") {
+            auto disks = facts.get<map_value>(fact::disks);
+            REQUIRE(disks);
+            auto disk = disks->get<map_value>("nvme0n1");
+            REQUIRE(disk);
+            REQUIRE(disk->size() == 11u);
+            REQUIRE_FALSE(disk->get<boolean_value>("rotational")->value());
+            REQUIRE(disk->get<integer_value>("logical_block_size")->value() == 512);
+            REQUIRE(disk->get<integer_value>("physical_block_size")->value() == 4096);
+            REQUIRE(disk->get<boolean_value>("discard")->value());
+            REQUIRE(disk->get<string_value>("scheduler")->value() == "none");
+            REQUIRE(disk->get<integer_value>("nr_requests")->value() == 1023);
+            REQUIRE(disk->get<integer_value>("max_sectors_kb")->value() == 128);
+            REQUIRE(disk->get<integer_value>("hardware_queues")->value() == 8);
+            auto nvme = disk->get<map_value>("nvme");
+            REQUIRE(nvme);
+            REQUIRE(nvme->get<integer_value>("namespace")->value() == 1);
+            REQUIRE(nvme->get<string_value>("transport")->value() == "pcie");
+        }
+    }
 }
@@ -3,6 +3,7 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include "../../collection_fixture.hpp"
@@ -89,7 +90,7 @@ SCENARIO("using the file system resolver") {
                 REQUIRE(mountpoint);
                 REQUIRE(mountpoint->size() == 10u);
 
-                auto available = mountpoint->get<string_value>("available");
+                auto available = mountpoint->get<computed_value>("available");
                 REQUIRE(available);
                 REQUIRE(available->value() == "1000 bytes");
 
@@ -97,7 +98,7 @@ SCENARIO("using the file system resolver") {
                 REQUIRE(available_bytes);
                 REQUIRE(available_bytes->value() == 1000);
 
-                auto capacity = mountpoint->get<string_value>("capacity");
+                auto capacity = mountpoint->get<computed_value>("capacity");
                 REQUIRE(capacity);
                 REQUIRE(capacity->value() == "91.90%");
 
@@ -116,7 +117,7 @@ SCENARIO("using the file system resolver") {
                 REQUIRE(options->get<string_value>(1)->value() == "option2" + num);
                 REQUIRE(options->get<string_value>(2)->value() == "option3" + num);
 
-                auto size = mountpoint->get<string_value>("size");
+                auto size = mountpoint->get<computed_value>("size");
                 REQUIRE(size);
                 REQUIRE(size->value() == "12.06 KiB");
 
@@ -124,7 +125,7 @@ SCENARIO("using the file system resolver") {
                 REQUIRE(size_bytes);
                 REQUIRE(size_bytes->value() == 12345);
 
-                auto used = mountpoint->get<string_value>("used");
+                auto used = mountpoint->get<computed_value>("used");
                 REQUIRE(used);
                 REQUIRE(used->value() == "11.08 KiB");
 
@@ -193,7 +194,7 @@ SCENARIO("using the file system resolver") {
                 REQUIRE(size_bytes);
                 REQUIRE(size_bytes->value() == 12345 + i);
 
-                auto size = partition->get<string_value>("size");
+                auto size = partition->get<computed_value>("size");
                 REQUIRE(size);
                 REQUIRE(size->value() == "12.06 KiB");
 
@@ -3,6 +3,7 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include "../../collection_fixture.hpp"
 
@@ -35,6 +36,25 @@ struct test_memory_resolver : memory_resolver
     }
 };
 
+struct test_memory_resolver_numa : memory_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        numa_node node;
+        node.name = "node0";
+        node.mem_total = 8 * 1024 * 1024;
+        node.mem_free = 2 * 1024 * 1024;
+        result.numa_nodes.push_back(node);
+        node.name = "node1";
+        node.mem_total = 0;
+        node.mem_free = 0;
+        result.numa_nodes.push_back(node);
+        return result;
+    }
+};
+
 SCENARIO("using the memory resolver") {
     collection_fixture facts;
     WHEN("data is not present") {
@@ -52,25 +72,25 @@ SCENARIO("using the memory resolver") {
             auto info = memory->get<map_value>("swap");
             REQUIRE(info);
             REQUIRE(info->size() == 8u);
-            auto available = info->get<string_value>("available");
+            auto available = info->get<computed_value>("available");
             REQUIRE(available);
             REQUIRE(available->value() == "4.00 MiB");
             auto available_bytes = info->get<integer_value>("available_bytes");
             REQUIRE(available_bytes);
             REQUIRE(available_bytes->value() == 4194304);
-            auto capacity = info->get<string_value>("capacity");
+            auto capacity = info->get<computed_value>("capacity");
             REQUIRE(capacity);
             REQUIRE(capacity->value() == "80.00%");
             auto encrypted = info->get<boolean_value>("encrypted");
             REQUIRE(encrypted);
             REQUIRE(encrypted->value());
-            auto total = info->get<string_value>("total");
+            auto total = info->get<computed_value>("total");
             REQUIRE(total);
             REQUIRE(total->value() == "20.00 MiB");
             auto total_bytes = info->get<integer_value>("total_bytes");
             REQUIRE(total_bytes);
             REQUIRE(total_bytes->value() == 20971520);
-            auto used = info->get<string_value>("used");
+            auto used = info->get<computed_value>("used");
             REQUIRE(used);
             REQUIRE(used->value() == "16.00 MiB");
             auto used_bytes = info->get<integer_value>("used_bytes");
@@ -79,22 +99,22 @@ SCENARIO("using the memory resolver") {
             info = memory->get<map_value>("system");
             REQUIRE(info);
             REQUIRE(info->size() == 7u);
-            available = info->get<string_value>("available");
+            available = info->get<computed_value>("available");
             REQUIRE(available);
             REQUIRE(available->value() == "5.00 MiB");
             available_bytes = info->get<integer_value>("available_bytes");
             REQUIRE(available_bytes);
             REQUIRE(available_bytes->value() == 5242880);
-            capacity = info->get<string_value>("capacity");
+            capacity = info->get<computed_value>("capacity");
             REQUIRE(capacity);
             REQUIRE(capacity->value() == "50.00%");
-            total = info->get<string_value>("total");
+            total = info->get<computed_value>("total");
             REQUIRE(total);
             REQUIRE(total->value() == "10.00 MiB");
             total_bytes = info->get<integer_value>("total_bytes");
             REQUIRE(total_bytes);
             REQUIRE(total_bytes->value() == 10485760);
-            used = info->get<string_value>("used");
+            used = info->get<computed_value>("used");
             REQUIRE(used);
             REQUIRE(used->value() == "5.00 MiB");
             used_bytes = info->get<integer_value>("used_bytes");
@@ -103,13 +123,13 @@ SCENARIO("using the memory resolver") {
         }
         THEN("flat facts are added") {
             REQUIRE(facts.size() == 10u);
-            auto memoryfree = facts.get<string_value>(fact::memoryfree);
+            auto memoryfree = facts.get<computed_value>(fact::memoryfree);
             REQUIRE(memoryfree);
             REQUIRE(memoryfree->value() == "5.00 MiB");
             auto memoryfree_mb = facts.get<double_value>(fact::memoryfree_mb);
             REQUIRE(memoryfree_mb);
             REQUIRE(memoryfree_mb->value() == Approx(5.0));
-            auto memorysize = facts.get<string_value>(fact::memorysize);
+            auto memorysize = facts.get<computed_value>(fact::memorysize);
             REQUIRE(memorysize);
             REQUIRE(memorysize->value() == "10.00 MiB");
             auto memorysize_mb = facts.get<double_value>(fact::memorysize_mb);
@@ -118,13 +138,13 @@ SCENARIO("using the memory resolver") {
             auto swapencrypted = facts.get<boolean_value>(fact::swapencrypted);
             REQUIRE(swapencrypted);
             REQUIRE(swapencrypted->value());
-            auto swapfree = facts.get<string_value>(fact::swapfree);
+            auto swapfree = facts.get<computed_value>(fact::swapfree);
             REQUIRE(swapfree);
             REQUIRE(swapfree->value() == "4.00 MiB");
             auto swapfree_mb = facts.get<double_value>(fact::swapfree_mb);
             REQUIRE(swapfree_mb);
             REQUIRE(swapfree_mb->value() == Approx(4.0));
-            auto swapsize = facts.get<string_value>(fact::swapsize);
+            auto swapsize = facts.get<computed_value>(fact::swapsize);
             REQUIRE(swapsize);
             REQUIRE(swapsize->value() == "20.00 MiB");
             auto swapsize_mb = facts.get<double_value>(fact::swapsize_mb);
@@ -132,4 +152,21 @@ SCENARIO("using the memory resolver") {
             REQUIRE(swapsize_mb->value() == Approx(20.0));
         }
     }
+    WHEN("NUMA node data is present") {
+        facts.add(make_shared<test_memory_resolver_numa>());
+        THEN("nodes with memory are added to the structured fact") {
+            auto memory = facts.get<map_value>(fact::memory);
+            REQUIRE(memory);
+            auto numa = memory->get<map_value>("numa");
+            REQUIRE(numa);
+            REQUIRE(numa->size() == 1u);
+            auto node = numa->get<map_value>("node0");
+            REQUIRE(node);
+            REQUIRE(node->size() == 7u);
+            REQUIRE(node->get<computed_value>("total")->value() == "8.00 MiB");
+            REQUIRE(node->get<integer_value>("used_bytes")->value() == 6 * 1024 * 1024);
+            REQUIRE(node->get<computed_value>("available")->value() == "2.00 MiB");
+            REQUIRE(node->get<computed_value>("capacity")->value() == "75.00%");
+        }
+    }
 }
@@ -132,6 +132,40 @@ struct primary_interface_resolver : networking_resolver
     }
 };
 
+struct device_interface_resolver : networking_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+
+        interface eth0;
+        eth0.name = "eth0";
+        eth0.driver = "ixgbe";
+        eth0.driver_version = "5.1.0-k";
+        eth0.firmware_version = "0x800003e7";
+        eth0.speed = 10000;
+        eth0.duplex = "full";
+        eth0.combined_queues = 16;
+        eth0.rx_queues = 0;
+        eth0.tx_queues = 0;
+        eth0.rx_ring = 512;
+        eth0.rx_ring_max = 4096;
+        eth0.tx_ring = 512;
+        eth0.tx_ring_max = 4096;
+        eth0.tso = true;
+        eth0.gro = true;
+        eth0.lro = false;
+        result.interfaces.emplace_back(move(eth0));
+
+        interface veth0;
+        veth0.name = "veth0";
+        result.interfaces.emplace_back(move(veth0));
+
+        return result;
+    }
+};
+
 SCENARIO("using the networking resolver") {
     collection_fixture facts;
     WHEN("data is not present") {
@@ -440,6 +474,44 @@ SCENARIO("using the networking resolver") {
             }
         }
     }
+    WHEN("device attributes are present") {
+        facts.add(make_shared<device_interface_resolver>());
+        auto networking = facts.get<map_value>(fact::networking);
+        REQUIRE(networking);
+        auto interfaces = networking->get<map_value>("interfaces");
+        REQUIRE(interfaces);
+        THEN("they are added to the interface") {
+            auto eth0 = interfaces->get<map_value>("eth0");
+            REQUIRE(eth0);
+            REQUIRE(eth0->get<string_value>("driver")->value() == "ixgbe");
+            REQUIRE(eth0->get<string_value>("driver_version")->value() == "5.1.0-k");
+            REQUIRE(eth0->get<string_value>("firmware_version")->value() == "0x800003e7");
+            REQUIRE(eth0->get<integer_value>("speed")->value() == 10000);
+            REQUIRE(eth0->get<string_value>("duplex")->value() == "full");
+            auto queues = eth0->get<map_value>("queues");
+            REQUIRE(queues);
+            REQUIRE(queues->size() == 3u);
+            REQUIRE(queues->get<integer_value>("combined")->value() == 16);
+            REQUIRE(queues->get<integer_value>("rx")->value() == 0);
+            auto rings = eth0->get<map_value>("rings");
+            REQUIRE(rings);
+            REQUIRE(rings->size() == 4u);
+            REQUIRE(rings->get<integer_value>("rx")->value() == 512);
+            REQUIRE(rings->get<integer_value>("tx_max")->value() == 4096);
+            auto offloads = eth0->get<map_value>("offloads");
+            REQUIRE(offloads);
+            REQUIRE(offloads->get<boolean_value>("tso")->value());
+            REQUIRE(offloads->get<boolean_value>("gro")->value());
+            REQUIRE_FALSE(offloads->get<boolean_value>("lro")->value());
+        }
+        THEN("interfaces without a device have no device attributes") {
+            auto veth0 = interfaces->get<map_value>("veth0");
+            REQUIRE(veth0);
+            REQUIRE_FALSE(veth0->get<string_value>("driver"));
+            REQUIRE_FALSE(veth0->get<map_value>("queues"));
+            REQUIRE_FALSE(veth0->get<map_value>("offloads"));
+        }
+    }
     WHEN("the primary interface is not resolved") {
         facts.add(make_shared<primary_interface_resolver>());
         THEN("the first interface with a valid address should be treated as primary") {
@@ -505,3 +577,44 @@ SCENARIO("ignore IPv6 adddresses") {
         REQUIRE_FALSE(networking_resolver::ignored_ipv6_address(s));
     }
 }
+
+SCENARIO("filtering interfaces") {
+    vector<string> none;
+    GIVEN("no filters") {
+        THEN("all interfaces should be included") {
+            REQUIRE(networking_resolver::include_interface("eth0", none, none));
+            REQUIRE(networking_resolver::include_interface("veth1234", none, none));
+        }
+    }
+    GIVEN("exclude patterns") {
+        vector<string> exclude = { "veth*", "cali*", "tap?" };
+        THEN("matching interfaces should be excluded") {
+            REQUIRE_FALSE(networking_resolver::include_interface("veth1234", none, exclude));
+            REQUIRE_FALSE(networking_resolver::include_interface("cali0a1b", none, exclude));
+            REQUIRE_FALSE(networking_resolver::include_interface("tap0", none, exclude));
+        }
+        THEN("other interfaces should be included") {
+            REQUIRE(networking_resolver::include_interface("eth0", none, exclude));
+            REQUIRE(networking_resolver::include_interface("tap10", none, exclude));
+            REQUIRE(networking_resolver::include_interface("myveth0", none, exclude));
+        }
+    }
+    GIVEN("include patterns") {
+        vector<string> include = { "eth*", "bond0" };
+        THEN("only matching interfaces should be included") {
+            REQUIRE(networking_resolver::include_interface("eth0", include, none));
+            REQUIRE(networking_resolver::include_interface("bond0", include, none));
+            REQUIRE_FALSE(networking_resolver::include_interface("bond1", include, none));
+            REQUIRE_FALSE(networking_resolver::include_interface("lo", include, none));
+        }
+    }
+    GIVEN("include and exclude patterns") {
+        vector<string> include = { "eth*" };
+        vector<string> exclude = { "eth1*" };
+        THEN("the exclude patterns should take precedence") {
+            REQUIRE(networking_resolver::include_interface("eth0", include, exclude));
+            REQUIRE_FALSE(networking_resolver::include_interface("eth10", include, exclude));
+            REQUIRE_FALSE(networking_resolver::include_interface("lo", include, exclude));
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <facter/facts/collection.hpp>
 #include <facter/facts/fact.hpp>
 #include <facter/facts/scalar_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/array_value.hpp>
 #include "../../collection_fixture.hpp"
@@ -60,6 +61,38 @@ struct test_processor_resolver_no_physical_count : processor_resolver
     }
 };
 
+struct test_processor_resolver_topology : processor_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        result.logical_count = 4;
+        cache l1;
+        l1.level = 1;
+        l1.type = "Data";
+        l1.size = 32 * 1024;
+        l1.shared_cpus = 2;
+        l1.count = 2;
+        result.caches.push_back(l1);
+        cache l3;
+        l3.level = 3;
+        l3.type = "Unified";
+        l3.size = 16 * 1024 * 1024;
+        l3.shared_cpus = 4;
+        l3.count = 1;
+        result.caches.push_back(l3);
+        result.isa_features = { "avx", "sse2" };
+        result.vector_extensions = { { "avx", true }, { "avx512", false } };
+        numa_node node;
+        node.name = "node0";
+        node.cpus = "0-3";
+        node.cpu_count = 4;
+        result.numa_nodes.push_back(node);
+        return result;
+    }
+};
+
 SCENARIO("using the processor resolver") {
     collection_fixture facts;
     WHEN("data is not present") {
@@ -92,7 +125,7 @@ SCENARIO("using the processor resolver") {
                 REQUIRE(model);
                 REQUIRE(model->value() == "processor" + to_string(i + 1));
             }
-            auto speed = processors->get<string_value>("speed");
+            auto speed = processors->get<computed_value>("speed");
             REQUIRE(speed);
             REQUIRE(speed->value() == "10.00 GHz");
         }
@@ -135,7 +168,7 @@ SCENARIO("using the processor resolver") {
                 REQUIRE(model);
                 REQUIRE(model->value() == "processor" + to_string(i + 1));
             }
-            auto speed = processors->get<string_value>("speed");
+            auto speed = processors->get<computed_value>("speed");
             REQUIRE(speed);
             REQUIRE(speed->value() == "10.00 GHz");
         }
@@ -154,4 +187,50 @@ SCENARIO("using the processor resolver") {
             }
         }
     }
+    WHEN("feature and topology data is present") {
+        facts.add(make_shared<test_processor_resolver_topology>());
+        THEN("the instruction set features are added to the structured fact") {
+            auto processors = facts.get<map_value>(fact::processors);
+            REQUIRE(processors);
+            auto features = processors->get<array_value>("isa_features");
+            REQUIRE(features);
+            REQUIRE(features->size() == 2u);
+            REQUIRE(features->get<string_value>(0)->value() == "avx");
+            REQUIRE(features->get<string_value>(1)->value() == "sse2");
+            auto extensions = processors->get<map_value>("vector_extensions");
+            REQUIRE(extensions);
+            REQUIRE(extensions->size() == 2u);
+            REQUIRE(extensions->get<boolean_value>("avx")->value());
+            REQUIRE_FALSE(extensions->get<boolean_value>("avx512")->value());
+        }
+        THEN("the topology is added to the structured fact") {
+            auto processors = facts.get<map_value>(fact::processors);
+            REQUIRE(processors);
+            auto topology = processors->get<map_value>("topology");
+            REQUIRE(topology);
+            auto caches = topology->get<array_value>("caches");
+            REQUIRE(caches);
+            REQUIRE(caches->size() == 2u);
+            auto l1 = caches->get<map_value>(0);
+            REQUIRE(l1);
+            REQUIRE(l1->get<integer_value>("level")->value() == 1);
+            REQUIRE(l1->get<string_value>("type")->value() == "Data");
+            REQUIRE(l1->get<computed_value>("size")->value() == "32.00 KiB");
+            REQUIRE(l1->get<integer_value>("size_bytes")->value() == 32768);
+            REQUIRE(l1->get<integer_value>("shared_cpus")->value() == 2);
+            REQUIRE(l1->get<integer_value>("count")->value() == 2);
+            auto l3 = caches->get<map_value>(1);
+            REQUIRE(l3);
+            REQUIRE(l3->get<integer_value>("level")->value() == 3);
+            REQUIRE(l3->get<computed_value>("size")->value() == "16.00 MiB");
+            REQUIRE(l3->get<integer_value>("count")->value() == 1);
+            auto nodes = topology->get<map_value>("numa_nodes");
+            REQUIRE(nodes);
+            REQUIRE(nodes->size() == 1u);
+            auto node = nodes->get<map_value>("node0");
+            REQUIRE(node);
+            REQUIRE(node->get<string_value>("cpus")->value() == "0-3");
+            REQUIRE(node->get<integer_value>("count")->value() == 4);
+        }
+    }
 }
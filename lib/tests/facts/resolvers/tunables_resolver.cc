@@ -0,0 +1,88 @@
+#include <catch.hpp>
+#include <internal/facts/resolvers/tunables_resolver.hpp>
+#include <facter/facts/collection.hpp>
+#include <facter/facts/fact.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/array_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include "../../collection_fixture.hpp"
+
+using namespace std;
+using namespace facter::facts;
+using namespace facter::facts::resolvers;
+using namespace facter::testing;
+
+struct empty_tunables_resolver : tunables_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        return {};
+    }
+};
+
+struct test_tunables_resolver : tunables_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        result.values["vm.swappiness"] = "60";
+        result.values["kernel.shmmax"] = "18446744073709551615";
+        result.values["net.ipv4.tcp_rmem"] = "4096\t131072\t6291456";
+        result.values["/sys/kernel/mm/transparent_hugepage/enabled"] = "always [madvise] never";
+        result.values["/sys/devices/system/cpu/cpufreq/policy0/scaling_governor"] = "performance";
+        result.values["kernel.core_pattern"] = "|/usr/lib/systemd/systemd-coredump %P";
+        result.values["kernel.hostname"] = "";
+        return result;
+    }
+};
+
+SCENARIO("using the tunables resolver") {
+    collection_fixture facts;
+    WHEN("data is not present") {
+        facts.add(make_shared<empty_tunables_resolver>());
+        THEN("facts should not be added") {
+            REQUIRE(facts.size() == 0u);
+        }
+    }
+    WHEN("data is present") {
+        facts.add(make_shared<test_tunables_resolver>());
+        THEN("a structured fact with typed values is added") {
+            REQUIRE(facts.size() == 1u);
+            auto tunables = facts.get<map_value>(fact::tunables);
+            REQUIRE(tunables);
+            REQUIRE(tunables->size() == 7u);
+
+            auto swappiness = tunables->get<integer_value>("vm.swappiness");
+            REQUIRE(swappiness);
+            REQUIRE(swappiness->value() == 60);
+
+            auto shmmax = tunables->get<string_value>("kernel.shmmax");
+            REQUIRE(shmmax);
+            REQUIRE(shmmax->value() == "18446744073709551615");
+
+            auto rmem = tunables->get<array_value>("net.ipv4.tcp_rmem");
+            REQUIRE(rmem);
+            REQUIRE(rmem->size() == 3u);
+            REQUIRE(rmem->get<integer_value>(0)->value() == 4096);
+            REQUIRE(rmem->get<integer_value>(2)->value() == 6291456);
+
+            auto thp = tunables->get<string_value>("/sys/kernel/mm/transparent_hugepage/enabled");
+            REQUIRE(thp);
+            REQUIRE(thp->value() == "madvise");
+
+            auto governor = tunables->get<string_value>("/sys/devices/system/cpu/cpufreq/policy0/scaling_governor");
+            REQUIRE(governor);
+            REQUIRE(governor->value() == "performance");
+
+            auto core_pattern = tunables->get<string_value>("kernel.core_pattern");
+            REQUIRE(core_pattern);
+            REQUIRE(core_pattern->value() == "|/usr/lib/systemd/systemd-coredump %P");
+
+            auto hostname = tunables->get<string_value>("kernel.hostname");
+            REQUIRE(hostname);
+            REQUIRE(hostname->value().empty());
+        }
+    }
+}
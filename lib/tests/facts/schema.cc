@@ -6,6 +6,7 @@
 #include <facter/facts/array_value.hpp>
 #include <facter/facts/map_value.hpp>
 #include <facter/facts/scalar_value.hpp>
+#include <facter/facts/computed_value.hpp>
 #include <leatherman/util/regex.hpp>
 #include <yaml-cpp/yaml.h>
 #include <boost/nowide/fstream.hpp>
@@ -13,6 +14,7 @@
 
 // Include all base resolvers here
 #include <internal/facts/resolvers/augeas_resolver.hpp>
+#include <internal/facts/resolvers/cgroup_resolver.hpp>
 #include <internal/facts/resolvers/disk_resolver.hpp>
 #include <internal/facts/resolvers/dmi_resolver.hpp>
 #include <internal/facts/resolvers/ec2_resolver.hpp>
@@ -31,6 +33,7 @@
 #include <internal/facts/resolvers/ssh_resolver.hpp>
 #include <internal/facts/resolvers/system_profiler_resolver.hpp>
 #include <internal/facts/resolvers/timezone_resolver.hpp>
+#include <internal/facts/resolvers/tunables_resolver.hpp>
 #include <internal/facts/resolvers/uptime_resolver.hpp>
 #include <internal/facts/resolvers/virtualization_resolver.hpp>
 #include <internal/facts/resolvers/xen_resolver.hpp>
@@ -56,19 +59,48 @@ struct augeas_resolver : resolvers::augeas_resolver
     }
 };
 
+struct cgroup_resolver : resolvers::cgroup_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        result.version = 2;
+        result.path = "/system.slice/app.service";
+        result.cpu_quota = 150000;
+        result.cpu_period = 100000;
+        result.cpuset_cpus = "0-3";
+        result.cpuset_count = 4;
+        result.memory_max = 1024 * 1024 * 1024;
+        result.memory_high = 768 * 1024 * 1024;
+        result.pids_max = 512;
+        return result;
+    }
+};
+
 struct disk_resolver : resolvers::disk_resolver
 {
  protected:
     virtual data collect_data(collection& facts) override
     {
         data result;
-        result.disks.push_back({
-            "name",
-            "vendor",
-            "model",
-            "product",
-            1234
-        });
+        disk d;
+        d.name = "name";
+        d.vendor = "vendor";
+        d.model = "model";
+        d.product = "product";
+        d.size = 1234;
+        d.rotational = false;
+        d.logical_block_size = 512;
+        d.physical_block_size = 4096;
+        d.discard = true;
+        d.scheduler = "none";
+        d.nr_requests = 1023;
+        d.max_sectors_kb = 128;
+        d.nvme_namespace = 1;
+        d.nvme_transport = "pcie";
+        d.hardware_queues = 4;
+        result.disks.emplace_back(move(d));
         return result;
     }
 };
@@ -177,6 +209,11 @@ struct memory_resolver : resolvers::memory_resolver
         result.mem_free = 5 * 1024 * 1024;
         result.swap_total = 20 * 1024 * 1024;
         result.swap_free = 4 * 1024 * 1024;
+        numa_node node;
+        node.name = "node0";
+        node.mem_total = 8 * 1024 * 1024;
+        node.mem_free = 2 * 1024 * 1024;
+        result.numa_nodes.push_back(node);
         return result;
     }
 };
@@ -202,6 +239,21 @@ struct networking_resolver : resolvers::networking_resolver
         iface.ipv6_bindings.emplace_back(binding { "fe80::2", "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", "::2"});
         iface.macaddress = "00:00:00:00:00:00";
         iface.mtu = 12345;
+        iface.driver = "driver";
+        iface.driver_version = "1.0";
+        iface.firmware_version = "2.0";
+        iface.speed = 10000;
+        iface.duplex = "full";
+        iface.rx_queues = 4;
+        iface.tx_queues = 4;
+        iface.combined_queues = 8;
+        iface.rx_ring = 512;
+        iface.rx_ring_max = 4096;
+        iface.tx_ring = 512;
+        iface.tx_ring_max = 4096;
+        iface.tso = true;
+        iface.gro = true;
+        iface.lro = false;
         result.interfaces.emplace_back(move(iface));
         return result;
     }
@@ -256,6 +308,20 @@ protected:
                 "processor4"
         };
         result.speed = 10 * 1000 * 1000 * 1000ull;
+        result.isa_features = { "avx", "sse2" };
+        result.vector_extensions = { { "avx", true }, { "avx512", false } };
+        cache c;
+        c.level = 1;
+        c.type = "Data";
+        c.size = 32 * 1024;
+        c.shared_cpus = 2;
+        c.count = 2;
+        result.caches.push_back(c);
+        numa_node node;
+        node.name = "node0";
+        node.cpus = "0-3";
+        node.cpu_count = 4;
+        result.numa_nodes.push_back(node);
         return result;
     }
 };
@@ -335,6 +401,18 @@ protected:
     }
 };
 
+struct tunables_resolver : resolvers::tunables_resolver
+{
+ protected:
+    virtual data collect_data(collection& facts) override
+    {
+        data result;
+        result.values["vm.swappiness"] = "60";
+        result.values["/sys/kernel/mm/transparent_hugepage/enabled"] = "always [madvise] never";
+        return result;
+    }
+};
+
 struct uptime_resolver : resolvers::uptime_resolver
 {
 protected:
@@ -430,6 +508,7 @@ void add_all_facts(collection& facts)
     facts.add("facterversion", make_value<string_value>("version"));
     facts.add("aio_agent_version", make_value<string_value>(""));
     facts.add(make_shared<augeas_resolver>());
+    facts.add(make_shared<cgroup_resolver>());
     facts.add(make_shared<disk_resolver>());
     facts.add(make_shared<dmi_resolver>());
     facts.add(make_shared<filesystem_resolver>());
@@ -452,6 +531,7 @@ void add_all_facts(collection& facts)
     facts.add(make_shared<ssh_resolver>());
     facts.add(make_shared<system_profiler_resolver>());
     facts.add(make_shared<timezone_resolver>());
+    facts.add(make_shared<tunables_resolver>());
     facts.add(make_shared<uptime_resolver>());
     facts.add(make_shared<virtualization_resolver>());
     facts.add(make_shared<xen_resolver>());
@@ -601,6 +681,8 @@ void validate_fact(YAML::Node const& node, value const* fact_value, bool require
         type = "integer";
     } else if (dynamic_cast<double_value const*>(fact_value)) {
         type = "double";
+    } else if (dynamic_cast<computed_value const*>(fact_value)) {
+        type = "string";
     } else if ((svalue = dynamic_cast<string_value const*>(fact_value))) {
         type = "string";
 
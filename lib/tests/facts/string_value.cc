@@ -267,4 +267,17 @@ SCENARIO("using a string fact value") {
             }
         }
     }
+    GIVEN("a string value too long to store within the string") {
+        string_value value(string(1000, 'x'));
+        WHEN("measured") {
+            THEN("it should count the string data") {
+                memory_usage usage;
+                value.measure(usage);
+                REQUIRE(usage.nodes == 1u);
+                REQUIRE(usage.node_bytes == sizeof(string_value));
+                REQUIRE(usage.string_bytes >= 1001u);
+                REQUIRE(usage.container_bytes == 0u);
+            }
+        }
+    }
 }
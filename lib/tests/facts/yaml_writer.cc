@@ -0,0 +1,371 @@
+#include <catch.hpp>
+#include <facter/facts/yaml_writer.hpp>
+#include <facter/facts/array_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <yaml-cpp/yaml.h>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+using namespace facter::facts;
+
+static string write_string(string const& value, bool quoted = false)
+{
+    ostringstream stream;
+    {
+        yaml_writer writer(stream);
+        writer.write(value, quoted);
+    }
+    return stream.str();
+}
+
+static string write_double(double value)
+{
+    ostringstream stream;
+    {
+        yaml_writer writer(stream);
+        writer.write(value);
+    }
+    return stream.str();
+}
+
+template <typename T>
+static string write_value(T const& value)
+{
+    ostringstream stream;
+    {
+        yaml_writer writer(stream);
+        value.write(writer);
+    }
+    return stream.str();
+}
+
+template <typename T>
+static string emit_value(T const& value)
+{
+    YAML::Emitter emitter;
+    value.write(emitter);
+    return emitter.c_str();
+}
+
+SCENARIO("writing scalars with the YAML writer") {
+    GIVEN("strings that can be written plainly") {
+        THEN("they should not be quoted") {
+            REQUIRE(write_string("foobar") == "foobar");
+            REQUIRE(write_string("hello world") == "hello world");
+            REQUIRE(write_string("-a") == "-a");
+            REQUIRE(write_string("a:b") == "a:b");
+            REQUIRE(write_string("a#b") == "a#b");
+            REQUIRE(write_string("C:\\Windows") == "C:\\Windows");
+            REQUIRE(write_string("\xE2\x82\xAC") == "\xE2\x82\xAC");
+        }
+    }
+    GIVEN("strings that cannot be written plainly") {
+        THEN("they should be double-quoted") {
+            REQUIRE(write_string("") == "\"\"");
+            REQUIRE(write_string("~") == "\"~\"");
+            REQUIRE(write_string("null") == "\"null\"");
+            REQUIRE(write_string("NULL") == "\"NULL\"");
+            REQUIRE(write_string(" leading") == "\" leading\"");
+            REQUIRE(write_string("trailing ") == "\"trailing \"");
+            REQUIRE(write_string("- a") == "\"- a\"");
+            REQUIRE(write_string("-") == "\"-\"");
+            REQUIRE(write_string("?") == "\"?\"");
+            REQUIRE(write_string("a: b") == "\"a: b\"");
+            REQUIRE(write_string("a:") == "\"a:\"");
+            REQUIRE(write_string("a #b") == "\"a #b\"");
+            REQUIRE(write_string("*alias") == "\"*alias\"");
+            REQUIRE(write_string("[1]") == "\"[1]\"");
+            REQUIRE(write_string("'single'") == "\"'single'\"");
+        }
+    }
+    GIVEN("strings with characters that must be escaped") {
+        THEN("they should be escaped") {
+            REQUIRE(write_string("\"hi\"") == "\"\\\"hi\\\"\"");
+            REQUIRE(write_string("a\\b", true) == "\"a\\\\b\"");
+            REQUIRE(write_string("one\ntwo") == "\"one\\ntwo\"");
+            REQUIRE(write_string("one\r\ntwo") == "\"one\\r\\ntwo\"");
+            REQUIRE(write_string("tab\there") == "\"tab\\there\"");
+            REQUIRE(write_string("\b\f") == "\"\\b\\f\"");
+            REQUIRE(write_string(string("\0\x01\x1f", 3)) == "\"\\x00\\x01\\x1f\"");
+            REQUIRE(write_string("\xC2\x85", true) == "\"\\x85\"");
+            REQUIRE(write_string("nb\xC2\xA0sp", true) == "\"nb\\xa0sp\"");
+            REQUIRE(write_string("\xEF\xBB\xBF" "bom") == "\"\\ufeffbom\"");
+        }
+    }
+    GIVEN("strings with invalid UTF-8") {
+        THEN("the invalid sequences should be replaced") {
+            REQUIRE(write_string("\xFF", true) == "\"\xEF\xBF\xBD\"");
+            REQUIRE(write_string("\xE2\x82", true) == "\"\xEF\xBF\xBD\"");
+            REQUIRE(write_string("\xE2\x82z", true) == "\"\xEF\xBF\xBDz\"");
+            REQUIRE(write_string("\xED\xA0\x80", true) == "\"\xEF\xBF\xBD\"");
+        }
+    }
+    GIVEN("a string that is forced to be quoted") {
+        THEN("it should be double-quoted") {
+            REQUIRE(write_string("true", true) == "\"true\"");
+        }
+    }
+    GIVEN("integers") {
+        THEN("they should be written in decimal") {
+            ostringstream stream;
+            {
+                yaml_writer writer(stream);
+                writer.begin_sequence();
+                writer.write(static_cast<int64_t>(42));
+                writer.write(static_cast<int64_t>(-1));
+                writer.write(numeric_limits<int64_t>::min());
+                writer.end_sequence();
+            }
+            REQUIRE(stream.str() == "- 42\n- -1\n- -9223372036854775808");
+        }
+    }
+    GIVEN("booleans and null") {
+        THEN("they should be written as keywords") {
+            ostringstream stream;
+            {
+                yaml_writer writer(stream);
+                writer.begin_sequence();
+                writer.write(true);
+                writer.write(false);
+                writer.write_null();
+                writer.end_sequence();
+            }
+            REQUIRE(stream.str() == "- true\n- false\n- ~");
+        }
+    }
+    GIVEN("doubles") {
+        THEN("they should be written with the precision of yaml-cpp's emitter") {
+            for (double value : { 42.4242, 0.05, 3.0, 1e20, -1e-7, 1.0 / 3.0 }) {
+                YAML::Emitter emitter;
+                emitter << value;
+                REQUIRE(write_double(value) == emitter.c_str());
+            }
+        }
+        THEN("special values should be written as YAML keywords") {
+            REQUIRE(write_double(numeric_limits<double>::quiet_NaN()) == ".nan");
+            REQUIRE(write_double(numeric_limits<double>::infinity()) == ".inf");
+            REQUIRE(write_double(-numeric_limits<double>::infinity()) == "-.inf");
+        }
+    }
+}
+
+SCENARIO("writing collections with the YAML writer") {
+    ostringstream stream;
+    GIVEN("an empty map") {
+        {
+            yaml_writer writer(stream);
+            writer.begin_map();
+            writer.end_map();
+        }
+        THEN("it should be written in flow style") {
+            REQUIRE(stream.str() == "{}");
+        }
+    }
+    GIVEN("an empty sequence") {
+        {
+            yaml_writer writer(stream);
+            writer.begin_sequence();
+            writer.end_sequence();
+        }
+        THEN("it should be written in flow style") {
+            REQUIRE(stream.str() == "[]");
+        }
+    }
+    GIVEN("nested maps and sequences") {
+        {
+            yaml_writer writer(stream);
+            writer.begin_map();
+            writer.key("map");
+            writer.begin_map();
+            writer.key("empty");
+            writer.begin_map();
+            writer.end_map();
+            writer.key("nested");
+            writer.begin_map();
+            writer.key("value");
+            writer.write("foo");
+            writer.end_map();
+            writer.end_map();
+            writer.key("sequence");
+            writer.begin_sequence();
+            writer.write("one");
+            writer.begin_sequence();
+            writer.write("two");
+            writer.end_sequence();
+            writer.begin_map();
+            writer.key("three");
+            writer.write(static_cast<int64_t>(3));
+            writer.key("four");
+            writer.write(static_cast<int64_t>(4));
+            writer.end_map();
+            writer.begin_map();
+            writer.end_map();
+            writer.begin_sequence();
+            writer.end_sequence();
+            writer.end_sequence();
+            writer.key("quoted: key", true);
+            writer.write("value");
+            writer.end_map();
+        }
+        THEN("they should be written in block style") {
+            REQUIRE(stream.str() ==
+                "map:\n"
+                "  empty:\n"
+                "    {}\n"
+                "  nested:\n"
+                "    value: foo\n"
+                "sequence:\n"
+                "  - one\n"
+                "  -\n"
+                "    - two\n"
+                "  - three: 3\n"
+                "    four: 4\n"
+                "  - {}\n"
+                "  -\n"
+                "    []\n"
+                "\"quoted: key\": value");
+        }
+    }
+    GIVEN("a key longer than 1024 characters") {
+        string key(1025, 'k');
+        {
+            yaml_writer writer(stream);
+            writer.begin_map();
+            writer.key(key);
+            writer.write("value");
+            writer.key("short");
+            writer.begin_sequence();
+            writer.write(key);
+            writer.end_sequence();
+            writer.end_map();
+        }
+        THEN("it should be written as an explicit key") {
+            REQUIRE(stream.str() == "? " + key + "\n: value\nshort:\n  - " + key);
+        }
+    }
+}
+
+SCENARIO("buffering output with the YAML writer") {
+    ostringstream stream;
+    GIVEN("output smaller than the buffer") {
+        yaml_writer writer(stream);
+        writer.write("foo");
+        THEN("it should not be written until flushed") {
+            REQUIRE(stream.str().empty());
+            writer.flush();
+            REQUIRE(stream.str() == "foo");
+        }
+    }
+    GIVEN("output larger than the buffer") {
+        string element(1000, 'x');
+        {
+            yaml_writer writer(stream);
+            writer.begin_sequence();
+            for (size_t i = 0; i < 200; ++i) {
+                writer.write(element);
+            }
+            writer.end_sequence();
+            THEN("it should be written as the buffer fills") {
+                REQUIRE_FALSE(stream.str().empty());
+            }
+        }
+        THEN("all of it should be written when the writer is destroyed") {
+            REQUIRE(stream.str().size() == 200 * (element.size() + 3) - 1);
+        }
+    }
+}
+
+SCENARIO("writing fact values with the YAML writer") {
+    map_value value;
+    value.add("string", make_value<string_value>("hello"));
+    value.add("quoted", make_value<string_value>("fe80::"));
+    value.add("boolean", make_value<string_value>("true"));
+    value.add("integer", make_value<integer_value>(5));
+    value.add("true", make_value<boolean_value>(true));
+    value.add("empty", make_value<map_value>());
+    auto array = make_value<array_value>();
+    array->add(make_value<string_value>("1"));
+    array->add(make_value<integer_value>(2));
+    auto nested = make_value<array_value>();
+    nested->add(make_value<string_value>("element"));
+    array->add(move(nested));
+    array->add(make_value<array_value>());
+    value.add("array", move(array));
+    auto map = make_value<map_value>();
+    map->add("foo", make_value<string_value>("bar"));
+    map->add("1.0", make_value<string_value>(""));
+    value.add("map", move(map));
+
+    THEN("the output should match the output of yaml-cpp's emitter") {
+        REQUIRE(write_value(value) == emit_value(value));
+        REQUIRE(write_value(value) ==
+            "array:\n"
+            "  - \"1\"\n"
+            "  - 2\n"
+            "  -\n"
+            "    - element\n"
+            "  -\n"
+            "    []\n"
+            "boolean: \"true\"\n"
+            "empty:\n"
+            "  {}\n"
+            "integer: 5\n"
+            "map:\n"
+            "  \"1.0\": \"\"\n"
+            "  foo: bar\n"
+            "quoted: \"fe80::\"\n"
+            "string: hello\n"
+            "\"true\": true");
+    }
+    THEN("scalar values should match the output of yaml-cpp's emitter") {
+        REQUIRE(write_value(string_value("00:50:56:55:42:45")) == emit_value(string_value("00:50:56:55:42:45")));
+        REQUIRE(write_value(string_value("1,2,3")) == emit_value(string_value("1,2,3")));
+        REQUIRE(write_value(integer_value(4611686018427387904)) == emit_value(integer_value(4611686018427387904)));
+        REQUIRE(write_value(boolean_value(false)) == emit_value(boolean_value(false)));
+        REQUIRE(write_value(double_value(42.4242)) == emit_value(double_value(42.4242)));
+    }
+}
+
+// A value that can only write itself with yaml-cpp's emitter
+struct emitted_value : value
+{
+    virtual void to_json(json_allocator& allocator, json_value& value) const override
+    {
+    }
+
+    virtual ostream& write(ostream& os, bool quoted = true, unsigned int level = 1) const override
+    {
+        return os;
+    }
+
+    virtual YAML::Emitter& write(YAML::Emitter& emitter) const override
+    {
+        emitter << YAML::BeginMap;
+        emitter << YAML::Key << "name" << YAML::Value << "emitted";
+        emitter << YAML::Key << "items" << YAML::Value << YAML::BeginSeq << 1 << "two" << YAML::EndSeq;
+        emitter << YAML::Key << "empty" << YAML::Value << YAML::BeginSeq << YAML::EndSeq;
+        emitter << YAML::EndMap;
+        return emitter;
+    }
+
+    virtual void measure(memory_usage& usage) const override
+    {
+    }
+
+    using value::write;
+};
+
+SCENARIO("writing values that do not support the YAML writer") {
+    map_value value;
+    value.add("direct", make_value<emitted_value>());
+    auto array = make_value<array_value>();
+    array->add(make_value<emitted_value>());
+    array->add(make_value<string_value>("after"));
+    value.add("nested", move(array));
+    THEN("the output should match the output of yaml-cpp's emitter") {
+        REQUIRE(write_value(value) == emit_value(value));
+        REQUIRE(write_value(emitted_value()) == emit_value(emitted_value()));
+    }
+}
@@ -0,0 +1,82 @@
+#include "fault_injection.hpp"
+#include <thread>
+
+using namespace std;
+using namespace facter::util;
+
+namespace facter { namespace testing {
+
+    fault_injection::fault_injection()
+    {
+        host::inject_faults([this](host::access kind, string const& target) {
+            return inject(kind, target);
+        });
+    }
+
+    fault_injection::~fault_injection()
+    {
+        host::inject_faults(nullptr);
+    }
+
+    void fault_injection::delay(host::access kind, string const& pattern, chrono::milliseconds delay)
+    {
+        add(kind, pattern, host::fault::none, delay);
+    }
+
+    void fault_injection::fail(host::access kind, string const& pattern, chrono::milliseconds delay)
+    {
+        add(kind, pattern, host::fault::error, delay);
+    }
+
+    void fault_injection::hang(host::access kind, string const& pattern)
+    {
+        add(kind, pattern, host::fault::hang, chrono::milliseconds(0));
+    }
+
+    void fault_injection::release()
+    {
+        host::release_hangs();
+    }
+
+    unsigned int fault_injection::hits(string const& pattern) const
+    {
+        lock_guard<mutex> guard(_lock);
+        unsigned int count = 0;
+        for (auto const& r : _rules) {
+            if (r.pattern == pattern) {
+                count += r.hits;
+            }
+        }
+        return count;
+    }
+
+    void fault_injection::add(host::access kind, string const& pattern, host::fault fault, chrono::milliseconds delay)
+    {
+        lock_guard<mutex> guard(_lock);
+        _rules.push_back(rule { kind, pattern, boost::regex(pattern), fault, delay, 0 });
+    }
+
+    host::fault fault_injection::inject(host::access kind, string const& target)
+    {
+        host::fault fault = host::fault::none;
+        chrono::milliseconds delay(0);
+        {
+            lock_guard<mutex> guard(_lock);
+            for (auto& r : _rules) {
+                if (r.kind != kind || !boost::regex_search(target, r.regex)) {
+                    continue;
+                }
+                ++r.hits;
+                fault = r.fault;
+                delay = r.delay;
+                break;
+            }
+        }
+        // Sleep outside of the lock so other access is not serialized behind the delay
+        if (delay.count() > 0) {
+            this_thread::sleep_for(delay);
+        }
+        return fault;
+    }
+
+}}  // namespace facter::testing
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <internal/util/host.hpp>
+#include <boost/regex.hpp>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facter { namespace testing {
+
+    /**
+     * Utility class for injecting latency and failures into the host access of resolvers.
+     * Rules are matched in the order they were added; the first rule whose pattern matches the target applies.
+     */
+    struct fault_injection
+    {
+        /**
+         * Constructs the fault injection and starts intercepting host access.
+         */
+        fault_injection();
+
+        /**
+         * Destructs the fault injection, stops intercepting host access and releases any hangs.
+         */
+        ~fault_injection();
+
+        /**
+         * Delays matching access before letting it proceed.
+         * @param kind The kind of access to delay.
+         * @param pattern The regular expression matched against the path, hostname or command line.
+         * @param delay The time to delay the access by.
+         */
+        void delay(util::host::access kind, std::string const& pattern, std::chrono::milliseconds delay);
+
+        /**
+         * Fails matching access, optionally after a delay.
+         * @param kind The kind of access to fail.
+         * @param pattern The regular expression matched against the path, hostname or command line.
+         * @param delay The time to delay the access by before failing it.
+         */
+        void fail(util::host::access kind, std::string const& pattern, std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+        /**
+         * Hangs matching access until release is called; commands run with a timeout time out instead.
+         * Reads of files and directories have no deadline, so a hang stalls resolution until it is released.
+         * Release only after the access is blocked (i.e. hits reports it); a release before then does not end the hang.
+         * @param kind The kind of access to hang.
+         * @param pattern The regular expression matched against the path, hostname or command line.
+         */
+        void hang(util::host::access kind, std::string const& pattern);
+
+        /**
+         * Releases the access blocked by hangs; later matching access hangs again.
+         */
+        void release();
+
+        /**
+         * Gets the number of times rules matching the given pattern were applied.
+         * @param pattern The pattern of the rules.
+         * @return Returns the number of access the rules applied to.
+         */
+        unsigned int hits(std::string const& pattern) const;
+
+     private:
+        struct rule
+        {
+            util::host::access kind;
+            std::string pattern;
+            boost::regex regex;
+            util::host::fault fault;
+            std::chrono::milliseconds delay;
+            unsigned int hits;
+        };
+
+        void add(util::host::access kind, std::string const& pattern, util::host::fault fault, std::chrono::milliseconds delay);
+        util::host::fault inject(util::host::access kind, std::string const& target);
+
+        mutable std::mutex _lock;
+        std::vector<rule> _rules;
+    };
+
+}}  // namespace facter::testing
@@ -0,0 +1,16 @@
+calls = Hash.new(0)
+
+Facter.add(:foo, :type => :aggregate) do
+    (1..250).each do |i|
+        name = "chunk#{i}".to_sym
+        chunk name do
+            calls[name] += 1
+            raise "chunk #{name} resolved more than once" if calls[name] > 1
+            {
+                'packages' => { "package#{i}" => { 'version' => "1.0.#{i}", 'sources' => ["repo#{i}"] } },
+                'services' => ["service#{i}"],
+                'common' => { 'sources' => ["chunk#{i}"] }
+            }
+        end
+    end
+end
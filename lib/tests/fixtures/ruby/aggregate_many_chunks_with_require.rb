@@ -0,0 +1,14 @@
+calls = Hash.new(0)
+
+Facter.add(:foo, :type => :aggregate) do
+    (1..250).each do |i|
+        name = "chunk#{i}".to_sym
+        requires = (1...i).select { |j| i % j == 0 }.map { |j| "chunk#{j}".to_sym }
+        chunk name, :require => requires do |*dependencies|
+            calls[name] += 1
+            raise "chunk #{name} resolved more than once" if calls[name] > 1
+            raise "chunk #{name} was given the wrong dependencies" unless dependencies.size == requires.size
+            ["item#{i}"]
+        end
+    end
+end
@@ -0,0 +1,22 @@
+$cache_ttl_foo_evaluations ||= 0
+$cache_ttl_bar_evaluations ||= 0
+
+Facter.add(:foo) do
+    cache_ttl 3600
+    confine do
+        $cache_ttl_foo_evaluations += 1
+        true
+    end
+    setcode do
+        "evaluated #{$cache_ttl_foo_evaluations} times"
+    end
+end
+
+Facter.add(:bar, :cache_ttl => 3600) do
+    setcode do
+        $cache_ttl_bar_evaluations += 1
+        { 'evaluations' => $cache_ttl_bar_evaluations, 'values' => [1, 2.5, true, 'baz'] }
+    end
+end
+
+Facter.flush(:foo, :bar) if ENV['FACTER_TEST_FLUSH_CACHE']
@@ -0,0 +1,365 @@
+/*
+ * Compares the hand-written matchers used on hot paths against the regular expressions they replaced.
+ * Each matcher is run over a small corpus of representative input and checked to agree with its regular expression.
+ */
+#include <internal/facts/linux/dmi_resolver.hpp>
+#include <internal/facts/linux/os_linux.hpp>
+#include <internal/facts/linux/processor_resolver.hpp>
+#include <internal/facts/linux/virtualization_resolver.hpp>
+#include <internal/facts/posix/uptime_resolver.hpp>
+#include <facter/facts/fact.hpp>
+#include <facter/facts/resolver.hpp>
+#include <facter/facts/vm.hpp>
+#include <facter/util/string.hpp>
+#include <leatherman/util/regex.hpp>
+#include <boost/regex.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace facter::facts;
+using namespace leatherman::util;
+
+static vector<string> const key_value_lines = {
+    "NAME=\"Ubuntu\"",
+    "VERSION=\"22.04.3 LTS (Jammy Jellyfish)\"",
+    "ID=ubuntu",
+    "ID_LIKE=debian",
+    "PRETTY_NAME='Ubuntu 22.04.3 LTS'",
+    "VERSION_ID=\"22.04\"",
+    "HOME_URL=\"https://www.ubuntu.com/\"",
+    "# a comment",
+    "",
+    "UBUNTU_CODENAME=jammy",
+};
+
+static vector<string> const uptime_outputs = {
+    " 10:15:03 up 12 days,  3:04,  2 users,  load average: 0.00, 0.01, 0.05",
+    " 10:15:03 up 1 day(s), 2 hrs,  1 user,  load average: 0.10, 0.20, 0.30",
+    " 10:15:03 up 5 days, 10 mins,  3 users,  load average: 1.00, 1.00, 1.00",
+    " 10:15:03 up 4 days,  1 user,  load average: 0.00, 0.00, 0.00",
+    " 10:15:03 up  4:32,  1 user,  load average: 0.00, 0.00, 0.00",
+    " 10:15:03 up 7 hrs,  1 user,  load average: 0.00, 0.00, 0.00",
+    " 10:15:03 up 3 mins,  1 user,  load average: 0.00, 0.00, 0.00",
+    "not uptime output",
+};
+
+static vector<string> const dmidecode_lines = {
+    "# dmidecode 3.3",
+    "Handle 0x0000, DMI type 0, 24 bytes",
+    "BIOS Information",
+    "\tVendor: Phoenix Technologies LTD",
+    "\tVersion: 6.00",
+    "\tRelease Date: 12/12/2018",
+    "Handle 0x0001, DMI type 1, 27 bytes",
+    "System Information",
+    "\tManufacturer: VMware, Inc.",
+    "\tProduct Name: VMware Virtual Platform",
+    "\tSerial Number: VMware-56 4d 1c 2b 3a 4e 5f 60-71 82 93 a4 b5 c6 d7 e8",
+    "Handle 0x0002, DMI type 127, 4 bytes",
+    "End Of Table",
+};
+
+static vector<string> const lspci_lines = {
+    "00:00.0 Host bridge: Intel Corporation 440FX - 82441FX PMC [Natoma] (rev 02)",
+    "00:01.1 IDE interface: Intel Corporation 82371SB PIIX3 IDE [Natoma/Triton II]",
+    "00:0f.0 VGA compatible controller: VMware SVGA II Adapter",
+    "00:02.0 VGA compatible controller: InnoTek Systemberatung GmbH VirtualBox Graphics Adapter",
+    "00:03.0 Ethernet controller: Red Hat, Inc. Virtio network device",
+    "00:04.0 Unassigned class [ff80]: XenSource, Inc. Xen Platform Device (rev 01)",
+    "00:05.0 SCSI storage controller: Red Hat, Inc. VIRTIO SCSI",
+    "00:1f.3 Audio device: Intel Corporation Sunrise Point-LP HD Audio (rev 21)",
+};
+
+static bool regex_parse_key_value(string const& line, string& key, string& value)
+{
+    return re_search(line, boost::regex("(?m)^(\\w+)=[\"']?(.+?)[\"']?$"), &key, &value);
+}
+
+static int64_t regex_parse_uptime(string const& output)
+{
+    static boost::regex days_hours_mins_pattern("(\\d+) day(?:s|\\(s\\))?,?\\s+(\\d+):-?(\\d+)");
+    static boost::regex days_hours_pattern("(\\d+) day(?:s|\\(s\\))?,\\s+(\\d+) hr(?:s|\\(s\\))?,");
+    static boost::regex days_mins_pattern("(\\d+) day(?:s|\\(s\\))?,\\s+(\\d+) min(?:s|\\(s\\))?,");
+    static boost::regex days_pattern("(\\d+) day(?:s|\\(s\\))?,");
+    static boost::regex hours_mins_pattern("up\\s+(\\d+):-?(\\d+),");
+    static boost::regex hours_pattern("(\\d+) hr(?:s|\\(s\\))?,");
+    static boost::regex mins_pattern("(\\d+) min(?:s|\\(s\\))?,");
+
+    int days, hours, minutes;
+
+    if (re_search(output, days_hours_mins_pattern, &days, &hours, &minutes)) {
+        return 86400ll * days + 3600ll * hours + 60ll * minutes;
+    } else if (re_search(output, days_hours_pattern, &days, &hours)) {
+        return 86400ll * days + 3600ll * hours;
+    } else if (re_search(output, days_mins_pattern, &days, &minutes)) {
+        return 86400ll * days + 60ll * minutes;
+    } else if (re_search(output, days_pattern, &days)) {
+        return 86400ll * days;
+    } else if (re_search(output, hours_mins_pattern, &hours, &minutes)) {
+        return 3600ll * hours + 60ll * minutes;
+    } else if (re_search(output, hours_pattern, &hours)) {
+        return 3600ll * hours;
+    } else if (re_search(output, mins_pattern, &minutes)) {
+        return 60ll * minutes;
+    }
+    return -1;
+}
+
+static bool regex_parse_section_header(string const& line, int& dmi_type)
+{
+    static const boost::regex dmi_section_pattern("^Handle 0x.{4}, DMI type (\\d{1,3})");
+    return re_search(line, dmi_section_pattern, &dmi_type);
+}
+
+static string regex_parse_lspci(string const& line)
+{
+    static vector<tuple<boost::regex, string>> vms = {
+        make_tuple(boost::regex("VM[wW]are"),                     string(vm::vmware)),
+        make_tuple(boost::regex("VirtualBox"),                    string(vm::virtualbox)),
+        make_tuple(boost::regex("1ab8:|[Pp]arallels"),            string(vm::parallels)),
+        make_tuple(boost::regex("XenSource"),                     string(vm::xen_hardware)),
+        make_tuple(boost::regex("Microsoft Corporation Hyper-V"), string(vm::hyperv)),
+        make_tuple(boost::regex("Class 8007: Google, Inc"),       string(vm::gce)),
+        make_tuple(boost::regex("virtio", boost::regex::icase),   string(vm::kvm)),
+    };
+
+    for (auto const& vm : vms) {
+        if (re_search(line, get<0>(vm))) {
+            return get<1>(vm);
+        }
+    }
+    return {};
+}
+
+// The name patterns of the resolvers in the tree; each inner list belongs to one resolver
+static vector<vector<string>> const resolver_patterns = {
+    { string("^") + fact::block_device + "_" },
+    { "^ldom_" },
+    { string("^") + fact::processor + "[0-9]+$" },
+    {
+        string("^zone_.+_") + fact::zone_id + "$",
+        string("^zone_.+_") + fact::zone_name + "$",
+        string("^zone_.+_") + fact::zone_status + "$",
+        string("^zone_.+_") + fact::zone_path + "$",
+    },
+};
+
+// Fact names as they are looked up; every name is checked against every resolver with patterns
+static vector<string> const fact_names = {
+    "os",
+    "kernel",
+    "processors",
+    "processorcount",
+    "processor0",
+    "processor31",
+    "blockdevices",
+    "blockdevice_sda_size",
+    "blockdevice_nvme0n1_model",
+    "ldom_domainname",
+    "zone_global_id",
+    "zone_web_name",
+    "zone_web_brand",
+    "ipaddress_eth0",
+    "memorysize_mb",
+};
+
+static vector<string> const quotation_values = {
+    "",
+    "yes",
+    "Off",
+    "TRUE",
+    "y",
+    "1.2",
+    "+1,024",
+    "1.2.3",
+    "12:34",
+    "x86_64",
+    "Ubuntu 22.04.3 LTS",
+    "5.15.0-91-generic",
+    "/dev/sda1",
+    "2.40 GHz",
+};
+
+static vector<string> const cpu_directories = {
+    "cpu0",
+    "cpu7",
+    "cpu127",
+    "cpufreq",
+    "cpuidle",
+    "cpu",
+    "online",
+    "possible",
+    "present",
+    "kernel_max",
+    "hotplug",
+    "smt",
+    "vulnerabilities",
+};
+
+// Stands in for a resolver with name patterns
+struct pattern_resolver : resolver
+{
+    explicit pattern_resolver(vector<string> const& patterns) :
+        resolver("benchmark", {}, patterns)
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+    }
+};
+
+static bool regex_needs_quotation(string const& str)
+{
+    if (str.empty()) {
+        return true;
+    }
+    static boost::regex yaml_bool("y|Y|yes|Yes|YES|n|N|no|No|NO|true|True|TRUE|false|False|FALSE|on|On|ON|off|Off|OFF");
+    if (boost::regex_match(str, yaml_bool)) {
+        return true;
+    }
+    if (str.find(':') != string::npos) {
+        return true;
+    }
+    bool has_dot = false;
+    for (size_t i = 0; i < str.size(); ++i) {
+        char c = str[i];
+        if (i == 0 && (c == '+' || c == '-')) {
+            continue;
+        }
+        if (c == ',') {
+            continue;
+        }
+        if (c == '.') {
+            if (has_dot) {
+                return false;
+            }
+            has_dot = true;
+            continue;
+        }
+        if (!isdigit(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Result>
+static void compare(string const& name, unsigned int iterations, vector<string> const& corpus, function<Result(string const&)> const& matcher, function<Result(string const&)> const& regex)
+{
+    for (auto const& input : corpus) {
+        if (matcher(input) != regex(input)) {
+            throw runtime_error(name + " does not agree with the regular expression for \"" + input + "\".");
+        }
+    }
+
+    auto measure = [&](function<Result(string const&)> const& match) {
+        size_t matched = 0;
+        auto start = chrono::steady_clock::now();
+        for (unsigned int i = 0; i < iterations; ++i) {
+            for (auto const& input : corpus) {
+                matched += match(input) != Result();
+            }
+        }
+        auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        // Use the count so the matches cannot be optimized away
+        return matched ? elapsed / (iterations * corpus.size()) : 0;
+    };
+
+    auto hand_written = measure(matcher);
+    auto regular = measure(regex);
+    cout << name << ": "
+         << hand_written << " ns per line with the matcher, "
+         << regular << " ns per line with boost::regex over " << iterations << " iterations" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int iterations = 10000;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned int>(max(1, atoi(argv[++i])));
+        } else {
+            cerr << "usage: " << argv[0] << " [--iterations <count>]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        compare<string>("parse_key_value", iterations, key_value_lines,
+            [](string const& line) {
+                string key, value;
+                return linux::os_linux::parse_key_value(line, key, value) ? key + "=" + value : string();
+            },
+            [](string const& line) {
+                string key, value;
+                return regex_parse_key_value(line, key, value) ? key + "=" + value : string();
+            });
+        compare<int64_t>("uptime_scanner", iterations, uptime_outputs,
+            [](string const& output) { return posix::uptime_resolver::parse_uptime(output) + 1; },
+            [](string const& output) { return regex_parse_uptime(output) + 1; });
+        compare<int>("parse_section_header", iterations, dmidecode_lines,
+            [](string const& line) {
+                int dmi_type = -1;
+                return linux::dmi_resolver::parse_section_header(line, dmi_type) ? dmi_type + 1 : 0;
+            },
+            [](string const& line) {
+                int dmi_type = -1;
+                return regex_parse_section_header(line, dmi_type) ? dmi_type + 1 : 0;
+            });
+        compare<string>("parse_lspci", iterations, lspci_lines,
+            [](string const& line) { return linux::virtualization_resolver::parse_lspci(line); },
+            [](string const& line) { return regex_parse_lspci(line); });
+
+        // The index of the first resolver matching the name, plus one, or zero if none do
+        vector<unique_ptr<pattern_resolver>> resolvers;
+        vector<vector<boost::regex>> regexes;
+        for (auto const& patterns : resolver_patterns) {
+            resolvers.emplace_back(new pattern_resolver(patterns));
+            regexes.emplace_back(patterns.begin(), patterns.end());
+        }
+        compare<size_t>("resolver::is_match", iterations, fact_names,
+            [&](string const& name) {
+                for (size_t i = 0; i < resolvers.size(); ++i) {
+                    if (resolvers[i]->is_match(name)) {
+                        return i + 1;
+                    }
+                }
+                return size_t();
+            },
+            [&](string const& name) {
+                for (size_t i = 0; i < regexes.size(); ++i) {
+                    for (auto const& regex : regexes[i]) {
+                        if (re_search(name, regex)) {
+                            return i + 1;
+                        }
+                    }
+                }
+                return size_t();
+            });
+        compare<bool>("needs_quotation", iterations, quotation_values,
+            [](string const& value) { return facter::util::needs_quotation(value); },
+            [](string const& value) { return regex_needs_quotation(value); });
+        compare<bool>("is_cpu_directory", iterations, cpu_directories,
+            [](string const& name) { return linux::processor_resolver::is_cpu_directory(name); },
+            [](string const& name) {
+                static const boost::regex cpu_pattern("^cpu\\d+$");
+                return re_search(name, cpu_pattern);
+            });
+    } catch (exception& ex) {
+        cerr << "error: " << ex.what() << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
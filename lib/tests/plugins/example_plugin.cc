@@ -0,0 +1,47 @@
+// An example native fact plugin.
+// Build it as a shared library and place it in a custom fact directory (e.g. --custom-dir) to load it.
+#include <facter/facts/plugin.hpp>
+#include <facter/facts/resolver.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/map_value.hpp>
+
+using namespace std;
+using namespace facter::facts;
+
+namespace {
+
+    // Plugins declare names and patterns exactly like built-in resolvers
+    struct example_resolver : resolver
+    {
+        example_resolver() :
+            resolver(
+                "example plugin",
+                {
+                    "example_plugin",
+                },
+                {
+                    string("^example_plugin_.*$"),
+                })
+        {
+        }
+
+        virtual void resolve(collection& facts) override
+        {
+            auto details = make_value<map_value>();
+            details->add("native", make_value<boolean_value>(true));
+            details->add("api_version", make_value<integer_value>(FACTER_PLUGIN_API_VERSION));
+            facts.add("example_plugin", move(details));
+            facts.add("example_plugin_greeting", make_value<string_value>("hello from a native plugin"));
+        }
+    };
+
+}  // namespace
+
+extern "C" FACTER_PLUGIN_EXPORT int facter_plugin_register(unsigned int version, collection* facts)
+{
+    if (version != FACTER_PLUGIN_API_VERSION || !facts) {
+        return 1;
+    }
+    facts->add(make_shared<example_resolver>());
+    return 0;
+}
@@ -4,10 +4,12 @@
 #include <internal/ruby/ruby_value.hpp>
 #include <leatherman/util/regex.hpp>
 #include <leatherman/util/scoped_env.hpp>
+#include <leatherman/util/scope_exit.hpp>
 #include <leatherman/ruby/api.hpp>
 #include "./ruby_helper.hpp"
 #include "../collection_fixture.hpp"
 #include "../log_capture.hpp"
+#include <boost/filesystem.hpp>
 
 using namespace std;
 using namespace facter::facts;
@@ -434,6 +436,27 @@ SCENARIO("custom facts written in Ruby") {
             REQUIRE(re_search(output, boost::regex("ERROR puppetlabs.facter - .* chunk dependency cycle detected")));
         }
     }
+    GIVEN("an aggregate resolution with many hash chunks") {
+        REQUIRE(load_custom_fact("aggregate_many_chunks.rb", facts));
+        THEN("every chunk is resolved once and merged into the value") {
+            auto value = facts.get<ruby_value>("foo");
+            REQUIRE(value);
+            volatile VALUE packages = ruby.rb_hash_lookup(value->value(), ruby.utf8_value("packages"));
+            volatile VALUE services = ruby.rb_hash_lookup(value->value(), ruby.utf8_value("services"));
+            volatile VALUE common = ruby.rb_hash_lookup(value->value(), ruby.utf8_value("common"));
+            REQUIRE(ruby.num2size_t(ruby.rb_funcall(packages, ruby.rb_intern("size"), 0)) == 250u);
+            REQUIRE(ruby.num2size_t(ruby.rb_funcall(services, ruby.rb_intern("size"), 0)) == 250u);
+            REQUIRE(ruby.array_len(ruby.rb_hash_lookup(common, ruby.utf8_value("sources"))) == 250);
+        }
+    }
+    GIVEN("an aggregate resolution with many chunks requiring other chunks") {
+        REQUIRE(load_custom_fact("aggregate_many_chunks_with_require.rb", facts));
+        THEN("every chunk is resolved once and the arrays are appended") {
+            auto value = facts.get<ruby_value>("foo");
+            REQUIRE(value);
+            REQUIRE(ruby.array_len(value->value()) == 250);
+        }
+    }
     GIVEN("a fact with a defined aggregate resolution") {
         REQUIRE(load_custom_fact("define_aggregate_fact.rb", facts));
         THEN("value should be in the collection") {
@@ -632,3 +655,37 @@ SCENARIO("custom facts written in Ruby") {
         }
     }
 }
+
+SCENARIO("custom facts with a cache TTL") {
+    auto& ruby = api::instance();
+    REQUIRE(ruby.initialized());
+
+    auto cache_directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("facter-cache-%%%%-%%%%-%%%%");
+    scope_exit cleanup([&]() {
+        boost::system::error_code ec;
+        boost::filesystem::remove_all(cache_directory, ec);
+    });
+
+    auto resolve = [&](string const& name) {
+        collection_fixture facts;
+        REQUIRE(load_custom_fact("cache_ttl.rb", facts, cache_directory.string()));
+        return ruby_value_to_string(facts.get<ruby_value>(name));
+    };
+
+    GIVEN("resolutions that declare a cache TTL") {
+        THEN("values are reused until the facts are flushed") {
+            REQUIRE(resolve("foo") == "\"evaluated 1 times\"");
+            REQUIRE(resolve("bar") == "{\n  evaluations => 1,\n  values => [\n    1,\n    2.5,\n    true,\n    \"baz\"\n  ]\n}");
+
+            // The confine and setcode blocks are not evaluated again
+            REQUIRE(resolve("foo") == "\"evaluated 1 times\"");
+            REQUIRE(resolve("bar") == "{\n  evaluations => 1,\n  values => [\n    1,\n    2.5,\n    true,\n    \"baz\"\n  ]\n}");
+
+            {
+                scoped_env flush("FACTER_TEST_FLUSH_CACHE", "1");
+                REQUIRE(resolve("foo") == "\"evaluated 2 times\"");
+            }
+            REQUIRE(resolve("foo") == "\"evaluated 2 times\"");
+        }
+    }
+}
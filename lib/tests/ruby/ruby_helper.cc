@@ -9,11 +9,12 @@ using namespace facter::ruby;
 using namespace facter::facts;
 using namespace leatherman::ruby;
 
-bool load_custom_fact(string const& filename, collection& facts)
+bool load_custom_fact(string const& filename, collection& facts, string const& cache_directory)
 {
     auto& ruby = api::instance();
 
     module mod(facts);
+    mod.cache().directory(cache_directory);
 
     string file = LIBFACTER_TESTS_DIRECTORY "/fixtures/ruby/" + filename;
     VALUE result = ruby.rescue([&]() {
@@ -3,6 +3,6 @@
 #include <facter/facts/value.hpp>
 #include <string>
 
-bool load_custom_fact(std::string const& filename, facter::facts::collection& facts);
+bool load_custom_fact(std::string const& filename, facter::facts::collection& facts, std::string const& cache_directory = {});
 
 std::string ruby_value_to_string(facter::facts::value const* value);
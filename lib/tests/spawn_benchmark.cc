@@ -0,0 +1,88 @@
+/*
+ * Compares spawning commands with fork and exec against the posix_spawn based execution facade
+ * from a process with a large, fully touched heap.
+ */
+#include <internal/execution/execution.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+static double measure(unsigned int iterations, function<bool()> const& spawn)
+{
+    auto start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; ++i) {
+        if (!spawn()) {
+            throw runtime_error("failed to run the command.");
+        }
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static bool fork_and_exec(string const& executable)
+{
+    pid_t child = fork();
+    if (child < 0) {
+        return false;
+    }
+    if (child == 0) {
+        execl(executable.c_str(), executable.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    int status = 0;
+    while (waitpid(child, &status, 0) < 0) {
+        // Only an interrupted wait is retried; any other error means there is no child to wait for
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int iterations = 100;
+    size_t heap_size = 1024;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned int>(max(1, atoi(argv[++i])));
+        } else if (argument == "--heap" && i + 1 < argc) {
+            heap_size = static_cast<size_t>(max(0, atoi(argv[++i])));
+        } else {
+            cerr << "usage: " << argv[0] << " [--iterations <count>] [--heap <megabytes>]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Touch every page so a fork has to copy the page tables of the whole heap
+    vector<char> heap(heap_size * 1024 * 1024);
+    for (size_t i = 0; i < heap.size(); i += 4096) {
+        heap[i] = 1;
+    }
+
+    try {
+        auto executable = facter::execution::which("true");
+        if (executable.empty()) {
+            throw runtime_error("true was not found on the PATH.");
+        }
+        auto forked = measure(iterations, [&]() { return fork_and_exec(executable); });
+        auto spawned = measure(iterations, [&]() { return facter::execution::execute(executable).success; });
+        cout << "heap of " << heap_size << " MB: "
+             << forked << " ms per fork and exec, "
+             << spawned << " ms per spawn over " << iterations << " iterations" << endl;
+    } catch (exception& ex) {
+        cerr << "error: " << ex.what() << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,10 +1,39 @@
 #include <catch.hpp>
 #include <internal/util/bsd/scoped_ifaddrs.hpp>
+#include <internal/util/host.hpp>
+#include <leatherman/util/scope_exit.hpp>
+#include <netinet/in.h>
+#include <string>
+#include <vector>
+#include "../../fixtures.hpp"
 
 using namespace std;
+using namespace facter::util;
 using namespace facter::util::bsd;
+using leatherman::util::scope_exit;
 
 SCENARIO("constructing a scoped_ifaddrs") {
     scoped_ifaddrs addrs;
     REQUIRE(static_cast<ifaddrs*>(addrs));
 }
+
+#ifdef __linux__
+SCENARIO("replaying a scoped_ifaddrs from a host snapshot") {
+    replay_snapshot(LIBFACTER_TESTS_DIRECTORY "/fixtures/snapshots/linux.yaml");
+    scope_exit finish([]() { finish_snapshot(); });
+
+    scoped_ifaddrs addrs;
+    vector<string> names;
+    sockaddr_in const* eth0 = nullptr;
+    for (ifaddrs* ptr = addrs; ptr; ptr = ptr->ifa_next) {
+        names.push_back(ptr->ifa_name);
+        if (names.back() == "eth0" && ptr->ifa_addr && ptr->ifa_addr->sa_family == AF_INET) {
+            eth0 = reinterpret_cast<sockaddr_in const*>(ptr->ifa_addr);
+            REQUIRE(ptr->ifa_netmask);
+        }
+    }
+    REQUIRE(names == vector<string>({ "lo", "eth0", "lo", "eth0" }));
+    REQUIRE(eth0);
+    REQUIRE(ntohl(eth0->sin_addr.s_addr) == 0x0a00020fu);
+}
+#endif
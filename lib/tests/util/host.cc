@@ -0,0 +1,252 @@
+#include <catch.hpp>
+#include <internal/util/host.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/util/scope_exit.hpp>
+#include "../fault_injection.hpp"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace facter::util;
+using leatherman::util::scope_exit;
+namespace fs = boost::filesystem;
+namespace lth_file = leatherman::file_util;
+
+SCENARIO("recording and replaying a host snapshot") {
+    auto directory = fs::temp_directory_path() / fs::unique_path("facter-host-%%%%-%%%%-%%%%");
+    auto snapshot = (fs::temp_directory_path() / fs::unique_path("facter-snapshot-%%%%-%%%%-%%%%.yaml")).string();
+    auto root = directory.string();
+    auto file = (directory / "file").string();
+    auto missing = (directory / "missing").string();
+    fs::create_directories(directory / "subdirectory");
+    lth_file::atomic_write_to_file("one\ntwo\n", file);
+
+    auto lines = [](string const& path) {
+        vector<string> result;
+        host::each_line(path, [&](string& line) {
+            result.push_back(line);
+            return true;
+        });
+        return result;
+    };
+    auto files = [](string const& path, string const& pattern) {
+        vector<string> result;
+        host::each_file(path, [&](string const& file) {
+            result.push_back(fs::path(file).filename().string());
+            return true;
+        }, pattern);
+        return result;
+    };
+    auto subdirectories = [](string const& path) {
+        vector<string> result;
+        host::each_subdirectory(path, [&](string const& subdirectory) {
+            result.push_back(fs::path(subdirectory).filename().string());
+            return true;
+        });
+        return result;
+    };
+
+    GIVEN("a snapshot recorded from the host") {
+        record_snapshot(snapshot);
+        REQUIRE(host::snapshot_active());
+        REQUIRE(host::read(file) == "one\ntwo\n");
+        REQUIRE(lines(file) == vector<string>({ "one", "two" }));
+        REQUIRE(files(root, {}) == vector<string>({ "file" }));
+        REQUIRE(subdirectories(root) == vector<string>({ "subdirectory" }));
+        REQUIRE_FALSE(host::exists(missing));
+        host::record_call("uname", { { { "sysname", "Linux" }, { "release", "5.10.0-8-amd64" } } });
+        finish_snapshot();
+        REQUIRE_FALSE(host::snapshot_active());
+
+        // Change the host after recording
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+        lth_file::atomic_write_to_file("changed", missing);
+
+        WHEN("the snapshot is replayed") {
+            replay_snapshot(snapshot);
+            scope_exit finish([]() { finish_snapshot(); });
+            THEN("the recorded files are read") {
+                string contents;
+                REQUIRE(host::read(file, contents));
+                REQUIRE(contents == "one\ntwo\n");
+                REQUIRE(lines(file) == vector<string>({ "one", "two" }));
+                REQUIRE(host::is_regular_file(file));
+            }
+            THEN("the recorded directories are listed") {
+                REQUIRE(host::is_directory(root));
+                REQUIRE(files(root, {}) == vector<string>({ "file" }));
+                REQUIRE(files(root, "^nothing$").empty());
+                REQUIRE(subdirectories(root) == vector<string>({ "subdirectory" }));
+            }
+            THEN("paths that were missing or never recorded do not exist") {
+                string contents;
+                REQUIRE_FALSE(host::exists(missing));
+                REQUIRE_FALSE(host::read(missing, contents));
+                REQUIRE_FALSE(host::exists((directory / "subdirectory").string()));
+                REQUIRE_FALSE(host::each_line("/etc/hosts", [](string&) { return true; }));
+            }
+            THEN("the recorded system calls are replayed") {
+                REQUIRE(host::snapshot_replaying());
+                vector<host::call_record> records;
+                REQUIRE(host::replay_call("uname", records));
+                REQUIRE(records.size() == 1u);
+                REQUIRE(records[0]["sysname"] == "Linux");
+                REQUIRE(records[0]["release"] == "5.10.0-8-amd64");
+                REQUIRE(host::replay_call("getifaddrs", records));
+                REQUIRE(records.empty());
+            }
+        }
+        WHEN("the snapshot is finished") {
+            THEN("the live host is read again") {
+                REQUIRE(host::read(missing) == "changed");
+                REQUIRE_FALSE(host::exists(file));
+                vector<host::call_record> records;
+                REQUIRE_FALSE(host::replay_call("uname", records));
+            }
+        }
+    }
+    GIVEN("a snapshot that cannot be loaded") {
+        lth_file::atomic_write_to_file("paths: [", snapshot);
+        THEN("an exception is thrown") {
+            REQUIRE_THROWS_AS(replay_snapshot(snapshot), snapshot_exception);
+            REQUIRE_FALSE(host::snapshot_active());
+        }
+    }
+
+    fs::remove_all(directory);
+    fs::remove(snapshot);
+}
+
+SCENARIO("counting access to the host") {
+    auto directory = fs::temp_directory_path() / fs::unique_path("facter-host-%%%%-%%%%-%%%%");
+    auto root = directory.string();
+    auto file = (directory / "file").string();
+    fs::create_directories(directory / "subdirectory");
+    lth_file::atomic_write_to_file("one\ntwo\n", file);
+
+    GIVEN("a scope counting access") {
+        host::io_scope io;
+        string contents;
+        REQUIRE(host::read(file, contents));
+        REQUIRE_FALSE(host::read((directory / "missing").string(), contents));
+        host::each_line(file, [](string&) { return true; });
+        REQUIRE(host::exists(file));
+        REQUIRE(host::is_directory(root));
+        REQUIRE_FALSE(host::is_regular_file(root));
+        host::each_file(root, [](string const&) { return true; });
+        host::each_subdirectory(root, [](string const&) { return true; });
+        THEN("each kind of access is counted") {
+            auto counters = io.counters();
+            REQUIRE(counters.opens == 3u);
+            REQUIRE(counters.bytes_read == 16u);
+            REQUIRE(counters.stats == 3u);
+            REQUIRE(counters.scans == 2u);
+            REQUIRE(counters.entries == 2u);
+        }
+        WHEN("a nested scope is created") {
+            {
+                host::io_scope nested;
+                host::read(file);
+                REQUIRE(nested.counters().opens == 1u);
+            }
+            host::read(file);
+            THEN("access is only counted against the innermost scope") {
+                REQUIRE(io.counters().opens == 4u);
+            }
+        }
+        WHEN("another thread accesses the host") {
+            uint64_t opens = 0;
+            thread other([&]() {
+                host::io_scope theirs;
+                host::read(file);
+                opens = theirs.counters().opens;
+            });
+            other.join();
+            THEN("access is only counted against the scope of that thread") {
+                REQUIRE(opens == 1u);
+                REQUIRE(io.counters().opens == 3u);
+            }
+        }
+    }
+    GIVEN("no scope") {
+        THEN("access is not counted") {
+            host::read(file);
+            host::io_scope io;
+            REQUIRE(io.counters().opens == 0u);
+        }
+    }
+
+    fs::remove_all(directory);
+}
+
+SCENARIO("injecting faults into access to the host") {
+    auto directory = fs::temp_directory_path() / fs::unique_path("facter-host-%%%%-%%%%-%%%%");
+    auto root = directory.string();
+    auto file = (directory / "file").string();
+    fs::create_directories(directory / "subdirectory");
+    lth_file::atomic_write_to_file("contents", file);
+    facter::testing::fault_injection faults;
+
+    GIVEN("a delay") {
+        auto delay = chrono::milliseconds(100);
+        faults.delay(host::access::file, "/file$", delay);
+        auto start = chrono::steady_clock::now();
+        auto contents = host::read(file);
+        auto elapsed = chrono::steady_clock::now() - start;
+        THEN("the access succeeds after the delay") {
+            REQUIRE(contents == "contents");
+            REQUIRE(elapsed >= delay);
+            REQUIRE(faults.hits("/file$") == 1u);
+        }
+    }
+    GIVEN("an error") {
+        faults.fail(host::access::file, "/file$");
+        faults.fail(host::access::stat, "/file$");
+        faults.fail(host::access::directory, "/subdirectory$");
+        THEN("matching access fails as if the target was missing") {
+            string contents;
+            REQUIRE_FALSE(host::read(file, contents));
+            REQUIRE_FALSE(host::exists(file));
+            REQUIRE_FALSE(host::is_regular_file(file));
+            REQUIRE(host::is_directory(root));
+            bool visited = false;
+            host::each_file((directory / "subdirectory").string(), [&](string const&) { visited = true; return true; });
+            REQUIRE_FALSE(visited);
+            REQUIRE(faults.hits("/file$") == 3u);
+        }
+    }
+    GIVEN("a hang") {
+        auto stall = chrono::milliseconds(100);
+        faults.hang(host::access::file, "/file$");
+        thread releaser([&]() {
+            // Only release once the read is blocked; a release before the hang is reached would not end it
+            while (faults.hits("/file$") == 0) {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+            this_thread::sleep_for(stall);
+            faults.release();
+        });
+        auto start = chrono::steady_clock::now();
+        string contents;
+        bool result = host::read(file, contents);
+        auto elapsed = chrono::steady_clock::now() - start;
+        releaser.join();
+        THEN("the access blocks until released and then fails") {
+            REQUIRE_FALSE(result);
+            REQUIRE(elapsed >= stall);
+            REQUIRE(elapsed < chrono::seconds(2));
+        }
+    }
+    GIVEN("no matching rule") {
+        faults.fail(host::access::file, "/missing$");
+        THEN("access proceeds normally") {
+            REQUIRE(host::read(file) == "contents");
+            REQUIRE(faults.hits("/missing$") == 0u);
+        }
+    }
+
+    fs::remove_all(directory);
+}
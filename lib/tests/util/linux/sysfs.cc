@@ -0,0 +1,47 @@
+#include <catch.hpp>
+#include <internal/util/linux/sysfs.hpp>
+#include "../../fixtures.hpp"
+
+using namespace std;
+using namespace facter::util::linux;
+
+SCENARIO("reading sysfs attributes") {
+    string value = "previous";
+    GIVEN("an attribute that exists") {
+        THEN("it should be read without the trailing newline") {
+            REQUIRE(read_attribute(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/sysfs/cpu/online", value));
+            REQUIRE(value == "0-3");
+        }
+    }
+    GIVEN("an attribute that does not exist") {
+        THEN("it should not be read") {
+            REQUIRE_FALSE(read_attribute(LIBFACTER_TESTS_DIRECTORY "/fixtures/facts/linux/sysfs/cpu/offline", value));
+            REQUIRE(value == "previous");
+        }
+    }
+}
+
+SCENARIO("parsing sysfs CPU lists") {
+    GIVEN("single CPUs and ranges") {
+        THEN("every CPU should be returned") {
+            REQUIRE(parse_cpu_list("0") == (vector<unsigned int>{ 0 }));
+            REQUIRE(parse_cpu_list("0-3") == (vector<unsigned int>{ 0, 1, 2, 3 }));
+            REQUIRE(parse_cpu_list("0,2,4-5") == (vector<unsigned int>{ 0, 2, 4, 5 }));
+            REQUIRE(parse_cpu_list("8-9,0-1") == (vector<unsigned int>{ 8, 9, 0, 1 }));
+        }
+    }
+    GIVEN("an empty list") {
+        THEN("no CPUs should be returned") {
+            REQUIRE(parse_cpu_list("").empty());
+        }
+    }
+    GIVEN("a malformed list") {
+        THEN("no CPUs should be returned") {
+            REQUIRE(parse_cpu_list("a").empty());
+            REQUIRE(parse_cpu_list("3-1").empty());
+            REQUIRE(parse_cpu_list("0-").empty());
+            REQUIRE(parse_cpu_list("0;1").empty());
+            REQUIRE(parse_cpu_list("0-99999999999").empty());
+        }
+    }
+}
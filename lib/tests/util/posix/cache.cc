@@ -0,0 +1,41 @@
+#include <catch.hpp>
+#include <internal/util/cache.hpp>
+#include <leatherman/util/environment.hpp>
+#include <leatherman/util/scope_exit.hpp>
+#include <unistd.h>
+
+using namespace std;
+using namespace facter::util;
+using namespace leatherman::util;
+
+SCENARIO("getting the directory of a Facter cache") {
+    string home;
+    bool has_home = environment::get("HOME", home);
+    scope_exit restore([&]() {
+        if (has_home) {
+            environment::set("HOME", home);
+        } else {
+            environment::clear("HOME");
+        }
+    });
+
+    GIVEN("a home directory") {
+        environment::set("HOME", "/home/facter");
+        THEN("root should use the system cache and other users their home directory") {
+            if (getuid()) {
+                REQUIRE(cache_directory("identity") == "/home/facter/.puppetlabs/opt/facter/cache/identity");
+            } else {
+                REQUIRE(cache_directory("identity") == "/opt/puppetlabs/facter/cache/identity");
+            }
+        }
+        THEN("each kind of data should have its own directory") {
+            REQUIRE(cache_directory("identity") != cache_directory("custom_facts"));
+        }
+    }
+    GIVEN("no home directory") {
+        environment::clear("HOME");
+        THEN("only root should have a cache") {
+            REQUIRE(cache_directory("custom_facts").empty() == (getuid() != 0));
+        }
+    }
+}
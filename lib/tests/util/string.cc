@@ -274,3 +274,77 @@ SCENARIO("converting frequencies to strings") {
         }
     }
 }
+
+SCENARIO("determining if a string needs quotation") {
+    GIVEN("a YAML boolean") {
+        THEN("it should need quotation") {
+            for (auto const& str : { "y", "Y", "yes", "Yes", "YES", "n", "N", "no", "No", "NO", "true", "True", "TRUE",
+                                     "false", "False", "FALSE", "on", "On", "ON", "off", "Off", "OFF" }) {
+                CAPTURE(str);
+                REQUIRE(needs_quotation(str));
+            }
+        }
+    }
+    GIVEN("a string that only resembles a YAML boolean") {
+        THEN("it should not need quotation") {
+            for (auto const& str : { "yES", "tRUE", "of", "offf", "yess", "nO", " no", "true ", "On\n", "trueish" }) {
+                CAPTURE(str);
+                REQUIRE_FALSE(needs_quotation(str));
+            }
+        }
+    }
+    GIVEN("an empty string") {
+        THEN("it should need quotation") {
+            REQUIRE(needs_quotation(""));
+        }
+    }
+    GIVEN("a string containing a colon") {
+        THEN("it should need quotation") {
+            REQUIRE(needs_quotation("foo:bar"));
+        }
+    }
+    GIVEN("a numerical string") {
+        THEN("it should need quotation") {
+            REQUIRE(needs_quotation("-1.5"));
+            REQUIRE(needs_quotation("1,2,3"));
+        }
+    }
+    GIVEN("a string that is not numerical") {
+        THEN("it should not need quotation") {
+            REQUIRE_FALSE(needs_quotation("1.2.3"));
+            REQUIRE_FALSE(needs_quotation("foo"));
+        }
+    }
+}
+
+SCENARIO("matching strings against wildcard patterns") {
+    GIVEN("a pattern without wildcards") {
+        THEN("only the same string should match") {
+            REQUIRE(wildcard_match("eth0", "eth0"));
+            REQUIRE_FALSE(wildcard_match("eth01", "eth0"));
+            REQUIRE_FALSE(wildcard_match("eth", "eth0"));
+            REQUIRE(wildcard_match("", ""));
+        }
+    }
+    GIVEN("a pattern with '*'") {
+        THEN("it should match any sequence of characters") {
+            REQUIRE(wildcard_match("veth1a2b3c", "veth*"));
+            REQUIRE(wildcard_match("veth", "veth*"));
+            REQUIRE(wildcard_match("cali123", "*"));
+            REQUIRE(wildcard_match("", "*"));
+            REQUIRE(wildcard_match("tap0-br", "*-br"));
+            REQUIRE(wildcard_match("a-b-c", "a*b*c"));
+            REQUIRE(wildcard_match("/var/lib/docker/overlay2/abc/merged", "/var/lib/docker/*"));
+            REQUIRE_FALSE(wildcard_match("eth0", "veth*"));
+            REQUIRE_FALSE(wildcard_match("a-b-d", "a*b*c"));
+        }
+    }
+    GIVEN("a pattern with '?'") {
+        THEN("it should match exactly one character") {
+            REQUIRE(wildcard_match("eth0", "eth?"));
+            REQUIRE_FALSE(wildcard_match("eth", "eth?"));
+            REQUIRE_FALSE(wildcard_match("eth10", "eth?"));
+            REQUIRE(wildcard_match("eth10", "eth?*"));
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#include <catch.hpp>
+#include <internal/util/timeline.hpp>
+#include <facter/facts/resolver.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include "../collection_fixture.hpp"
+#include <boost/filesystem.hpp>
+#include <yaml-cpp/yaml.h>
+#include <map>
+#include <thread>
+
+using namespace std;
+using namespace facter::util;
+using namespace facter::facts;
+using namespace facter::testing;
+namespace fs = boost::filesystem;
+
+struct timeline_resolver : resolver
+{
+    timeline_resolver() : resolver("timeline", { "timed" })
+    {
+    }
+
+    virtual void resolve(collection& facts) override
+    {
+        facts.add("timed", make_value<string_value>("value"));
+    }
+};
+
+// Events that cover the recorded time of a span, keyed by name
+struct timeline_event
+{
+    string category;
+    double start;
+    double end;
+    unsigned int thread;
+    string detail;
+};
+
+static map<string, timeline_event> load_timeline(string const& path, map<unsigned int, string>& threads)
+{
+    // The trace event JSON is a subset of YAML
+    auto document = YAML::LoadFile(path);
+    REQUIRE(document["displayTimeUnit"].as<string>() == "ms");
+    map<string, timeline_event> events;
+    for (auto const& node : document["traceEvents"]) {
+        auto phase = node["ph"].as<string>();
+        REQUIRE(node["pid"].as<unsigned int>() == 1);
+        if (phase == "M") {
+            REQUIRE(node["name"].as<string>() == "thread_name");
+            threads[node["tid"].as<unsigned int>()] = node["args"]["name"].as<string>();
+            continue;
+        }
+        REQUIRE(phase == "X");
+        timeline_event event;
+        event.category = node["cat"].as<string>();
+        event.start = node["ts"].as<double>();
+        event.end = event.start + node["dur"].as<double>();
+        event.thread = node["tid"].as<unsigned int>();
+        if (node["args"]) {
+            event.detail = node["args"]["detail"].as<string>();
+        }
+        events[node["name"].as<string>()] = event;
+    }
+    return events;
+}
+
+SCENARIO("recording a timeline") {
+    auto path = (fs::temp_directory_path() / fs::unique_path("facter-timeline-%%%%-%%%%-%%%%.json")).string();
+    map<unsigned int, string> threads;
+
+    GIVEN("a timeline is not being recorded") {
+        THEN("spans are not recorded and finishing does nothing") {
+            REQUIRE_FALSE(timeline::enabled());
+            {
+                timeline::span span("test", "ignored");
+            }
+            REQUIRE(finish_timeline());
+            REQUIRE_FALSE(fs::exists(path));
+        }
+    }
+    GIVEN("nested spans on multiple threads") {
+        start_timeline(path);
+        REQUIRE(timeline::enabled());
+        {
+            timeline::span outer("test", "outer", "with \"quoted\" detail");
+            {
+                timeline::span inner("test", "inner");
+            }
+            thread worker([]() {
+                timeline::span span("test", "worker");
+            });
+            worker.join();
+        }
+        REQUIRE(finish_timeline());
+        REQUIRE_FALSE(timeline::enabled());
+        {
+            timeline::span span("test", "finished");
+        }
+        auto events = load_timeline(path, threads);
+        THEN("each span is written with its thread") {
+            REQUIRE(events.size() == 3u);
+            REQUIRE(events.count("finished") == 0);
+            REQUIRE(events["outer"].category == "test");
+            REQUIRE(events["outer"].detail == "with \"quoted\" detail");
+            REQUIRE(events["inner"].detail.empty());
+            REQUIRE(events["outer"].thread == events["inner"].thread);
+            REQUIRE(events["outer"].thread != events["worker"].thread);
+            REQUIRE(threads.size() == 2u);
+            REQUIRE(threads[events["outer"].thread] == "main");
+        }
+        THEN("nested spans are contained by their parent") {
+            REQUIRE(events["outer"].start <= events["inner"].start);
+            REQUIRE(events["inner"].end <= events["outer"].end);
+            REQUIRE(events["outer"].start <= events["worker"].start);
+            REQUIRE(events["worker"].end <= events["outer"].end);
+        }
+    }
+    GIVEN("a fact collection") {
+        collection_fixture facts;
+        facts.add(make_shared<timeline_resolver>());
+        start_timeline(path);
+        REQUIRE(facts.get<string_value>("timed"));
+        REQUIRE(finish_timeline());
+        auto events = load_timeline(path, threads);
+        THEN("the fact lookup contains the resolution of its resolver") {
+            REQUIRE(events.count("timed") == 1);
+            REQUIRE(events.count("timeline") == 1);
+            REQUIRE(events["timed"].category == "fact");
+            REQUIRE(events["timeline"].category == "resolver");
+            REQUIRE(events["timed"].start <= events["timeline"].start);
+            REQUIRE(events["timeline"].end <= events["timed"].end);
+        }
+    }
+    GIVEN("a timeline that cannot be written") {
+        start_timeline((fs::path(path) / "missing" / "timeline.json").string());
+        THEN("finishing fails") {
+            REQUIRE_FALSE(finish_timeline());
+            REQUIRE_FALSE(timeline::enabled());
+        }
+    }
+
+    fs::remove(path);
+}
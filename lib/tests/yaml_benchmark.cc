@@ -0,0 +1,135 @@
+/*
+ * Compares writing a tree of fact values as YAML with the buffered yaml_writer against yaml-cpp's Emitter.
+ * The tree is shaped like the facts of a host with many interfaces, mountpoints and partitions.
+ */
+#include <facter/facts/array_value.hpp>
+#include <facter/facts/map_value.hpp>
+#include <facter/facts/scalar_value.hpp>
+#include <facter/facts/yaml_writer.hpp>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace facter::facts;
+
+static unique_ptr<map_value> make_facts(unsigned int count)
+{
+    auto facts = make_value<map_value>();
+    auto interfaces = make_value<map_value>();
+    auto mountpoints = make_value<map_value>();
+    auto partitions = make_value<map_value>();
+    for (unsigned int i = 0; i < count; ++i) {
+        auto index = to_string(i);
+
+        auto interface = make_value<map_value>();
+        interface->add("ip", make_value<string_value>("10.0." + to_string(i / 256) + "." + to_string(i % 256)));
+        interface->add("mac", make_value<string_value>("52:54:00:12:34:" + to_string(10 + i % 90)));
+        interface->add("mtu", make_value<integer_value>(1500));
+        interface->add("dhcp", make_value<boolean_value>(i % 2 == 0));
+        auto bindings = make_value<array_value>();
+        auto binding = make_value<map_value>();
+        binding->add("address", make_value<string_value>("fe80::5054:ff:fe12:" + index));
+        binding->add("netmask", make_value<string_value>("ffff:ffff:ffff:ffff::"));
+        bindings->add(move(binding));
+        interface->add("bindings6", move(bindings));
+        interfaces->add("eth" + index, move(interface));
+
+        auto mountpoint = make_value<map_value>();
+        mountpoint->add("device", make_value<string_value>("/dev/sda" + index));
+        mountpoint->add("filesystem", make_value<string_value>("ext4"));
+        mountpoint->add("capacity", make_value<string_value>("41.53%"));
+        mountpoint->add("used_bytes", make_value<integer_value>(4459892736ll + i));
+        mountpoint->add("load", make_value<double_value>(0.05 * i));
+        auto options = make_value<array_value>();
+        for (auto option : { "rw", "relatime", "errors=remount-ro" }) {
+            options->add(make_value<string_value>(option));
+        }
+        mountpoint->add("options", move(options));
+        mountpoints->add("/srv/data" + index, move(mountpoint));
+
+        auto partition = make_value<map_value>();
+        partition->add("uuid", make_value<string_value>("4b0cbd5c-7c44-4e56-a8e4-" + index));
+        partition->add("label", make_value<string_value>("data: " + index));
+        partition->add("size", make_value<string_value>("20.00 GiB"));
+        partitions->add("/dev/sda" + index, move(partition));
+    }
+    facts->add("interfaces", move(interfaces));
+    facts->add("mountpoints", move(mountpoints));
+    facts->add("partitions", move(partitions));
+    facts->add("kernel", make_value<string_value>("Linux"));
+    facts->add("is_virtual", make_value<boolean_value>(true));
+    return facts;
+}
+
+static double measure(unsigned int iterations, function<void()> const& write)
+{
+    vector<double> times;
+    for (unsigned int i = 0; i < iterations; ++i) {
+        auto start = chrono::steady_clock::now();
+        write();
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int iterations = 20;
+    unsigned int count = 1000;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned int>(max(1, atoi(argv[++i])));
+        } else if (argument == "--count" && i + 1 < argc) {
+            count = static_cast<unsigned int>(max(1, atoi(argv[++i])));
+        } else {
+            cerr << "usage: " << argv[0] << " [--iterations <count>] [--count <interfaces>]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        auto facts = make_facts(count);
+
+        auto emit = [&](ostream& stream) {
+            YAML::Emitter emitter(stream);
+            facts->write(emitter);
+        };
+        auto write = [&](ostream& stream) {
+            yaml_writer writer(stream);
+            facts->write(writer);
+        };
+
+        ostringstream emitted;
+        ostringstream written;
+        emit(emitted);
+        write(written);
+        if (emitted.str() != written.str()) {
+            throw runtime_error("the YAML writer does not agree with the emitter.");
+        }
+
+        auto emitter_time = measure(iterations, [&]() {
+            ostringstream stream;
+            emit(stream);
+        });
+        auto writer_time = measure(iterations, [&]() {
+            ostringstream stream;
+            write(stream);
+        });
+        cout << written.str().size() << " bytes of YAML: "
+             << writer_time << " ms median with yaml_writer, "
+             << emitter_time << " ms median with YAML::Emitter over " << iterations << " iterations" << endl;
+    } catch (exception& ex) {
+        cerr << "error: " << ex.what() << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}